@@ -22,24 +22,24 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifndef CENTIPEDE_MUSHROOMFIELD_H
-#define CENTIPEDE_MUSHROOMFIELD_H
-
-#include "Source/Grid/Grid.h"
+#include "Source/Actors/Actor.h"
 
 namespace centpd {
-    /**
-      * @brief Creates a random Mushroom field
-      */
-    class MushroomField {
-    public:
-        /**
-         * @brief Create a random Mushroom field
-         * @param grid The grid to create the field in
-         * @param numMushrooms The number of mushrooms to generate
-         */
-        static void create(Grid& grid, unsigned int numMushrooms);
-    };
-}
+    ///////////////////////////////////////////////////////////////
+    Actor::Actor(ime::Scene &scene) :
+        GameObject(scene)
+    {}
 
-#endif //CENTIPEDE_MUSHROOMFIELD_H
+    ///////////////////////////////////////////////////////////////
+    void Actor::deactivate() {
+        if (isActive()) {
+            setActive(false);
+            notify<ActorEvent::Deactivated>();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Actor::~Actor() {
+        notify<ActorEvent::Destroyed>();
+    }
+}
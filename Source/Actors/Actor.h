@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_ACTOR_H
+#define CENTIPEDE_ACTOR_H
+
+#include "Source/Common/Signal.h"
+#include <IME/core/game_object/GameObject.h>
+#include <cstddef>
+#include <tuple>
+
+namespace centpd {
+    /**
+     * @brief Gameplay events emitted by an Actor
+     */
+    enum class ActorEvent {
+        Deactivated, //!< The actor was deactivated and will be destroyed at the end of the frame
+        TypeChanged, //!< The type of the actor changed, e.g. a centipede body became a head
+        Moved,       //!< The actor moved, the new position is passed to the callback
+        Destroyed    //!< The actor is being destroyed
+    };
+
+    /**
+     * @brief The signal type of each ActorEvent
+     */
+    template <ActorEvent Event>
+    struct ActorEventTraits {
+        using Signal = centpd::Signal<>;
+    };
+
+    template <>
+    struct ActorEventTraits<ActorEvent::Moved> {
+        using Signal = centpd::Signal<const ime::Vector2f&>;
+    };
+
+    /**
+     * @brief Base class for all game characters
+     *
+     * Actors notify interested parties through typed signals instead of
+     * string keyed property listeners. The event is selected at compile
+     * time, so emitting an event is a direct index into the actors
+     * signals and never allocates
+     */
+    class Actor : public ime::GameObject {
+    public:
+        /**
+         * @brief Constructor
+         * @param scene The scene the actor belongs to
+         */
+        explicit Actor(ime::Scene& scene);
+
+        /**
+         * @brief Add an event listener
+         * @tparam Event The event to listen for
+         * @param callback The function to be executed when the event is emitted
+         * @return The handle of the event listener
+         *
+         * The callback must fit into the inline storage of a Signal, which
+         * is enough for a lambda that captures a few pointers
+         */
+        template <ActorEvent Event, typename Callback>
+        SlotHandle on(Callback&& callback) {
+            return signal<Event>().connect(std::forward<Callback>(callback));
+        }
+
+        /**
+         * @brief Remove an event listener
+         * @tparam Event The event the listener was added to
+         * @param handle The handle of the event listener
+         * @return True if the listener was removed or false if it does not exist
+         */
+        template <ActorEvent Event>
+        bool disconnect(SlotHandle handle) {
+            return signal<Event>().disconnect(handle);
+        }
+
+        /**
+         * @brief Emit an event
+         * @tparam Event The event to emit
+         * @param args The arguments to pass to the event listeners
+         */
+        template <ActorEvent Event, typename... Args>
+        void notify(Args&&... args) {
+            signal<Event>().emit(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Deactivate the actor
+         *
+         * An inactive actor is destroyed at the end of the current frame.
+         * This function emits ActorEvent::Deactivated if the actor was active
+         */
+        void deactivate();
+
+        /**
+         * @brief Destructor
+         *
+         * Emits ActorEvent::Destroyed
+         */
+        ~Actor() override;
+
+    private:
+        /**
+         * @brief Get the signal of an event
+         * @tparam Event The event to get the signal of
+         * @return The signal of the event
+         */
+        template <ActorEvent Event>
+        typename ActorEventTraits<Event>::Signal& signal() {
+            return std::get<static_cast<std::size_t>(Event)>(m_signals);
+        }
+
+    private:
+        // Must be in the same order as ActorEvent
+        std::tuple<ActorEventTraits<ActorEvent::Deactivated>::Signal,
+                   ActorEventTraits<ActorEvent::TypeChanged>::Signal,
+                   ActorEventTraits<ActorEvent::Moved>::Signal,
+                   ActorEventTraits<ActorEvent::Destroyed>::Signal> m_signals; //!< One signal per event
+    };
+}
+
+#endif //CENTIPEDE_ACTOR_H
@@ -24,39 +24,26 @@
 
 #include "Source/Actors/Bullet.h"
 #include "Source/Actors/Player.h"
+#ifndef CENTIPEDE_HEADLESS
+#include "Source/Graphics/SpriteAtlas.h"
+#endif
 
 namespace centpd {
     ///////////////////////////////////////////////////////////////
     Bullet::Bullet(ime::Scene &scene) :
-        GameObject(scene),
+        Actor(scene),
         m_owner{nullptr},
-        m_posChangeId{-1},
-        m_destId{-1},
         m_isFired{false}
     {
         setTag("bullet");
 
+#ifndef CENTIPEDE_HEADLESS
         ime::Sprite& sprite = getSprite();
-        sprite.setTexture("Spritesheet.png");
-        sprite.setTextureRect(ime::UIntRect{12, 80, 1, 6});
+        const TextureRect& frame = SpriteAtlas::getFrame(SpriteAtlas::Actor::Bullet, SpriteAtlas::Idle);
+        sprite.setTextureRect(ime::UIntRect{frame.left, frame.top, frame.width, frame.height});
         resetSpriteOrigin();
         sprite.scale(2.0f, 2.0f);
-
-        // Collision stuff
-        setCollisionGroup("bullet");
-        getCollisionExcludeList().add("invisibleWall");
-
-        // Destroy bullet
-        onCollision([](ime::GameObject* bullet, ime::GameObject* other) {
-            std::string hitObjectType = other->getClassName();
-            if ((hitObjectType == "Mushroom")
-                || (hitObjectType == "Scorpion")
-                || (hitObjectType == "Flea")
-                || (hitObjectType == "CentipedeSegment"))
-            {
-                bullet->setActive(false);
-            }
-        });
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
@@ -73,8 +60,9 @@ namespace centpd {
     void Bullet::setOwner(Player *owner) {
         if (!m_isFired) {
             if (m_owner) {
-                m_owner->removeDestructionListener(m_destId);
-                m_owner->unsubscribe("position", m_posChangeId);
+                m_owner->disconnect<ActorEvent::Destroyed>(m_destructionHandle);
+                m_owner->disconnect<ActorEvent::Moved>(m_moveHandle);
+                m_owner = nullptr;
             }
 
             // A nullptr is usd to remove the current owner without setting a new one
@@ -86,12 +74,12 @@ namespace centpd {
 
             // Make the bullet track the position of its owner. This is done
             // because the player must visually show that it has a bullet or not
-            m_posChangeId = m_owner->onPropertyChange("position", [this](const ime::Property&) {
+            m_moveHandle = m_owner->on<ActorEvent::Moved>([this](const ime::Vector2f&) {
                 syncPosition();
             });
 
             // If the owner is destroyed before the bullet
-            m_destId = owner->onDestruction([this] {
+            m_destructionHandle = m_owner->on<ActorEvent::Destroyed>([this] {
                 m_owner = nullptr;
             });
         }
@@ -113,8 +101,8 @@ namespace centpd {
             m_isFired = true;
 
             // Stop the bullet from tracking its owners position
-            m_owner->unsubscribe("position", m_posChangeId);
-            m_posChangeId = -1;
+            m_owner->disconnect<ActorEvent::Moved>(m_moveHandle);
+            m_moveHandle = SlotHandle{};
 
             return true;
         }
@@ -137,8 +125,8 @@ namespace centpd {
     ///////////////////////////////////////////////////////////////
     Bullet::~Bullet() {
         if (m_owner) {
-            m_owner->unsubscribe("position", m_posChangeId);
-            m_owner->removeDestructionListener(m_destId);
+            m_owner->disconnect<ActorEvent::Moved>(m_moveHandle);
+            m_owner->disconnect<ActorEvent::Destroyed>(m_destructionHandle);
         }
     }
 }
@@ -25,12 +25,12 @@
 #ifndef CENTIPEDE_BULLET_H
 #define CENTIPEDE_BULLET_H
 
-#include <IME/core/game_object/GameObject.h>
+#include "Source/Actors/Actor.h"
 
 namespace centpd {
     class Player;
 
-    class Bullet : public ime::GameObject {
+    class Bullet : public Actor {
     public:
         using Ptr = std::unique_ptr<Bullet>;
 
@@ -99,10 +99,10 @@ namespace centpd {
         void syncPosition();
 
     private:
-        Player* m_owner;  //!< Bullet shooter
-        int m_destId;     //!< The id of the owners destruction id
-        int m_posChangeId;
-        bool m_isFired;   //!< A flag indicating whether or not the bullet is fired
+        Player* m_owner;                //!< Bullet shooter
+        SlotHandle m_destructionHandle; //!< The handle of the owners destruction listener
+        SlotHandle m_moveHandle;        //!< The handle of the owners movement listener
+        bool m_isFired;                 //!< A flag indicating whether or not the bullet is fired
     };
 }
 
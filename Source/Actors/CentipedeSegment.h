@@ -25,14 +25,19 @@
 #ifndef CENTIPEDE_CENTIPEDESEGMENT_H
 #define CENTIPEDE_CENTIPEDESEGMENT_H
 
-#include <IME/core/game_object/GameObject.h>
-#include <IME/core/physics/grid/GridMover.h>
+#include "Source/Actors/Actor.h"
+
+#ifndef CENTIPEDE_HEADLESS
+#include "Source/Graphics/FrameAnimator.h"
+#endif
 
 namespace centpd {
     /**
      * @brief Centipede character
+     *
+     * The segment only displays the state of a segment in the World
      */
-    class CentipedeSegment : public ime::GameObject {
+    class CentipedeSegment : public Actor {
     public:
         using Ptr = std::unique_ptr<CentipedeSegment>;
 
@@ -70,23 +75,6 @@ namespace centpd {
          */
         Type getType() const;
 
-        /**
-         * @brief Set the grid mover
-         * @param gridMover The segments grid mover
-         */
-        void setGridMover(ime::GridMover* gridMover);
-
-        /**
-         * @brief Attach a segment to this segment
-         * @param segment The segment to be attached
-         *
-         * This function works like how a chain works, you attachSegment one
-         * piece to another which can be attached to another piece and
-         * so on, essentially forming a chain of CentipedeSegments which
-         * become a centipede
-         */
-        void attachSegment(CentipedeSegment* segment);
-
         /**
          * @brief Set the direction of the segment
          * @param dir The new direction
@@ -105,36 +93,26 @@ namespace centpd {
          */
         std::string getClassName() const override;
 
-    private:
+#ifndef CENTIPEDE_HEADLESS
         /**
-         * @brief Create the segments movement animations
-         * @brief type The type of the segment
+         * @brief Advance the movement animation
+         * @param deltaTime Time passed since the last frame in seconds
          */
-        void createAnimation(Type type);
-
-        /**
-         * @brief Move up or down by one row
-         */
-        void changeRow();
-
-        /**
-         * @brief Check if segment should descend or ascend then update
-         */
-        void updateVerticalMovement();
+        void animate(float deltaTime);
+#endif
 
+    private:
         /**
          * @brief Update the segments animation
          */
         void updateAnimation();
 
     private:
-        Type m_type;                 //!< Head or body
-        CentipedeSegment* m_link;    //!< Segment attached to this segment
-        ime::Vector2i m_dir;         //!< The current direction of the segment
-        ime::GridMover* m_gridMover; //!< Responsible for moving the segment in teh grid
-        bool m_isSwitchingRows;      //!< A flag indicating whether or not the segment is moving up or down the grid
-        bool m_isDescending;         //!< A flag indicating weather or not the segment is descending or ascending
-        int m_rowChangeId;           //!< Row change handler callback id
+        Type m_type;              //!< Head or body
+        ime::Vector2i m_dir;      //!< The current direction of the segment
+#ifndef CENTIPEDE_HEADLESS
+        FrameAnimator m_animator; //!< Plays the movement animations
+#endif
     };
 }
 
@@ -27,41 +27,20 @@
 namespace centpd {
     ///////////////////////////////////////////////////////////////
     Flea::Flea(ime::Scene &scene) :
-        GameObject(scene),
-        m_hitCount{0}
+        Actor(scene)
+#ifndef CENTIPEDE_HEADLESS
+        , m_animator{SpriteAtlas::Actor::Flea, SpriteAtlas::Moving}
+#endif
     {
         setTag("flea");
-        setCollisionGroup("flea");
 
-        // Objects fleas cannot collide with
-        getCollisionExcludeList().add("invisibleWall");
-        getCollisionExcludeList().add("mushroom");
-        getCollisionExcludeList().add("scorpion");
-
-        static auto spritesheet = ime::SpriteSheet("Spritesheet.png", ime::Vector2u{9, 8}, ime::Vector2u{0, 0}, ime::UIntRect{65, 32, 9, 32});
-
-        // Init default texture
+#ifndef CENTIPEDE_HEADLESS
+        // Init default frame, the sprite has no texture of its own (see SpriteBatch)
         ime::Sprite& sprite = getSprite();
-        sprite = spritesheet.getSprite(ime::Index{0, 0}); // Set the first animation frame as the default texture
+        sprite.setTextureRect(m_animator.getFrame()); // Set the first animation frame as the default texture
         resetSpriteOrigin();
         sprite.setScale(2.0f, 2.0f);
-
-        // Init animation
-        ime::Animation::Ptr movementAnim = ime::Animation::create("moving", spritesheet, ime::milliseconds(400));
-        movementAnim->addFrames(ime::Index{0, 0}, 4, ime::FrameArrangement::Vertical);
-        movementAnim->setLoop(true);
-        sprite.getAnimator().addAnimation(std::move(movementAnim));
-        sprite.getAnimator().startAnimation("moving");
-
-        // Init collision response
-        onCollision([this](ime::GameObject*, ime::GameObject* other) {
-            if (other->getClassName() == "Bullet") {
-                m_hitCount++;
-
-                if (m_hitCount == 2)
-                    setActive(false);
-            }
-        });
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
@@ -74,8 +53,11 @@ namespace centpd {
         return "Flea";
     }
 
+#ifndef CENTIPEDE_HEADLESS
     ///////////////////////////////////////////////////////////////
-    int Flea::getHitCount() const {
-        return m_hitCount;
+    void Flea::animate(float deltaTime) {
+        if (m_animator.update(deltaTime))
+            getSprite().setTextureRect(m_animator.getFrame());
     }
+#endif
 }
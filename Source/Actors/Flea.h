@@ -25,13 +25,17 @@
 #ifndef CENTIPEDE_FLEA_H
 #define CENTIPEDE_FLEA_H
 
-#include <IME/core/game_object/GameObject.h>
+#include "Source/Actors/Actor.h"
+
+#ifndef CENTIPEDE_HEADLESS
+#include "Source/Graphics/FrameAnimator.h"
+#endif
 
 namespace centpd {
     /**
      * @brief Flea character
      */
-    class Flea : public ime::GameObject {
+    class Flea : public Actor {
     public:
         using Ptr = std::unique_ptr<Flea>;
 
@@ -54,17 +58,18 @@ namespace centpd {
          */
         std::string getClassName() const override;
 
+#ifndef CENTIPEDE_HEADLESS
         /**
-         * @brief Get the number of times the flea has been hit by a Bullet
-         * @return The number of times a Bullet hot the object
-         *
-         * The flea dies if struck twice by a bullet, therefore the hit count
-         * is in the range [0, 2]. By default it is 0
+         * @brief Advance the movement animation
+         * @param deltaTime Time passed since the last frame in seconds
          */
-        int getHitCount() const;
+        void animate(float deltaTime);
+#endif
 
     private:
-        int m_hitCount; //!< The number of times the scorpion has been hit by a bullet
+#ifndef CENTIPEDE_HEADLESS
+        FrameAnimator m_animator; //!< Plays the movement animation
+#endif
     };
 }
 
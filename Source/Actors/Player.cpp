@@ -24,23 +24,27 @@
 
 #include "Source/Actors/Player.h"
 #include "Source/Scenes/GameplayScene.h"
+#ifndef CENTIPEDE_HEADLESS
+#include "Source/Graphics/SpriteAtlas.h"
+#endif
 #include <cassert>
 
 namespace centpd {
     Player::Player(ime::Scene &scene, int lives) :
-        GameObject(scene),
+        Actor(scene),
         m_numLives{lives},
         m_posChangeId{-1},
         m_bullet{nullptr}
     {
-        setCollisionGroup("player");
         setTag("player");
 
+#ifndef CENTIPEDE_HEADLESS
         ime::Sprite& sprite = getSprite();
-        sprite.setTexture("Spritesheet.png");
-        sprite.setTextureRect(ime::UIntRect{1, 80, 7, 8});
+        const TextureRect& frame = SpriteAtlas::getFrame(SpriteAtlas::Actor::Player, SpriteAtlas::Idle);
+        sprite.setTextureRect(ime::UIntRect{frame.left, frame.top, frame.width, frame.height});
         resetSpriteOrigin();
         sprite.scale(2.0f, 2.0f);
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
@@ -56,7 +60,6 @@ namespace centpd {
         if (!m_bullet) {
             m_bullet = bullet;
             m_bullet->setOwner(this);
-            m_bullet->getCollisionExcludeList().add(getCollisionGroup()); // Player is invulnerable to bullets
         }
     }
 
@@ -71,7 +74,7 @@ namespace centpd {
             m_numLives = lives;
 
             if (m_numLives == 0)
-                setActive(false);
+                deactivate();
 
             emitChange(ime::Property{"lives", m_numLives});
         }
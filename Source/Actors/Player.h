@@ -26,13 +26,13 @@
 #define CENTIPEDE_PLAYER_H
 
 #include "Source/Actors/Bullet.h"
-#include <IME/core/game_object/GameObject.h>
+#include "Source/Actors/Actor.h"
 
 namespace centpd {
     /**
      * @brief User controlled character
      */
-    class Player : public ime::GameObject {
+    class Player : public Actor {
     public:
         using Ptr = std::unique_ptr<Player>;
 
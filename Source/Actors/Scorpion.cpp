@@ -23,39 +23,24 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Source/Actors/Scorpion.h"
-#include "Source/Actors/Mushroom.h"
 
 namespace centpd {
     ///////////////////////////////////////////////////////////////
     Scorpion::Scorpion(ime::Scene &scene) :
-        GameObject(scene)
+        Actor(scene)
+#ifndef CENTIPEDE_HEADLESS
+        , m_animator{SpriteAtlas::Actor::Scorpion, SpriteAtlas::Moving}
+#endif
     {
         setTag("scorpion");
-        setCollisionGroup("scorpion");
-        getCollisionExcludeList().add("invisibleWall");
 
-        static auto spritesheet = ime::SpriteSheet("Spritesheet.png", ime::Vector2u{16, 8}, ime::Vector2u{0, 0}, ime::UIntRect{1, 55, 64, 8});
-
-        // Init default texture
+#ifndef CENTIPEDE_HEADLESS
+        // Init default frame, the sprite has no texture of its own (see SpriteBatch)
         ime::Sprite& sprite = getSprite();
-        sprite = spritesheet.getSprite(ime::Index{0, 0}); // Set the first animation frame as the default texture
+        sprite.setTextureRect(m_animator.getFrame()); // Set the first animation frame as the default texture
         resetSpriteOrigin();
         sprite.setScale(2.0f, 2.0f);
-
-        // Init animation
-        ime::Animation::Ptr movementAnim = ime::Animation::create("moving", spritesheet, ime::milliseconds(400));
-        movementAnim->addFrames(ime::Index{0, 0}, 4);
-        movementAnim->setLoop(true);
-        sprite.getAnimator().addAnimation(std::move(movementAnim));
-        sprite.getAnimator().startAnimation("moving");
-
-        // Init collision response
-        onCollision([this](ime::GameObject*, ime::GameObject* other) {
-            if (other->getClassName() == "Bullet") {
-                setActive(false);
-            } else if (other->getClassName() == "Mushroom")
-                static_cast<Mushroom*>(other)->setPoisoned(true);
-        });
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
@@ -67,4 +52,12 @@ namespace centpd {
     std::string Scorpion::getClassName() const {
         return "Scorpion";
     }
+
+#ifndef CENTIPEDE_HEADLESS
+    ///////////////////////////////////////////////////////////////
+    void Scorpion::animate(float deltaTime) {
+        if (m_animator.update(deltaTime))
+            getSprite().setTextureRect(m_animator.getFrame());
+    }
+#endif
 }
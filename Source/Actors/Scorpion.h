@@ -25,14 +25,17 @@
 #ifndef CENTIPEDE_SCORPION_H
 #define CENTIPEDE_SCORPION_H
 
-#include <IME/core/game_object/GameObject.h>
-#include <IME/core/physics/grid/GridMover.h>
+#include "Source/Actors/Actor.h"
+
+#ifndef CENTIPEDE_HEADLESS
+#include "Source/Graphics/FrameAnimator.h"
+#endif
 
 namespace centpd {
     /**
      * @brief Scorpion character
      */
-    class Scorpion : public ime::GameObject {
+    class Scorpion : public Actor {
     public:
         using Ptr = std::unique_ptr<Scorpion>;
 
@@ -55,8 +58,18 @@ namespace centpd {
          */
         std::string getClassName() const override;
 
+#ifndef CENTIPEDE_HEADLESS
+        /**
+         * @brief Advance the movement animation
+         * @param deltaTime Time passed since the last frame in seconds
+         */
+        void animate(float deltaTime);
+#endif
+
     private:
-        int m_hitCount; //!< The number of times the scorpion has been hit by a bullet
+#ifndef CENTIPEDE_HEADLESS
+        FrameAnimator m_animator; //!< Plays the movement animation
+#endif
     };
 }
 
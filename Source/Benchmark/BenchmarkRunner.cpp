@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Runs benchmark scenarios headlessly and reports how fast they simulate,
+// see Scenario
+//
+// Usage: CentipedeBench [scenario directory or file]...
+//
+// Without arguments the scenarios in Res/Benchmarks are run. Each scenario
+// reports its ticks per second, the 50th, 95th and 99th percentile and the
+// maximum frame time in microseconds, the allocations of the run and of its
+// worst frame, and the state hash of its last tick. A build that simulates
+// differently has a different hash, its timings are not comparable
+//
+// A scenario with a CAPTURE_INTERVAL also captures frames on the CPU, the
+// rasterizing and the copy of a captured frame are part of the frame time
+// and of the allocations of the frame its tick belongs to
+
+#include "Source/Benchmark/Scenario.h"
+#include "Source/Diagnostics/FrameAllocations.h"
+#include "Source/Graphics/Png.h"
+#include "Source/Graphics/SpriteAtlas.h"
+#include "Source/Graphics/WorldRenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace centpd;
+    using Clock = std::chrono::steady_clock;
+
+    const char* const DEFAULT_SCENARIO_DIR = "Res/Benchmarks";
+    const char* const SPRITESHEET = "Res/Textures/Spritesheet.png";
+    const char* const CAPTURE_DIR = "Captures/";
+
+    /**
+     * @brief The measurements of a scenario run
+     */
+    struct Result {
+        double ticksPerSecond = 0.0;        //!< Simulated ticks per second of wall time
+        double frameTimes[4] = {};          //!< 50th, 95th and 99th percentile and maximum frame time in microseconds
+        AllocationStats allocations;        //!< Allocations of the whole run
+        AllocationStats peakFrame;          //!< Allocations of the frame with the most allocations
+        std::uint64_t framesOverBudget = 0; //!< The number of frames that exceeded the allocation budget
+        std::uint64_t stateHash = 0;        //!< The state hash after the last tick
+        unsigned int level = 0;             //!< The level reached
+    };
+
+    ///////////////////////////////////////////////////////////////
+    double getPercentile(const std::vector<double>& sorted, double fraction) {
+        const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Result run(const Scenario& scenario) {
+        World world(scenario.settings, scenario.seed);
+        world.start();
+
+        std::unique_ptr<FrameCapture> capture;
+        WorldRenderer renderer;
+        if (scenario.captureInterval > 0) {
+            SpriteAtlas::build();
+            capture = std::make_unique<FrameCapture>(Png::load(SPRITESHEET), WorldRenderer::getFrameWidth(scenario.settings),
+                WorldRenderer::getFrameHeight(scenario.settings), CAPTURE_DIR + scenario.name);
+            capture->setInterval(scenario.captureInterval);
+        }
+
+        // Everything the measured loop needs is allocated before it starts
+        std::vector<double> frameTimes;
+        frameTimes.reserve(static_cast<std::size_t>((scenario.ticks + scenario.ticksPerFrame - 1) / scenario.ticksPerFrame));
+        FrameAllocations frameAllocations(scenario.allocationBudget);
+        const AllocationStats allocationsAtStart = AllocationCounter::getTotal();
+        const Clock::time_point runStart = Clock::now();
+
+        for (std::uint64_t tick = 1; tick <= scenario.ticks;) {
+            const Clock::time_point frameStart = Clock::now();
+            for (unsigned int i = 0; i < scenario.ticksPerFrame && tick <= scenario.ticks; i++, tick++) {
+                world.tick(scenario.getInput(tick));
+
+                if (capture && capture->isDue(tick)) {
+                    capture->beginFrame();
+                    renderer.draw(world, *capture);
+                    capture->endFrame(tick);
+                }
+            }
+
+            frameTimes.push_back(std::chrono::duration<double, std::micro>(Clock::now() - frameStart).count());
+            frameAllocations.endFrame();
+        }
+
+        const double elapsed = std::chrono::duration<double>(Clock::now() - runStart).count();
+        const AllocationStats allocationsAtEnd = AllocationCounter::getTotal();
+
+        Result result;
+        result.ticksPerSecond = elapsed > 0.0 ? static_cast<double>(scenario.ticks) / elapsed : 0.0;
+        result.allocations.count = allocationsAtEnd.count - allocationsAtStart.count;
+        result.allocations.bytes = allocationsAtEnd.bytes - allocationsAtStart.bytes;
+        result.peakFrame = frameAllocations.getPeakFrame();
+        result.framesOverBudget = frameAllocations.getFramesOverBudget();
+        result.stateHash = world.getStateHash();
+        result.level = world.getLevel();
+
+        std::sort(frameTimes.begin(), frameTimes.end());
+        result.frameTimes[0] = getPercentile(frameTimes, 0.50);
+        result.frameTimes[1] = getPercentile(frameTimes, 0.95);
+        result.frameTimes[2] = getPercentile(frameTimes, 0.99);
+        result.frameTimes[3] = frameTimes.back();
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::vector<std::string> findScenarios(int argc, char* argv[]) {
+        std::vector<std::string> paths(argv + 1, argv + argc);
+        if (paths.empty())
+            paths.emplace_back(DEFAULT_SCENARIO_DIR);
+
+        // The scenarios of a directory run in the order of their names, so that reports line up
+        std::vector<std::string> scenarios;
+        for (const std::string& path : paths) {
+            if (!std::filesystem::is_directory(path)) {
+                scenarios.push_back(path);
+                continue;
+            }
+
+            std::vector<std::string> files;
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".txt")
+                    files.push_back(entry.path().string());
+            }
+
+            std::sort(files.begin(), files.end());
+            scenarios.insert(scenarios.end(), files.begin(), files.end());
+        }
+
+        return scenarios;
+    }
+}
+
+///////////////////////////////////////////////////////////////
+int main(int argc, char* argv[]) {
+    const std::vector<std::string> scenarios = findScenarios(argc, argv);
+    if (scenarios.empty()) {
+        std::cerr << "No scenarios found" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!AllocationCounter::isEnabled())
+        std::cerr << "Allocations are not counted, build with CENTIPEDE_ALLOCATION_HOOK to count them" << std::endl;
+
+    std::printf("%-24s %10s %12s %9s %9s %9s %9s %10s %8s %5s %16s\n",
+        "scenario", "ticks", "ticks/s", "p50 us", "p95 us", "p99 us", "max us", "allocs", "peak", "level", "state hash");
+
+    bool isPassed = true;
+    for (const std::string& filename : scenarios) {
+        Scenario scenario;
+        try {
+            scenario = Scenario::load(filename);
+        } catch (const std::exception& error) {
+            std::cerr << filename << ": " << error.what() << std::endl;
+            isPassed = false;
+            continue;
+        }
+
+        const Result result = run(scenario);
+        std::printf("%-24s %10llu %12.0f %9.2f %9.2f %9.2f %9.2f %10llu %8llu %5u %016llx\n",
+            scenario.name.c_str(), static_cast<unsigned long long>(scenario.ticks), result.ticksPerSecond,
+            result.frameTimes[0], result.frameTimes[1], result.frameTimes[2], result.frameTimes[3],
+            static_cast<unsigned long long>(result.allocations.count), static_cast<unsigned long long>(result.peakFrame.count),
+            result.level, static_cast<unsigned long long>(result.stateHash));
+
+        if (result.framesOverBudget > 0) {
+            std::cerr << scenario.name << ": " << result.framesOverBudget << " frames exceeded the allocation budget of "
+                      << scenario.allocationBudget << std::endl;
+            isPassed = false;
+        }
+    }
+
+    return isPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
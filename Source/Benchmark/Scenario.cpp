@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Benchmark/Scenario.h"
+#include "Source/GameLoop/SettingsFile.h"
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+namespace centpd {
+    namespace {
+        const char* const DIRECTION_NAMES[] = {"None", "Left", "Right", "Up", "Down", "UpLeft", "UpRight", "DownLeft", "DownRight"};
+
+        ///////////////////////////////////////////////////////////////
+        Direction toDirection(const std::string& name) {
+            for (std::size_t i = 0; i < std::size(DIRECTION_NAMES); i++) {
+                if (name == DIRECTION_NAMES[i])
+                    return static_cast<Direction>(i);
+            }
+
+            throw std::runtime_error("Invalid direction in INPUT: " + name);
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::vector<Scenario::InputStep> readInputScript(const std::string& script) {
+            std::vector<Scenario::InputStep> steps;
+            std::istringstream stream(script);
+            std::string step;
+            while (std::getline(stream, step, ';')) {
+                std::istringstream words(step);
+                std::string tick, direction, fire, extra;
+                if (!(words >> tick))
+                    continue;
+
+                if (!(words >> direction) || tick.find_first_not_of("0123456789") != std::string::npos || ((words >> fire) && fire != "Fire") || (words >> extra))
+                    throw std::runtime_error("Invalid step in INPUT: " + step);
+
+                const std::uint64_t start = std::stoull(tick);
+                if (!steps.empty() && start <= steps.back().tick)
+                    throw std::runtime_error("The steps in INPUT must be in tick order: " + step);
+
+                steps.push_back(Scenario::InputStep{start, PlayerInput{toDirection(direction), !fire.empty()}});
+            }
+
+            return steps;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        template <typename T, typename Getter>
+        void readOptional(const SettingsFile& file, const std::string& key, Getter get, T& value) {
+            if (file.has(key))
+                value = static_cast<T>((file.*get)(key));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Scenario Scenario::load(const std::string &filename) {
+        SettingsFile file;
+        file.load(filename);
+
+        Scenario scenario;
+        scenario.name = std::filesystem::path(filename).stem().string();
+        scenario.seed = file.getUInt("SEED");
+        scenario.ticks = file.getUInt("TICKS");
+        scenario.input = readInputScript(file.getString("INPUT"));
+
+        WorldSettings& settings = scenario.settings;
+        settings.rows = file.getUInt("GRID_ROWS");
+        settings.cols = file.getUInt("GRID_COLS");
+        settings.numMushrooms = file.getUInt("NUM_MUSHROOMS");
+        settings.centipedeLength = file.getUInt("CENTIPEDE_LENGTH");
+        settings.scorpionSpawnInterval = file.getFloat("SCORPION_SPAWN_INTERVAL");
+        settings.fleaSpawnInterval = file.getFloat("FLEA_SPAWN_INTERVAL");
+
+        readOptional(file, "SIMULATION_TICK_RATE", &SettingsFile::getUInt, settings.tickRate);
+        readOptional(file, "PLAYER_AREA_HEIGHT", &SettingsFile::getUInt, settings.playerAreaHeight);
+        readOptional(file, "PLAYER_LIVES", &SettingsFile::getInt, settings.playerLives);
+        readOptional(file, "PLAYER_SPEED", &SettingsFile::getFloat, settings.playerSpeed);
+        readOptional(file, "BULLET_SPEED", &SettingsFile::getFloat, settings.bulletSpeed);
+        readOptional(file, "CENTIPEDE_SPEED", &SettingsFile::getFloat, settings.centipedeSpeed);
+        readOptional(file, "SCORPION_SPEED", &SettingsFile::getFloat, settings.scorpionSpeed);
+        readOptional(file, "FLEA_SPEED", &SettingsFile::getFloat, settings.fleaSpeed);
+        readOptional(file, "CENTIPEDE_LENGTH_PER_LEVEL", &SettingsFile::getUInt, settings.centipedeLengthPerLevel);
+        readOptional(file, "CENTIPEDE_SPEED_PER_LEVEL", &SettingsFile::getFloat, settings.centipedeSpeedPerLevel);
+        readOptional(file, "ENABLE_PLAYER", &SettingsFile::getBool, settings.enablePlayer);
+        readOptional(file, "ENABLE_MUSHROOMS", &SettingsFile::getBool, settings.enableMushrooms);
+        readOptional(file, "ENABLE_CENTIPEDES", &SettingsFile::getBool, settings.enableCentipedes);
+        readOptional(file, "ENABLE_SCORPIONS", &SettingsFile::getBool, settings.enableScorpions);
+        readOptional(file, "ENABLE_FLEAS", &SettingsFile::getBool, settings.enableFleas);
+        readOptional(file, "TICKS_PER_FRAME", &SettingsFile::getUInt, scenario.ticksPerFrame);
+        readOptional(file, "ALLOCATION_BUDGET", &SettingsFile::getUInt, scenario.allocationBudget);
+        readOptional(file, "INPUT_LOOP", &SettingsFile::getUInt, scenario.inputLoop);
+        readOptional(file, "CAPTURE_INTERVAL", &SettingsFile::getUInt, scenario.captureInterval);
+
+        // The world asserts its parameters, a scenario is user input and is checked here instead
+        if (settings.playerAreaHeight == 0 || settings.rows <= settings.playerAreaHeight + 1 || settings.cols == 0)
+            throw std::runtime_error("GRID_ROWS must be greater than PLAYER_AREA_HEIGHT + 1, PLAYER_AREA_HEIGHT and GRID_COLS greater than 0");
+
+        if (settings.numMushrooms > (settings.rows - 3) * settings.cols)
+            throw std::runtime_error("NUM_MUSHROOMS does not fit in the grid");
+
+        if (settings.tickRate == 0 || scenario.ticksPerFrame == 0 || scenario.ticks == 0)
+            throw std::runtime_error("SIMULATION_TICK_RATE, TICKS_PER_FRAME and TICKS must be greater than 0");
+
+        if (!(settings.scorpionSpawnInterval > 0.0f) || !(settings.fleaSpawnInterval > 0.0f))
+            throw std::runtime_error("The spawn intervals must be greater than 0");
+
+        return scenario;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    PlayerInput Scenario::getInput(std::uint64_t tick) const {
+        if (inputLoop > 0)
+            tick %= inputLoop;
+
+        auto step = std::upper_bound(input.begin(), input.end(), tick, [](std::uint64_t value, const InputStep& candidate) {
+            return value < candidate.tick;
+        });
+
+        return step == input.begin() ? PlayerInput{} : std::prev(step)->input;
+    }
+}
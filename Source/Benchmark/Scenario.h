@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SCENARIO_H
+#define CENTIPEDE_SCENARIO_H
+
+#include "Source/Simulation/World.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief A reproducible benchmark run of the simulation
+     *
+     * A scenario is read from a file in the settings format (see
+     * SettingsFile) and pins everything that shapes the run: the size
+     * of the grid, the seed, the actor counts, the spawn intervals, the
+     * number of ticks and the input of the player. The same scenario
+     * simulates the same game in every build, which makes the timings
+     * of two builds comparable
+     *
+     * Required entries:
+     *  GRID_ROWS:UINT, GRID_COLS:UINT      The size of the grid in tiles
+     *  SEED:UINT                           The seed of the simulation
+     *  TICKS:UINT                          The number of ticks to simulate
+     *  NUM_MUSHROOMS:UINT                  The initial number of mushrooms
+     *  CENTIPEDE_LENGTH:UINT               The initial number of centipede segments
+     *  SCORPION_SPAWN_INTERVAL:FLOAT       The time between scorpion spawns in seconds
+     *  FLEA_SPAWN_INTERVAL:FLOAT           The time between flea spawns in seconds
+     *  INPUT:STRING                        The input script of the player, see below
+     *
+     * Optional entries use the defaults of WorldSettings when they are
+     * missing: SIMULATION_TICK_RATE, PLAYER_AREA_HEIGHT, PLAYER_LIVES, the
+     * speeds, CENTIPEDE_LENGTH_PER_LEVEL, CENTIPEDE_SPEED_PER_LEVEL and the
+     * ENABLE_* toggles, with the same names and types as in GameSettings.txt.
+     * TICKS_PER_FRAME:UINT (default 2) groups ticks into the frames that
+     * are timed, ALLOCATION_BUDGET:UINT (default 0, no budget) is the
+     * maximum number of allocations per frame, INPUT_LOOP:UINT (default
+     * 0, no loop) repeats the input script every that many ticks and
+     * CAPTURE_INTERVAL:UINT (default 0, no capture) captures a frame every
+     * that many ticks to "Captures/<name>", see FrameCapture
+     *
+     * The input script is a list of steps separated by ';'. A step is the
+     * tick it starts at, a direction (None, Left, Right, Up, Down, UpLeft,
+     * UpRight, DownLeft or DownRight) and optionally "Fire". A step holds
+     * until the next one starts, e.g. "0 Left Fire; 60 Right Fire; 120 None"
+     */
+    struct Scenario {
+        /**
+         * @brief A step of the input script
+         */
+        struct InputStep {
+            std::uint64_t tick; //!< The tick the step starts at
+            PlayerInput input;  //!< The input of the player from that tick
+        };
+
+        std::string name;                   //!< The name of the scenario, the file name without extension
+        WorldSettings settings;             //!< The parameters of the simulation
+        std::uint64_t seed = 0;             //!< The seed of the simulation
+        std::uint64_t ticks = 0;            //!< The number of ticks to simulate
+        unsigned int ticksPerFrame = 2;     //!< The number of ticks timed together as a frame
+        std::uint64_t allocationBudget = 0; //!< The maximum number of allocations per frame, 0 for no budget
+        std::uint64_t inputLoop = 0;        //!< The number of ticks after which the input script repeats, 0 for no loop
+        unsigned int captureInterval = 0;   //!< The number of ticks between captured frames, 0 for no capture
+        std::vector<InputStep> input;       //!< The input script, ordered by tick
+
+        /**
+         * @brief Read a scenario from a file
+         * @param filename The name of the file, including the path
+         * @return The scenario
+         * @throws std::runtime_error If the file cannot be read or an entry is missing or invalid
+         */
+        static Scenario load(const std::string& filename);
+
+        /**
+         * @brief Get the input of the player for a tick
+         * @param tick The tick, starting at 1
+         * @return The input of the step the tick falls in
+         *
+         * This function does not allocate, it is called while the run is measured
+         */
+        PlayerInput getInput(std::uint64_t tick) const;
+    };
+}
+
+#endif //CENTIPEDE_SCENARIO_H
@@ -25,12 +25,15 @@
 #ifndef CENTIPEDE_CONSTANTS_H
 #define CENTIPEDE_CONSTANTS_H
 
+#include <string>
+
 namespace centpd {
     /**
      * @brief Stores common game constants
      */
     struct Constants {
-        static inline unsigned int PLAYER_AREA_HEIGHT = 0; //!< The height of the players accessible area in tiles
+        static inline unsigned int PLAYER_AREA_HEIGHT = 0;               //!< The height of the players accessible area in tiles
+        static inline const std::string SETTINGS_DIR = "Res/TextFiles/"; //!< The directory of the settings files
     };
 }
 
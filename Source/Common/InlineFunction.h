@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_INLINEFUNCTION_H
+#define CENTIPEDE_INLINEFUNCTION_H
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace centpd {
+    template <typename Signature, std::size_t Capacity = 32>
+    class InlineFunction;
+
+    /**
+     * @brief A callable wrapper that never allocates
+     *
+     * Unlike std::function, the callable is always stored inside the
+     * wrapper. A callable that does not fit into @a Capacity bytes is
+     * rejected at compile time instead of being moved to the heap
+     */
+    template <typename R, typename... Args, std::size_t Capacity>
+    class InlineFunction<R(Args...), Capacity> {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty function
+         */
+        InlineFunction() noexcept :
+            m_invoke{nullptr},
+            m_manage{nullptr}
+        {}
+
+        /**
+         * @brief Construct the function from a callable
+         * @param callable The callable to be stored
+         */
+        template <typename Callable, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, InlineFunction>>>
+        InlineFunction(Callable&& callable) : // NOLINT (implicit like std::function)
+            InlineFunction()
+        {
+            using Stored = std::decay_t<Callable>;
+            static_assert(sizeof(Stored) <= Capacity, "Callable is too large for the inline storage");
+            static_assert(alignof(Stored) <= alignof(std::max_align_t), "Callable is over-aligned");
+            static_assert(std::is_nothrow_move_constructible_v<Stored>, "Callable must be nothrow move constructible");
+
+            ::new (static_cast<void*>(&m_storage)) Stored(std::forward<Callable>(callable));
+            m_invoke = &invoke<Stored>;
+            m_manage = &manage<Stored>;
+        }
+
+        /**
+         * @brief Move constructor
+         */
+        InlineFunction(InlineFunction&& other) noexcept :
+            InlineFunction()
+        {
+            moveFrom(other);
+        }
+
+        /**
+         * @brief Move assignment operator
+         */
+        InlineFunction& operator=(InlineFunction&& other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+
+            return *this;
+        }
+
+        InlineFunction(const InlineFunction&) = delete;
+        InlineFunction& operator=(const InlineFunction&) = delete;
+
+        /**
+         * @brief Destroy the stored callable
+         *
+         * The function is empty after this call
+         */
+        void reset() noexcept {
+            if (m_manage) {
+                m_manage(&m_storage, nullptr);
+                m_invoke = nullptr;
+                m_manage = nullptr;
+            }
+        }
+
+        /**
+         * @brief Check if the function stores a callable
+         * @return True if a callable is stored, otherwise false
+         */
+        explicit operator bool() const noexcept {
+            return m_invoke != nullptr;
+        }
+
+        /**
+         * @brief Call the stored callable
+         * @param args The arguments to pass to the callable
+         * @return The value returned by the callable
+         */
+        R operator()(Args... args) const {
+            assert(m_invoke && "Cannot call an empty InlineFunction");
+            return m_invoke(const_cast<void*>(static_cast<const void*>(&m_storage)), std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Destructor
+         */
+        ~InlineFunction() {
+            reset();
+        }
+
+    private:
+        template <typename Stored>
+        static R invoke(void* storage, Args... args) {
+            return (*static_cast<Stored*>(storage))(std::forward<Args>(args)...);
+        }
+
+        // Moves the callable in src into dst, or destroys src when dst is a nullptr
+        template <typename Stored>
+        static void manage(void* src, void* dst) noexcept {
+            auto* callable = static_cast<Stored*>(src);
+            if (dst)
+                ::new (dst) Stored(std::move(*callable));
+
+            callable->~Stored();
+        }
+
+        void moveFrom(InlineFunction& other) noexcept {
+            if (other.m_manage) {
+                other.m_manage(&other.m_storage, &m_storage);
+                m_invoke = other.m_invoke;
+                m_manage = other.m_manage;
+                other.m_invoke = nullptr;
+                other.m_manage = nullptr;
+            }
+        }
+
+    private:
+        std::aligned_storage_t<Capacity, alignof(std::max_align_t)> m_storage; //!< Inline callable storage
+        R (*m_invoke)(void*, Args...);                                           //!< Calls the stored callable
+        void (*m_manage)(void*, void*) noexcept;                                 //!< Moves or destroys the stored callable
+    };
+}
+
+#endif //CENTIPEDE_INLINEFUNCTION_H
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SIGNAL_H
+#define CENTIPEDE_SIGNAL_H
+
+#include "Source/Common/InlineFunction.h"
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Identifies a callback connected to a Signal
+     *
+     * A handle stays valid until the callback is disconnected. Once it is,
+     * the slot may be reused by another callback but the old handle will
+     * no longer match it, so disconnecting twice is harmless
+     */
+    struct SlotHandle {
+        static constexpr std::uint32_t INVALID = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = INVALID;  //!< The index of the slot in the signal
+        std::uint32_t generation = 0;   //!< The generation of the slot when the callback was connected
+
+        /**
+         * @brief Check if the handle refers to a slot
+         * @return True if the handle refers to a slot, otherwise false
+         */
+        bool isValid() const { return index != INVALID; }
+    };
+
+    /**
+     * @brief Notifies a list of callbacks when an event occurs
+     * @tparam Args The arguments passed to the callbacks
+     *
+     * Callbacks are stored inline and slots are recycled, so emitting never
+     * allocates. Callbacks may connect and disconnect other callbacks (or
+     * themselves) while the signal is being emitted. Callbacks connected
+     * during an emission are first called on the next emission, they are
+     * always given a new slot rather than a recycled one
+     */
+    template <typename... Args>
+    class Signal {
+    public:
+        using Callback = InlineFunction<void(Args...)>;
+
+        /**
+         * @brief Default constructor
+         */
+        Signal() :
+            m_emitDepth{0},
+            m_hasPendingReset{false}
+        {}
+
+        Signal(const Signal&) = delete;
+        Signal& operator=(const Signal&) = delete;
+
+        /**
+         * @brief Add a callback to the signal
+         * @param callback The function to be executed when the signal is emitted
+         * @return The handle of the callback
+         */
+        SlotHandle connect(Callback callback) {
+            // A reused slot could be below the slot count of an emission in progress
+            std::uint32_t index;
+            if (m_freeSlots.empty() || m_emitDepth > 0) {
+                index = static_cast<std::uint32_t>(m_slots.size());
+                m_slots.emplace_back();
+            } else {
+                index = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+
+            Slot& slot = m_slots[index];
+            slot.callback = std::move(callback);
+            slot.isConnected = true;
+            return SlotHandle{index, slot.generation};
+        }
+
+        /**
+         * @brief Remove a callback from the signal
+         * @param handle The handle of the callback to be removed
+         * @return True if the callback was removed or false if it was not connected
+         */
+        bool disconnect(SlotHandle handle) {
+            if (!handle.isValid() || handle.index >= m_slots.size())
+                return false;
+
+            Slot& slot = m_slots[handle.index];
+            if (!slot.isConnected || slot.generation != handle.generation)
+                return false;
+
+            slot.isConnected = false;
+            slot.generation++;
+
+            // A callback may be disconnecting itself, so it must outlive the emission
+            if (m_emitDepth > 0)
+                m_hasPendingReset = true;
+            else
+                release(handle.index);
+
+            return true;
+        }
+
+        /**
+         * @brief Remove all callbacks from the signal
+         */
+        void disconnectAll() {
+            for (std::uint32_t i = 0; i < m_slots.size(); ++i)
+                disconnect(SlotHandle{i, m_slots[i].generation});
+        }
+
+        /**
+         * @brief Call all the connected callbacks
+         * @param args The arguments to pass to the callbacks
+         */
+        void emit(Args... args) {
+            ++m_emitDepth;
+
+            // Slots appended by callbacks are skipped, std::deque keeps existing slots in place
+            const std::size_t count = m_slots.size();
+            for (std::size_t i = 0; i < count; ++i) {
+                if (m_slots[i].isConnected)
+                    m_slots[i].callback(args...);
+            }
+
+            if (--m_emitDepth == 0 && m_hasPendingReset) {
+                m_hasPendingReset = false;
+                for (std::uint32_t i = 0; i < m_slots.size(); ++i) {
+                    if (!m_slots[i].isConnected && m_slots[i].callback)
+                        release(i);
+                }
+            }
+        }
+
+        /**
+         * @brief Get the number of connected callbacks
+         * @return The number of connected callbacks
+         */
+        std::size_t getSize() const {
+            std::size_t size = 0;
+            for (const auto& slot : m_slots)
+                size += slot.isConnected ? 1 : 0;
+
+            return size;
+        }
+
+    private:
+        /**
+         * @brief A callback and its bookkeeping
+         */
+        struct Slot {
+            Callback callback;
+            std::uint32_t generation = 0;
+            bool isConnected = false;
+        };
+
+        /**
+         * @brief Destroy the callback of a disconnected slot and recycle the slot
+         * @param index The index of the slot
+         */
+        void release(std::uint32_t index) {
+            m_slots[index].callback.reset();
+            m_freeSlots.push_back(index);
+        }
+
+    private:
+        std::deque<Slot> m_slots;               //!< Connected and recyclable slots
+        std::vector<std::uint32_t> m_freeSlots; //!< Indices of the slots that can be reused
+        unsigned int m_emitDepth;               //!< The number of nested emissions in progress
+        bool m_hasPendingReset;                 //!< A flag indicating whether slots were disconnected during an emission
+    };
+}
+
+#endif //CENTIPEDE_SIGNAL_H
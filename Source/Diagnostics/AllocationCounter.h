@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_ALLOCATIONCOUNTER_H
+#define CENTIPEDE_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace centpd {
+    /**
+     * @brief A number of heap allocations and the bytes they requested
+     */
+    struct AllocationStats {
+        std::uint64_t count = 0; //!< The number of allocations
+        std::uint64_t bytes = 0; //!< The total size of the allocations in bytes
+    };
+
+    /**
+     * @brief Counts the heap allocations of the whole process
+     *
+     * The counts are recorded by the replacement global operator new in
+     * AllocationHook.cpp, which is only compiled when the
+     * CENTIPEDE_ALLOCATION_HOOK option is enabled. Without the hook the
+     * counts stay at zero. Allocations of every thread are counted,
+     * except those of threads that exclude themselves. Every background
+     * thread of the game (metrics server, frame capture, score writer and
+     * settings watcher) excludes itself, so that the frame counts only
+     * depend on the game thread and not on the timing of their I/O
+     */
+    class AllocationCounter {
+    public:
+        /**
+         * @brief Check if allocations are being counted
+         * @return True if the allocation hook is compiled in, otherwise false
+         */
+        static constexpr bool isEnabled() {
+#ifdef CENTIPEDE_ALLOCATION_HOOK
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Get the allocations made since the program started
+         * @return The allocations made since the program started
+         */
+        static AllocationStats getTotal() {
+            return AllocationStats{m_count.load(std::memory_order_relaxed), m_bytes.load(std::memory_order_relaxed)};
+        }
+
+        /**
+         * @brief Record an allocation
+         * @param bytes The size of the allocation
+         *
+         * This function is called by the allocation hook
+         */
+        static void record(std::size_t bytes) noexcept {
+            if (m_isThreadExcluded)
+                return;
+
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Stop or resume counting the allocations of the calling thread
+         * @param exclude True to stop counting, false to resume
+         */
+        static void setThreadExcluded(bool exclude) noexcept {
+            m_isThreadExcluded = exclude;
+        }
+
+    private:
+        static inline std::atomic<std::uint64_t> m_count{0};       //!< The number of allocations
+        static inline std::atomic<std::uint64_t> m_bytes{0};       //!< The number of bytes allocated
+        static inline thread_local bool m_isThreadExcluded{false}; //!< Whether the allocations of this thread are ignored
+    };
+}
+
+#endif //CENTIPEDE_ALLOCATIONCOUNTER_H
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Replacement of the global allocation functions. Every allocation made
+// through operator new is recorded by the AllocationCounter before being
+// forwarded to malloc. Deallocation is not counted
+
+#include "Source/Diagnostics/AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    ///////////////////////////////////////////////////////////////
+    void* allocate(std::size_t size) noexcept {
+        centpd::AllocationCounter::record(size);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+        centpd::AllocationCounter::record(size);
+        const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // The size passed to aligned_alloc must be a multiple of the alignment
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void deallocateAligned(void* ptr) noexcept {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new(std::size_t size) {
+    if (void* ptr = allocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, alignment))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+///////////////////////////////////////////////////////////////
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    deallocateAligned(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    deallocateAligned(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    deallocateAligned(ptr);
+}
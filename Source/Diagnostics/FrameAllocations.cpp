@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Diagnostics/FrameAllocations.h"
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    FrameAllocations::FrameAllocations(std::uint64_t budget) :
+        m_budget{budget},
+        m_frameStart{AllocationCounter::getTotal()},
+        m_frameCount{0},
+        m_framesOverBudget{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void FrameAllocations::setBudget(std::uint64_t budget) {
+        m_budget = budget;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t FrameAllocations::getBudget() const {
+        return m_budget;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameAllocations::endFrame() {
+        AllocationStats total = AllocationCounter::getTotal();
+        m_lastFrame.count = total.count - m_frameStart.count;
+        m_lastFrame.bytes = total.bytes - m_frameStart.bytes;
+        m_frameStart = total;
+        m_frameCount++;
+
+        if (m_lastFrame.count > m_peakFrame.count)
+            m_peakFrame = m_lastFrame;
+
+        if (m_budget > 0 && m_lastFrame.count > m_budget)
+            m_framesOverBudget++;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const AllocationStats &FrameAllocations::getLastFrame() const {
+        return m_lastFrame;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const AllocationStats &FrameAllocations::getPeakFrame() const {
+        return m_peakFrame;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t FrameAllocations::getFrameCount() const {
+        return m_frameCount;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t FrameAllocations::getFramesOverBudget() const {
+        return m_framesOverBudget;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool FrameAllocations::isWithinBudget() const {
+        return m_framesOverBudget == 0;
+    }
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_FRAMEALLOCATIONS_H
+#define CENTIPEDE_FRAMEALLOCATIONS_H
+
+#include "Source/Diagnostics/AllocationCounter.h"
+
+namespace centpd {
+    /**
+     * @brief Counts the heap allocations made in each frame
+     *
+     * The allocations of a frame are the difference between the totals
+     * of the AllocationCounter at two consecutive calls to endFrame().
+     * A frame that makes more allocations than the budget is counted as
+     * over budget, benchmarks fail when any frame is over budget
+     */
+    class FrameAllocations {
+    public:
+        /**
+         * @brief Constructor
+         * @param budget The maximum number of allocations per frame, 0 for no budget
+         */
+        explicit FrameAllocations(std::uint64_t budget = 0);
+
+        /**
+         * @brief Set the maximum number of allocations per frame
+         * @param budget The maximum number of allocations per frame, 0 for no budget
+         */
+        void setBudget(std::uint64_t budget);
+
+        /**
+         * @brief Get the maximum number of allocations per frame
+         * @return The maximum number of allocations per frame, 0 if there is no budget
+         */
+        std::uint64_t getBudget() const;
+
+        /**
+         * @brief End the current frame and start the next one
+         *
+         * This function must be called once per frame
+         */
+        void endFrame();
+
+        /**
+         * @brief Get the allocations of the last ended frame
+         * @return The allocations of the last ended frame
+         */
+        const AllocationStats& getLastFrame() const;
+
+        /**
+         * @brief Get the allocations of the frame with the most allocations
+         * @return The allocations of the frame with the most allocations
+         */
+        const AllocationStats& getPeakFrame() const;
+
+        /**
+         * @brief Get the number of frames ended so far
+         * @return The number of frames ended so far
+         */
+        std::uint64_t getFrameCount() const;
+
+        /**
+         * @brief Get the number of frames that exceeded the budget
+         * @return The number of frames that exceeded the budget
+         */
+        std::uint64_t getFramesOverBudget() const;
+
+        /**
+         * @brief Check if every frame stayed within the budget
+         * @return True if no frame exceeded the budget, otherwise false
+         */
+        bool isWithinBudget() const;
+
+    private:
+        std::uint64_t m_budget;           //!< The maximum number of allocations per frame
+        AllocationStats m_frameStart;     //!< Total allocations at the start of the current frame
+        AllocationStats m_lastFrame;      //!< Allocations of the last ended frame
+        AllocationStats m_peakFrame;      //!< Allocations of the frame with the most allocations
+        std::uint64_t m_frameCount;       //!< The number of frames ended so far
+        std::uint64_t m_framesOverBudget; //!< The number of frames that exceeded the budget
+    };
+}
+
+#endif //CENTIPEDE_FRAMEALLOCATIONS_H
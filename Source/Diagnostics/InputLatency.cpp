@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Diagnostics/InputLatency.h"
+
+namespace centpd {
+    namespace {
+        // Bucket bounds in seconds, from a fraction of a tick to several tile moves
+        const std::vector<double> LATENCY_BOUNDS = {0.004, 0.008, 0.016, 0.033, 0.05, 0.075, 0.1, 0.15, 0.2, 0.3, 0.5, 1.0};
+    }
+
+    ///////////////////////////////////////////////////////////////
+    InputLatency::InputLatency(MetricRegistry& registry, std::size_t player) :
+        m_player{player},
+        m_moveDir{Direction::None},
+        m_lastRow{-1},
+        m_lastCol{-1},
+        m_nextBulletId{0},
+        m_moveLatency{registry.addHistogram("centipede_input_latency_seconds", "Time from a key press to its effect in the simulation", LATENCY_BOUNDS, "input=\"move\"")},
+        m_fireLatency{registry.addHistogram("centipede_input_latency_seconds", "Time from a key press to its effect in the simulation", LATENCY_BOUNDS, "input=\"fire\"")},
+        m_droppedMoves{registry.add("centipede_input_dropped_total", "Key presses that had no effect in time", MetricType::Counter, "input=\"move\"")},
+        m_droppedFires{registry.add("centipede_input_dropped_total", "Key presses that had no effect in time", MetricType::Counter, "input=\"fire\"")}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void InputLatency::onMovePressed(Direction dir, Clock::time_point time) {
+        if (m_move.isPending && dir == m_moveDir)
+            return;
+
+        if (m_move.isPending)
+            m_droppedMoves.increment();
+
+        m_move = Press{true, time};
+        m_moveDir = dir;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void InputLatency::onFirePressed(Clock::time_point time) {
+        if (!m_fire.isPending)
+            m_fire = Press{true, time};
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void InputLatency::onTick(const World& world, Clock::time_point time) {
+        const ActorArrays& players = world.getActors(ActorKind::Player);
+        if (m_player >= players.size() || !players.active[m_player])
+            return;
+
+        // A move starts by entering the next tile, the position changes in the tick it starts
+        const bool isMoveStarted = players.row[m_player] != m_lastRow || players.col[m_player] != m_lastCol;
+        m_lastRow = players.row[m_player];
+        m_lastCol = players.col[m_player];
+        if (m_move.isPending && isMoveStarted && players.dir[m_player] == m_moveDir)
+            resolve(m_move, time, m_moveLatency);
+
+        const ActorArrays& bullets = world.getActors(ActorKind::Bullet);
+        for (std::size_t i = 0; i < bullets.size(); i++) {
+            if (bullets.active[i] && bullets.link[i] == static_cast<std::int32_t>(m_player) && bullets.id[i] >= m_nextBulletId) {
+                m_nextBulletId = bullets.id[i] + 1;
+                if (m_fire.isPending)
+                    resolve(m_fire, time, m_fireLatency);
+            }
+        }
+
+        expire(m_move, time, m_droppedMoves);
+        expire(m_fire, time, m_droppedFires);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void InputLatency::resolve(Press& press, Clock::time_point time, Histogram& histogram) {
+        histogram.observe(std::chrono::duration<double>(time - press.time).count());
+        press.isPending = false;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void InputLatency::expire(Press& press, Clock::time_point time, Metric& dropped) {
+        if (press.isPending && time - press.time > MAX_LATENCY) {
+            dropped.increment();
+            press.isPending = false;
+        }
+    }
+}
@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_INPUTLATENCY_H
+#define CENTIPEDE_INPUTLATENCY_H
+
+#include "Source/Diagnostics/Metrics.h"
+#include "Source/Simulation/World.h"
+#include <chrono>
+
+namespace centpd {
+    /**
+     * @brief Measures the time from a key press to its effect in the simulation
+     *
+     * Key presses are recorded with the time they were received. After
+     * each tick the simulation is checked for their effect: the player
+     * starting a move in the pressed direction, or a new bullet of the
+     * player. The time in between is observed in a histogram. A press
+     * that has no effect within MAX_LATENCY, e.g. a move into a wall, is
+     * counted as dropped instead. Latency is measured from the earliest
+     * unanswered press: repeated presses of the fire key or of the same
+     * movement key wait for the same effect, while a press of another
+     * movement key drops the unanswered one
+     */
+    class InputLatency {
+    public:
+        using Clock = std::chrono::steady_clock;
+        static constexpr Clock::duration MAX_LATENCY = std::chrono::seconds(1); //!< The time after which a press counts as dropped
+
+        /**
+         * @brief Constructor
+         * @param registry The registry to add the latency metrics to
+         * @param player The index of the local player
+         */
+        InputLatency(MetricRegistry& registry, std::size_t player);
+
+        /**
+         * @brief Record a press of a movement key
+         * @param dir The direction of the key
+         * @param time The time the press was received
+         */
+        void onMovePressed(Direction dir, Clock::time_point time);
+
+        /**
+         * @brief Record a press of the fire key
+         * @param time The time the press was received
+         */
+        void onFirePressed(Clock::time_point time);
+
+        /**
+         * @brief Look for the effects of the recorded presses
+         * @param world The simulation after the tick
+         * @param time The time the tick finished
+         */
+        void onTick(const World& world, Clock::time_point time);
+
+    private:
+        /**
+         * @brief A press whose effect has not been seen yet
+         */
+        struct Press {
+            bool isPending = false;   //!< True if the press is waiting for its effect
+            Clock::time_point time{}; //!< The time the press was received
+        };
+
+        /**
+         * @brief Observe the latency of a press and forget it
+         * @param press The press
+         * @param time The time its effect was seen
+         * @param histogram The histogram to observe the latency in
+         */
+        static void resolve(Press& press, Clock::time_point time, Histogram& histogram);
+
+        /**
+         * @brief Count a press as dropped if it waited too long
+         * @param press The press
+         * @param time The current time
+         * @param dropped The counter of dropped presses
+         */
+        static void expire(Press& press, Clock::time_point time, Metric& dropped);
+
+    private:
+        std::size_t m_player;         //!< The index of the local player
+        Press m_move;                 //!< The last unanswered movement key press
+        Direction m_moveDir;          //!< The direction of the movement key press
+        Press m_fire;                 //!< The last unanswered fire key press
+        std::int16_t m_lastRow;       //!< The row of the player after the previous tick
+        std::int16_t m_lastCol;       //!< The column of the player after the previous tick
+        std::uint32_t m_nextBulletId; //!< Bullets of the player with this id or higher are new
+        Histogram& m_moveLatency;     //!< Time from a movement key press to the player moving
+        Histogram& m_fireLatency;     //!< Time from a fire key press to the bullet appearing
+        Metric& m_droppedMoves;       //!< Movement key presses without effect
+        Metric& m_droppedFires;       //!< Fire key presses without effect
+    };
+}
+
+#endif //CENTIPEDE_INPUTLATENCY_H
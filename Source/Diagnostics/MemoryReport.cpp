@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Diagnostics/MemoryReport.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    void MemoryReport::add(const std::string &name, std::size_t count, std::size_t bytes) {
+        m_entries.push_back(Entry{name, count, bytes});
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MemoryReport::setAllocations(const AllocationStats &lastFrame, const AllocationStats &peakFrame, std::uint64_t budget) {
+        m_lastFrame = lastFrame;
+        m_peakFrame = peakFrame;
+        m_budget = budget;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<MemoryReport::Entry> &MemoryReport::getEntries() const {
+        return m_entries;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t MemoryReport::getTotalBytes() const {
+        std::size_t total = 0;
+        for (const auto& entry : m_entries)
+            total += entry.bytes;
+
+        return total;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::string MemoryReport::toString() const {
+        std::ostringstream stream;
+        for (const auto& entry : m_entries) {
+            stream << std::left << std::setw(18) << entry.name << std::right
+                   << std::setw(6) << entry.count << std::setw(10) << entry.bytes << " B\n";
+        }
+
+        stream << std::left << std::setw(18) << "Total" << std::right
+               << std::setw(16) << getTotalBytes() << " B\n";
+
+        if (AllocationCounter::isEnabled()) {
+            stream << "Allocations last frame: " << m_lastFrame.count << " (" << m_lastFrame.bytes << " B)\n"
+                   << "Allocations peak frame: " << m_peakFrame.count << " (" << m_peakFrame.bytes << " B)\n";
+
+            if (m_budget > 0)
+                stream << "Allocation budget: " << m_budget << " per frame\n";
+        } else
+            stream << "Allocations are not counted (CENTIPEDE_ALLOCATION_HOOK is disabled)\n";
+
+        return stream.str();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool MemoryReport::saveToFile(const std::string &filename) const {
+        std::ofstream file(filename);
+        if (!file)
+            return false;
+
+        file << toString();
+        return static_cast<bool>(file);
+    }
+}
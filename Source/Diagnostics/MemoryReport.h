@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_MEMORYREPORT_H
+#define CENTIPEDE_MEMORYREPORT_H
+
+#include "Source/Diagnostics/AllocationCounter.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief A snapshot of the live instances and memory of each type
+     *
+     * The byte counts are approximate. They include the instances and the
+     * buffers they own directly, not the heap memory of third party
+     * members (e.g. the sprite of a game object)
+     */
+    class MemoryReport {
+    public:
+        /**
+         * @brief The memory of one type
+         */
+        struct Entry {
+            std::string name;  //!< The name of the type
+            std::size_t count; //!< The number of live instances
+            std::size_t bytes; //!< The approximate memory used by the instances
+        };
+
+        /**
+         * @brief Add the memory of a type
+         * @param name The name of the type
+         * @param count The number of live instances
+         * @param bytes The approximate memory used by the instances
+         */
+        void add(const std::string& name, std::size_t count, std::size_t bytes);
+
+        /**
+         * @brief Set the allocations of the process
+         * @param lastFrame The allocations of the last frame
+         * @param peakFrame The allocations of the frame with the most allocations
+         * @param budget The allocation budget per frame, 0 if there is no budget
+         */
+        void setAllocations(const AllocationStats& lastFrame, const AllocationStats& peakFrame, std::uint64_t budget);
+
+        /**
+         * @brief Get the memory of each type
+         * @return The memory of each type in the order it was added
+         */
+        const std::vector<Entry>& getEntries() const;
+
+        /**
+         * @brief Get the memory used by all the types
+         * @return The sum of the bytes of all the entries
+         */
+        std::size_t getTotalBytes() const;
+
+        /**
+         * @brief Format the report as a table
+         * @return The report, one line per type followed by the allocations
+         */
+        std::string toString() const;
+
+        /**
+         * @brief Write the report to a file
+         * @param filename The name of the file
+         * @return True if the report was written, otherwise false
+         */
+        bool saveToFile(const std::string& filename) const;
+
+    private:
+        std::vector<Entry> m_entries; //!< The memory of each type
+        AllocationStats m_lastFrame;  //!< The allocations of the last frame
+        AllocationStats m_peakFrame;  //!< The allocations of the frame with the most allocations
+        std::uint64_t m_budget = 0;   //!< The allocation budget per frame
+    };
+}
+
+#endif //CENTIPEDE_MEMORYREPORT_H
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Diagnostics/Metrics.h"
+#include <algorithm>
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    Metric::Metric(std::string labels) :
+        m_value{0.0},
+        m_labels{std::move(labels)}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void Metric::increment(double amount) {
+        double value = m_value.load(std::memory_order_relaxed);
+        while (!m_value.compare_exchange_weak(value, value + amount, std::memory_order_relaxed)) {}
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void Metric::set(double value) {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    double Metric::get() const {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::string &Metric::getLabels() const {
+        return m_labels;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Histogram::Histogram(std::vector<double> bounds, std::string labels) :
+        m_bounds{std::move(bounds)},
+        m_buckets(m_bounds.size() + 1),
+        m_count{0},
+        m_sum{std::move(labels)}
+    {
+        assert(std::is_sorted(m_bounds.begin(), m_bounds.end()) && "The bucket bounds must be in ascending order");
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void Histogram::observe(double value) {
+        const auto bucket = static_cast<std::size_t>(std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin());
+        m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.increment(value);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<double> &Histogram::getBounds() const {
+        return m_bounds;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t Histogram::getBucketCount(std::size_t bucket) const {
+        return m_buckets[bucket].load(std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t Histogram::getCount() const {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    double Histogram::getSum() const {
+        return m_sum.get();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::string &Histogram::getLabels() const {
+        return m_sum.getLabels();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MetricRegistry &MetricRegistry::getGlobal() {
+        static MetricRegistry registry;
+        return registry;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Metric &MetricRegistry::add(const std::string &name, const std::string &help, MetricType type, const std::string &labels) {
+        assert(type != MetricType::Histogram && "Histograms are added with addHistogram");
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        Family& family = getFamily(name, help, type);
+        for (auto& metric : family.metrics) {
+            if (metric.getLabels() == labels)
+                return metric;
+        }
+
+        return family.metrics.emplace_back(labels);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Histogram &MetricRegistry::addHistogram(const std::string &name, const std::string &help, const std::vector<double> &bounds, const std::string &labels) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        Family& family = getFamily(name, help, MetricType::Histogram);
+        for (auto& histogram : family.histograms) {
+            if (histogram.getLabels() == labels)
+                return histogram;
+        }
+
+        return family.histograms.emplace_back(bounds, labels);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::string MetricRegistry::serialize() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        std::ostringstream stream;
+        stream << std::setprecision(12);
+        for (const auto& family : m_families) {
+            const char* type = family.type == MetricType::Counter ? "counter" : family.type == MetricType::Gauge ? "gauge" : "histogram";
+            stream << "# HELP " << family.name << " " << family.help << "\n"
+                   << "# TYPE " << family.name << " " << type << "\n";
+
+            for (const auto& metric : family.metrics) {
+                stream << family.name;
+                if (!metric.getLabels().empty())
+                    stream << "{" << metric.getLabels() << "}";
+
+                stream << " " << metric.get() << "\n";
+            }
+
+            // The buckets of a histogram are exported cumulatively, each includes the buckets below it
+            for (const auto& histogram : family.histograms) {
+                const std::string labels = histogram.getLabels().empty() ? "" : histogram.getLabels() + ",";
+                std::uint64_t count = 0;
+                for (std::size_t i = 0; i <= histogram.getBounds().size(); i++) {
+                    count += histogram.getBucketCount(i);
+                    stream << family.name << "_bucket{" << labels << "le=\"";
+                    if (i < histogram.getBounds().size())
+                        stream << histogram.getBounds()[i];
+                    else
+                        stream << "+Inf";
+
+                    stream << "\"} " << count << "\n";
+                }
+
+                const std::string suffix = histogram.getLabels().empty() ? "" : "{" + histogram.getLabels() + "}";
+                stream << family.name << "_sum" << suffix << " " << histogram.getSum() << "\n"
+                       << family.name << "_count" << suffix << " " << count << "\n";
+            }
+        }
+
+        return stream.str();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MetricRegistry::Family &MetricRegistry::getFamily(const std::string &name, const std::string &help, MetricType type) {
+        for (auto& existing : m_families) {
+            if (existing.name == name)
+                return existing;
+        }
+
+        return m_families.emplace_back(Family{name, help, type, {}, {}});
+    }
+}
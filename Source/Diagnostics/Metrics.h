@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_METRICS_H
+#define CENTIPEDE_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief The type of a metric
+     */
+    enum class MetricType {
+        Counter,  //!< A value that only increases
+        Gauge,    //!< A value that can go up and down
+        Histogram //!< A distribution of observed values, see Histogram
+    };
+
+    /**
+     * @brief A single value exported by the MetricsExporter
+     *
+     * Updating and reading the value is lock-free, metrics can be updated
+     * from the main thread while they are being exported on another thread
+     */
+    class Metric {
+    public:
+        /**
+         * @brief Constructor
+         * @param labels The labels of the metric in Prometheus format, e.g. kind="Flea"
+         */
+        explicit Metric(std::string labels);
+
+        /**
+         * @brief Increase the value
+         * @param amount The amount to increase the value by
+         */
+        void increment(double amount = 1.0);
+
+        /**
+         * @brief Set the value
+         * @param value The new value
+         */
+        void set(double value);
+
+        /**
+         * @brief Get the value
+         * @return The current value
+         */
+        double get() const;
+
+        /**
+         * @brief Get the labels of the metric
+         * @return The labels of the metric, empty if it has none
+         */
+        const std::string& getLabels() const;
+
+    private:
+        std::atomic<double> m_value; //!< The current value
+        std::string m_labels;        //!< The labels in Prometheus format
+    };
+
+    /**
+     * @brief Counts observed values in buckets, e.g. latencies
+     *
+     * Each bucket counts the observations that are less than or equal to
+     * its upper bound, the last bucket counts every observation. Like
+     * Metric, observing and reading are lock-free
+     */
+    class Histogram {
+    public:
+        /**
+         * @brief Constructor
+         * @param bounds The upper bounds of the buckets in ascending order, without +Inf
+         * @param labels The labels of the histogram in Prometheus format, e.g. input="fire"
+         */
+        Histogram(std::vector<double> bounds, std::string labels);
+
+        /**
+         * @brief Record a value
+         * @param value The observed value
+         */
+        void observe(double value);
+
+        /**
+         * @brief Get the upper bounds of the buckets
+         * @return The upper bounds of the buckets, without +Inf
+         */
+        const std::vector<double>& getBounds() const;
+
+        /**
+         * @brief Get the number of observations in a bucket
+         * @param bucket The index of the bucket, getBounds().size() for +Inf
+         * @return The number of observations less than or equal to the bound of the bucket
+         */
+        std::uint64_t getBucketCount(std::size_t bucket) const;
+
+        /**
+         * @brief Get the number of observations
+         * @return The number of observations
+         */
+        std::uint64_t getCount() const;
+
+        /**
+         * @brief Get the sum of the observed values
+         * @return The sum of the observed values
+         */
+        double getSum() const;
+
+        /**
+         * @brief Get the labels of the histogram
+         * @return The labels of the histogram, empty if it has none
+         */
+        const std::string& getLabels() const;
+
+    private:
+        std::vector<double> m_bounds;                      //!< The upper bounds of the buckets
+        std::vector<std::atomic<std::uint64_t>> m_buckets; //!< Observations per bucket, not cumulative
+        std::atomic<std::uint64_t> m_count;                //!< The number of observations
+        Metric m_sum;                                      //!< The sum of the observed values
+    };
+
+    /**
+     * @brief Owns the metrics of the game
+     *
+     * Metrics with the same name form a family and are exported together.
+     * Adding metrics takes a lock, so metrics should be added once and the
+     * returned reference kept. References stay valid for the lifetime of
+     * the registry
+     */
+    class MetricRegistry {
+    public:
+        /**
+         * @brief Get the registry of the process
+         * @return The registry of the process
+         */
+        static MetricRegistry& getGlobal();
+
+        /**
+         * @brief Add a metric
+         * @param name The name of the metric, e.g. centipede_frames_total
+         * @param help A description of the metric
+         * @param type The type of the metric
+         * @param labels The labels of the metric in Prometheus format, e.g. kind="Flea"
+         * @return The added metric, or the existing metric with the same name and labels
+         */
+        Metric& add(const std::string& name, const std::string& help, MetricType type, const std::string& labels = "");
+
+        /**
+         * @brief Add a histogram
+         * @param name The name of the histogram, e.g. centipede_input_latency_seconds
+         * @param help A description of the histogram
+         * @param bounds The upper bounds of the buckets in ascending order, without +Inf
+         * @param labels The labels of the histogram in Prometheus format, e.g. input="fire"
+         * @return The added histogram, or the existing histogram with the same name and labels
+         */
+        Histogram& addHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds, const std::string& labels = "");
+
+        /**
+         * @brief Format all the metrics in the Prometheus text format
+         * @return The metrics in the Prometheus text format
+         */
+        std::string serialize() const;
+
+    private:
+        /**
+         * @brief Metrics with the same name
+         */
+        struct Family {
+            std::string name;            //!< The name of the metrics
+            std::string help;            //!< A description of the metrics
+            MetricType type;             //!< The type of the metrics
+            std::deque<Metric> metrics;       //!< The metrics, one per set of labels
+            std::deque<Histogram> histograms; //!< The histograms of a Histogram family, one per set of labels
+        };
+
+        /**
+         * @brief Find or add a family
+         * @param name The name of the family
+         * @param help A description of the family
+         * @param type The type of the family
+         * @return The family
+         *
+         * The mutex must be locked
+         */
+        Family& getFamily(const std::string& name, const std::string& help, MetricType type);
+
+        mutable std::mutex m_mutex;    //!< Guards the families, not the metric values
+        std::deque<Family> m_families; //!< The metric families in the order they were added
+    };
+}
+
+#endif //CENTIPEDE_METRICS_H
@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Diagnostics/MetricsExporter.h"
+#include "Source/Diagnostics/AllocationCounter.h"
+#include <cstring>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/select.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace centpd {
+    namespace {
+        const std::intptr_t NO_SOCKET = -1;
+
+        // How long the server waits for a connection before checking if it should stop
+        const long POLL_INTERVAL_MS = 100;
+
+        // A client that disconnects early must not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+        const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+        const int SEND_FLAGS = 0;
+#endif
+
+        ///////////////////////////////////////////////////////////////
+        void closeSocket(std::intptr_t socket) {
+#ifdef _WIN32
+            ::closesocket(static_cast<SOCKET>(socket));
+#else
+            ::close(static_cast<int>(socket));
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////
+        bool waitUntilReadable(std::intptr_t socket) {
+            fd_set sockets;
+            FD_ZERO(&sockets);
+            FD_SET(socket, &sockets);
+            timeval timeout{0, POLL_INTERVAL_MS * 1000};
+            return ::select(static_cast<int>(socket + 1), &sockets, nullptr, nullptr, &timeout) > 0;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        bool sendAll(std::intptr_t socket, const std::string& data) {
+            std::size_t sent = 0;
+            while (sent < data.size()) {
+                auto result = ::send(socket, data.data() + sent, static_cast<int>(data.size() - sent), SEND_FLAGS);
+                if (result <= 0)
+                    return false;
+
+                sent += static_cast<std::size_t>(result);
+            }
+
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MetricsExporter::MetricsExporter(const MetricRegistry& registry) :
+        m_registry{registry},
+        m_socket{NO_SOCKET},
+        m_isRunning{false}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    bool MetricsExporter::listenTcp(std::uint16_t port) {
+        stop();
+
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (::WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+            return false;
+
+        auto socket = static_cast<std::intptr_t>(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+        if (socket == static_cast<std::intptr_t>(INVALID_SOCKET))
+            return false;
+#else
+        std::intptr_t socket = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (socket < 0)
+            return false;
+#endif
+
+        int reuse = 1;
+        ::setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(socket, 4) != 0) {
+            closeSocket(socket);
+            return false;
+        }
+
+        start(socket);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool MetricsExporter::listenUnix(const std::string& path) {
+        stop();
+
+#ifdef _WIN32
+        (void) path;
+        return false;
+#else
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path))
+            return false;
+
+        std::intptr_t socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socket < 0)
+            return false;
+
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        ::unlink(path.c_str());
+
+        if (::bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(socket, 4) != 0) {
+            closeSocket(socket);
+            return false;
+        }
+
+        m_unixPath = path;
+        start(socket);
+        return true;
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool MetricsExporter::isListening() const {
+        return m_isRunning;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MetricsExporter::stop() {
+        m_isRunning = false;
+        if (m_server.joinable())
+            m_server.join();
+
+        if (m_socket != NO_SOCKET) {
+            closeSocket(m_socket);
+            m_socket = NO_SOCKET;
+
+#ifdef _WIN32
+            ::WSACleanup();
+#else
+            if (!m_unixPath.empty())
+                ::unlink(m_unixPath.c_str());
+#endif
+            m_unixPath.clear();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MetricsExporter::start(std::intptr_t socket) {
+        m_socket = socket;
+        m_isRunning = true;
+        m_server = std::thread(&MetricsExporter::serve, this);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MetricsExporter::serve() {
+        // Scrapes must not show up in the allocation counts of the frames they overlap
+        AllocationCounter::setThreadExcluded(true);
+
+        while (m_isRunning) {
+            if (!waitUntilReadable(m_socket))
+                continue;
+
+            auto client = static_cast<std::intptr_t>(::accept(m_socket, nullptr, nullptr));
+            if (client < 0)
+                continue;
+
+            respond(client);
+            closeSocket(client);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MetricsExporter::respond(std::intptr_t client) {
+        // Only the request line is needed, the rest of the request is ignored
+        std::string request;
+        char buffer[512];
+        while (request.find("\r\n") == std::string::npos && request.size() < 4096 && waitUntilReadable(client)) {
+            auto received = ::recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+                break;
+
+            request.append(buffer, static_cast<std::size_t>(received));
+        }
+
+        std::string status, body;
+        if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0) {
+            status = "200 OK";
+            body = m_registry.serialize();
+        } else {
+            status = "404 Not Found";
+            body = "Metrics are served at /metrics\n";
+        }
+
+        sendAll(client, "HTTP/1.1 " + status + "\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: close\r\n\r\n" + body);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MetricsExporter::~MetricsExporter() {
+        stop();
+    }
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_METRICSEXPORTER_H
+#define CENTIPEDE_METRICSEXPORTER_H
+
+#include "Source/Diagnostics/Metrics.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace centpd {
+    /**
+     * @brief Serves metrics in the Prometheus text format
+     *
+     * The exporter answers HTTP requests for /metrics on a localhost TCP
+     * port or a Unix domain socket. Requests are served on a background
+     * thread that only reads the metric values, so a scrape never blocks
+     * the game loop
+     */
+    class MetricsExporter {
+    public:
+        /**
+         * @brief Constructor
+         * @param registry The metrics to be served
+         */
+        explicit MetricsExporter(const MetricRegistry& registry);
+
+        /**
+         * @brief Serve metrics on a localhost TCP port
+         * @param port The port to listen on
+         * @return True if the exporter is listening, otherwise false
+         *
+         * Only connections from the local machine are accepted
+         */
+        bool listenTcp(std::uint16_t port);
+
+        /**
+         * @brief Serve metrics on a Unix domain socket
+         * @param path The path of the socket file
+         * @return True if the exporter is listening, otherwise false
+         *
+         * An existing file at @a path is replaced. Unix sockets are not
+         * supported on Windows, the function always returns false there
+         */
+        bool listenUnix(const std::string& path);
+
+        /**
+         * @brief Check if the exporter is serving metrics
+         * @return True if the exporter is serving metrics, otherwise false
+         */
+        bool isListening() const;
+
+        /**
+         * @brief Stop serving metrics
+         */
+        void stop();
+
+        /**
+         * @brief Destructor
+         *
+         * Stops serving metrics
+         */
+        ~MetricsExporter();
+
+    private:
+        /**
+         * @brief Start the thread that serves the metrics
+         * @param socket The listening socket
+         */
+        void start(std::intptr_t socket);
+
+        /**
+         * @brief Accept and answer connections until the exporter is stopped
+         */
+        void serve();
+
+        /**
+         * @brief Answer a single request
+         * @param client The socket of the connection
+         */
+        void respond(std::intptr_t client);
+
+    private:
+        const MetricRegistry& m_registry; //!< The metrics to be served
+        std::intptr_t m_socket;           //!< The listening socket
+        std::string m_unixPath;           //!< The path of the Unix socket file, empty for TCP
+        std::atomic<bool> m_isRunning;    //!< A flag indicating whether or not the thread should keep serving
+        std::thread m_server;             //!< Serves the metrics
+    };
+}
+
+#endif //CENTIPEDE_METRICSEXPORTER_H
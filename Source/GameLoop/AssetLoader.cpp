@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/GameLoop/AssetLoader.h"
+#include "Source/Graphics/Png.h"
+#include "Source/Graphics/SpriteAtlas.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    AssetLoader::AssetLoader(const std::string &manifest) :
+        m_manifest{manifest}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void AssetLoader::start() {
+        std::ifstream manifest(m_manifest);
+        if (!manifest)
+            throw std::runtime_error("Cannot open asset manifest: " + m_manifest);
+
+        std::string missing;
+        std::string line;
+        while (std::getline(manifest, line)) {
+            if (line.empty() || line.rfind("//", 0) == 0)
+                continue;
+
+            std::istringstream entry(line);
+            std::string type, path;
+            if (!(entry >> type >> path))
+                throw std::runtime_error("Invalid asset manifest entry: " + line);
+
+            if (type == "texture")
+                m_textures.push_back(path);
+            else if (type == "file")
+                m_files.push_back(path);
+            else
+                throw std::runtime_error("Unknown asset type in manifest: " + type);
+
+            if (!std::filesystem::exists(path))
+                missing += "\n    " + path;
+        }
+
+        if (!missing.empty())
+            throw std::runtime_error("Required assets are missing:" + missing);
+
+        m_decoding = std::async(std::launch::async, &AssetLoader::decode, this);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void AssetLoader::wait() {
+        if (m_decoding.valid())
+            m_decoding.get();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const Image &AssetLoader::getImage(const std::string &name) {
+        return m_images.at(name);
+    }
+
+#ifndef CENTIPEDE_HEADLESS
+    ///////////////////////////////////////////////////////////////
+    void AssetLoader::upload() {
+        for (const auto& [name, image] : m_images) {
+            sf::Texture& texture = m_uploaded[name];
+            if (!texture.create(image.getWidth(), image.getHeight()))
+                throw std::runtime_error("Failed to create texture: " + name);
+
+            texture.update(image.getPixels().data());
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const sf::Texture &AssetLoader::getTexture(const std::string &name) {
+        return m_uploaded.at(name);
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////
+    void AssetLoader::decode() {
+        for (const auto& texture : m_textures)
+            m_images[std::filesystem::path(texture).filename().string()] = Png::load(texture);
+
+        SpriteAtlas::build();
+    }
+}
@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_ASSETLOADER_H
+#define CENTIPEDE_ASSETLOADER_H
+
+#include "Source/Graphics/Image.h"
+#ifndef CENTIPEDE_HEADLESS
+    #include <SFML/Graphics/Texture.hpp>
+#endif
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Validates and preloads the assets listed in the asset manifest
+     *
+     * The manifest is a text file with one asset per line in the format
+     * "<type> <path>", where type is either "texture" or "file" and path
+     * is relative to the working directory. Lines that start with "//"
+     * are comments. For example:
+     *
+     * @code
+     * // The texture shared by all actors
+     * texture Res/Textures/Spritesheet.png
+     * file Res/TextFiles/GameSettings.txt
+     * @endcode
+     *
+     * Every asset must exist on the disk, otherwise loading fails before
+     * any work is done. Textures are then decoded into CPU images and the
+     * SpriteAtlas is built on a background thread, so that this work
+     * overlaps with creating the window and loading the settings. Once
+     * the window exists, upload() creates the video memory textures from
+     * the decoded images, so each texture is read and decoded only once.
+     * The simulation only build (CENTIPEDE_HEADLESS) decodes them as well,
+     * it draws captured frames from the decoded textures
+     */
+    class AssetLoader {
+    public:
+        /**
+         * @brief Constructor
+         * @param manifest The filename of the asset manifest, including the path
+         */
+        explicit AssetLoader(const std::string& manifest);
+
+        /**
+         * @brief Check the assets and start decoding them in the background
+         * @throws std::runtime_error If the manifest cannot be read or an asset is missing
+         */
+        void start();
+
+        /**
+         * @brief Wait for the background work to finish
+         * @throws std::runtime_error If an asset could not be decoded
+         */
+        void wait();
+
+        /**
+         * @brief Get a decoded texture
+         * @param name The name of the texture without its path, e.g. "Spritesheet.png"
+         * @return The decoded texture
+         * @throws std::out_of_range If the texture is not in the manifest
+         *
+         * Textures are only available after wait() returns. They remain
+         * available for the lifetime of the process
+         */
+        static const Image& getImage(const std::string& name);
+
+#ifndef CENTIPEDE_HEADLESS
+        /**
+         * @brief Create the video memory textures from the decoded textures
+         * @throws std::runtime_error If a texture cannot be created
+         *
+         * This function must be called after wait() returns, on the thread
+         * that owns the window
+         */
+        void upload();
+
+        /**
+         * @brief Get a texture in video memory
+         * @param name The name of the texture without its path, e.g. "Spritesheet.png"
+         * @return The texture
+         * @throws std::out_of_range If the texture has not been uploaded
+         */
+        static const sf::Texture& getTexture(const std::string& name);
+#endif
+
+    private:
+        /**
+         * @brief Decode all textures and build the sprite atlas
+         */
+        void decode();
+
+    private:
+        std::string m_manifest;                                          //!< Filename of the asset manifest
+        std::vector<std::string> m_textures;                             //!< Paths of the textures to decode
+        std::vector<std::string> m_files;                                //!< Paths of the other required files
+        std::future<void> m_decoding;                                    //!< Background decoding result
+        static inline std::unordered_map<std::string, Image> m_images{}; //!< Decoded textures by name
+#ifndef CENTIPEDE_HEADLESS
+        static inline std::unordered_map<std::string, sf::Texture> m_uploaded{}; //!< Video memory textures by name
+#endif
+    };
+}
+
+#endif //CENTIPEDE_ASSETLOADER_H
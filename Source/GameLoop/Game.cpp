@@ -24,25 +24,58 @@
 
 #include "Source/GameLoop/Game.h"
 #include "Source/Scenes/GameplayScene.h"
+#include "Source/Common/Constants.h"
+#include <cstdlib>
+#include <iostream>
 
 namespace centpd {
-    const std::string SETTINGS_DIR = "Res/TextFiles/";
-
     ///////////////////////////////////////////////////////////////
     Game::Game() :
-        engine_{"Centipede", SETTINGS_DIR + "EngineSettings.txt"}
+        engine_{"Centipede", Constants::SETTINGS_DIR + "EngineSettings.txt"},
+        assets_{Constants::SETTINGS_DIR + "AssetManifest.txt"},
+        metricsExporter_{MetricRegistry::getGlobal()}
     {}
 
     ///////////////////////////////////////////////////////////////
     void Game::initialize() {
+        // Textures are decoded in the background while the window is created
+        assets_.start();
         engine_.initialize();
-        engine_.getSavablePersistentData().load(SETTINGS_DIR + "GameSettings.txt");
-        engine_.pushScene(GameplayScene::create());
+        engine_.getSavablePersistentData().load(Constants::SETTINGS_DIR + "GameSettings.txt");
+        assets_.wait();
+
+        auto& settings = engine_.getSavablePersistentData();
+        frameAllocations_.setBudget(settings.getPref("FRAME_ALLOCATION_BUDGET").getValue<unsigned int>());
+
+        // The metrics are optional, the game runs normally if the exporter cannot listen
+        const auto metricsSocket = settings.getPref("METRICS_SOCKET").getValue<std::string>();
+        const auto metricsPort = settings.getPref("METRICS_PORT").getValue<unsigned int>();
+        if (!metricsSocket.empty() && !metricsExporter_.listenUnix(metricsSocket))
+            std::cerr << "Failed to serve metrics on " << metricsSocket << std::endl;
+        else if (metricsSocket.empty() && metricsPort > 0 && !metricsExporter_.listenTcp(static_cast<std::uint16_t>(metricsPort)))
+            std::cerr << "Failed to serve metrics on port " << metricsPort << std::endl;
+
+#ifndef CENTIPEDE_HEADLESS
+        // The sprite batches draw from these textures, they are created from
+        // the images decoded above rather than read from the disk again
+        assets_.upload();
+#endif
+
+        engine_.pushScene(GameplayScene::create(frameAllocations_));
     }
 
     ///////////////////////////////////////////////////////////////
-    void Game::start() {
+    int Game::start() {
         engine_.run();
+
+        if (!frameAllocations_.isWithinBudget()) {
+            std::cerr << frameAllocations_.getFramesOverBudget() << " of " << frameAllocations_.getFrameCount()
+                      << " frames exceeded the allocation budget of " << frameAllocations_.getBudget()
+                      << " (peak: " << frameAllocations_.getPeakFrame().count << ")" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
     }
 
 } // namespace centpd
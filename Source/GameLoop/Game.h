@@ -25,6 +25,9 @@
 #ifndef CENTIPEDE_GAME_H
 #define CENTIPEDE_GAME_H
 
+#include "Source/GameLoop/AssetLoader.h"
+#include "Source/Diagnostics/FrameAllocations.h"
+#include "Source/Diagnostics/MetricsExporter.h"
 #include <IME/core/engine/Engine.h>
 
 namespace centpd {
@@ -45,11 +48,17 @@ namespace centpd {
 
         /**
          * @brief Start the game
+         * @return EXIT_SUCCESS, or EXIT_FAILURE if a frame exceeded the allocation budget
+         *
+         * This function returns when the game window is closed
          */
-        void start();
+        int start();
 
     private:
-        ime::Engine engine_; //!< Runs the main game loop
+        FrameAllocations frameAllocations_; //!< Counts the heap allocations of each frame
+        ime::Engine engine_;                //!< Runs the main game loop
+        AssetLoader assets_;                //!< Preloads the assets in the background during initialization
+        MetricsExporter metricsExporter_;   //!< Serves the game metrics when enabled
     };
 }
 
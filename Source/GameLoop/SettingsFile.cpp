@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/GameLoop/SettingsFile.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace centpd {
+    namespace {
+        ///////////////////////////////////////////////////////////////
+        bool isValidValue(const std::string& type, const std::string& value) {
+            if (type == "STRING")
+                return true;
+
+            if (type == "BOOL")
+                return value == "0" || value == "1";
+
+            if (value.empty())
+                return false;
+
+            try {
+                std::size_t end = 0;
+                if (type == "INT")
+                    std::stoi(value, &end);
+                else if (type == "UINT" && value[0] != '-')
+                    std::stoul(value, &end);
+                else if (type == "FLOAT")
+                    std::stof(value, &end);
+                else if (type == "DOUBLE")
+                    std::stod(value, &end);
+                else
+                    return false;
+
+                return end == value.size();
+            } catch (const std::exception&) {
+                return false;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SettingsFile::load(const std::string &filename) {
+        std::ifstream file(filename);
+        if (!file)
+            throw std::runtime_error("Cannot open settings file: " + filename);
+
+        m_entries.clear();
+
+        std::string line;
+        for (unsigned int lineNumber = 1; std::getline(file, line); lineNumber++) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.empty() || line.rfind("//", 0) == 0 || line[0] == '#')
+                continue;
+
+            const std::size_t colon = line.find(':');
+            const std::size_t equals = line.find('=', colon);
+            if (colon == std::string::npos || colon == 0 || equals == std::string::npos)
+                throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": Invalid entry: " + line);
+
+            std::string key = line.substr(0, colon);
+            std::string type = line.substr(colon + 1, equals - colon - 1);
+            std::string value = line.substr(equals + 1);
+
+            if (!isValidValue(type, value))
+                throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": Invalid " + type + " value for " + key + ": " + value);
+
+            m_entries[key] = Entry{type, value};
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SettingsFile::has(const std::string &key) const {
+        return m_entries.find(key) != m_entries.end();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SettingsFile::getBool(const std::string &key) const {
+        return get(key, "BOOL") == "1";
+    }
+
+    ///////////////////////////////////////////////////////////////
+    int SettingsFile::getInt(const std::string &key) const {
+        return std::stoi(get(key, "INT"));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SettingsFile::getUInt(const std::string &key) const {
+        return static_cast<unsigned int>(std::stoul(get(key, "UINT")));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    float SettingsFile::getFloat(const std::string &key) const {
+        return std::stof(get(key, "FLOAT"));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::string &SettingsFile::getString(const std::string &key) const {
+        return get(key, "STRING");
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::string &SettingsFile::get(const std::string &key, const std::string &type) const {
+        auto found = m_entries.find(key);
+        if (found == m_entries.end())
+            throw std::runtime_error("Missing setting: " + key);
+
+        if (found->second.type != type)
+            throw std::runtime_error("Setting " + key + " must be of type " + type + ", not " + found->second.type);
+
+        return found->second.value;
+    }
+}
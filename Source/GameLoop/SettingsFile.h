@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SETTINGSFILE_H
+#define CENTIPEDE_SETTINGSFILE_H
+
+#include <string>
+#include <unordered_map>
+
+namespace centpd {
+    /**
+     * @brief Reads a settings file in the IME preference format
+     *
+     * Each entry is a line in the format "KEY:TYPE=value", where TYPE is
+     * one of STRING, BOOL, INT, UINT, FLOAT or DOUBLE. Lines that start
+     * with "//" or "#" are comments. Unlike ime::PrefContainer the file
+     * can be read on any thread, which lets settings be parsed and
+     * validated in the background
+     */
+    class SettingsFile {
+    public:
+        /**
+         * @brief Read the settings from a file
+         * @param filename The name of the file, including the path
+         * @throws std::runtime_error If the file cannot be read or an entry is invalid
+         *
+         * The previously read settings are discarded. Every value is
+         * checked against its declared type
+         */
+        void load(const std::string& filename);
+
+        /**
+         * @brief Check if a setting exists
+         * @param key The key of the setting
+         * @return True if the setting exists, otherwise false
+         */
+        bool has(const std::string& key) const;
+
+        /**
+         * @brief Get the value of a setting
+         * @param key The key of the setting
+         * @return The value of the setting
+         * @throws std::runtime_error If the setting does not exist or is of a different type
+         */
+        bool getBool(const std::string& key) const;
+        int getInt(const std::string& key) const;
+        unsigned int getUInt(const std::string& key) const;
+        float getFloat(const std::string& key) const;
+        const std::string& getString(const std::string& key) const;
+
+    private:
+        /**
+         * @brief A setting
+         */
+        struct Entry {
+            std::string type;  //!< The declared type of the value
+            std::string value; //!< The value as it appears in the file
+        };
+
+        /**
+         * @brief Get the value of a setting
+         * @param key The key of the setting
+         * @param type The expected type of the setting
+         * @return The value of the setting
+         * @throws std::runtime_error If the setting does not exist or is of a different type
+         */
+        const std::string& get(const std::string& key, const std::string& type) const;
+
+    private:
+        std::unordered_map<std::string, Entry> m_entries; //!< Settings by key
+    };
+}
+
+#endif //CENTIPEDE_SETTINGSFILE_H
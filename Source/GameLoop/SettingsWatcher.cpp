@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/GameLoop/SettingsWatcher.h"
+#include "Source/GameLoop/SettingsFile.h"
+#include "Source/Diagnostics/AllocationCounter.h"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace centpd {
+    namespace {
+        // How often the watcher checks if it should stop
+        const int POLL_INTERVAL_MS = 200;
+
+        ///////////////////////////////////////////////////////////////
+        float readPositive(const SettingsFile& file, const std::string& key) {
+            float value = file.getFloat(key);
+            if (!(value > 0.0f))
+                throw std::runtime_error(key + " must be greater than 0");
+
+            return value;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        WorldSettings readWorldSettings(const SettingsFile& file, WorldSettings settings) {
+            settings.tickRate = file.getUInt("SIMULATION_TICK_RATE");
+            if (settings.tickRate == 0)
+                throw std::runtime_error("SIMULATION_TICK_RATE must be greater than 0");
+
+            settings.playerSpeed = readPositive(file, "PLAYER_SPEED");
+            settings.bulletSpeed = readPositive(file, "BULLET_SPEED");
+            settings.centipedeSpeed = readPositive(file, "CENTIPEDE_SPEED");
+            settings.scorpionSpeed = readPositive(file, "SCORPION_SPEED");
+            settings.fleaSpeed = readPositive(file, "FLEA_SPEED");
+            settings.centipedeSpeedPerLevel = file.getFloat("CENTIPEDE_SPEED_PER_LEVEL");
+            if (settings.centipedeSpeedPerLevel < 0.0f)
+                throw std::runtime_error("CENTIPEDE_SPEED_PER_LEVEL must not be negative");
+
+            settings.centipedeLengthPerLevel = file.getUInt("CENTIPEDE_LENGTH_PER_LEVEL");
+            settings.scorpionSpawnInterval = readPositive(file, "SCORPION_SPAWN_INTERVAL");
+            settings.fleaSpawnInterval = readPositive(file, "FLEA_SPAWN_INTERVAL");
+            settings.enableMushrooms = file.getBool("ENABLE_MUSHROOMS");
+            settings.enableScorpions = file.getBool("ENABLE_SCORPIONS");
+            settings.enableFleas = file.getBool("ENABLE_FLEAS");
+            return settings;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SettingsWatcher::SettingsWatcher(std::string filename, const WorldSettings& current) :
+        m_filename{std::move(filename)},
+        m_current{current},
+        m_pending{current},
+        m_hasPending{false},
+        m_isRunning{false}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void SettingsWatcher::start() {
+        if (!m_isRunning) {
+            m_isRunning = true;
+            m_watcher = std::thread(&SettingsWatcher::watch, this);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SettingsWatcher::stop() {
+        m_isRunning = false;
+        if (m_watcher.joinable())
+            m_watcher.join();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SettingsWatcher::poll(WorldSettings& settings) {
+        if (!m_hasPending.load(std::memory_order_acquire))
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        settings = m_pending;
+        m_hasPending = false;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SettingsWatcher::watch() {
+        // Reloads happen whenever the file changes, they must not show up in the allocation counts of the frames
+        AllocationCounter::setThreadExcluded(true);
+        const std::filesystem::path path{m_filename};
+
+#ifdef __linux__
+        // The directory is watched instead of the file, editors often save
+        // by writing a new file and renaming it over the old one
+        int inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        std::string directory = path.has_parent_path() ? path.parent_path().string() : ".";
+        if (inotify >= 0 && inotify_add_watch(inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) >= 0) {
+            const std::string filename = path.filename().string();
+            alignas(inotify_event) char buffer[4096];
+
+            while (m_isRunning) {
+                pollfd descriptor{inotify, POLLIN, 0};
+                if (::poll(&descriptor, 1, POLL_INTERVAL_MS) <= 0)
+                    continue;
+
+                bool isChanged = false;
+                ssize_t length;
+                while ((length = ::read(inotify, buffer, sizeof(buffer))) > 0) {
+                    for (char* event = buffer; event < buffer + length;) {
+                        auto* notification = reinterpret_cast<inotify_event*>(event);
+                        if (notification->len > 0 && filename == notification->name)
+                            isChanged = true;
+
+                        event += sizeof(inotify_event) + notification->len;
+                    }
+                }
+
+                if (isChanged)
+                    reload();
+            }
+
+            ::close(inotify);
+            return;
+        }
+
+        if (inotify >= 0)
+            ::close(inotify);
+#endif
+
+        // Fall back to polling the modification time of the file
+        std::error_code error;
+        auto lastWrite = std::filesystem::last_write_time(path, error);
+        while (m_isRunning) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+            auto writeTime = std::filesystem::last_write_time(path, error);
+            if (!error && writeTime != lastWrite) {
+                lastWrite = writeTime;
+                reload();
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SettingsWatcher::reload() {
+        try {
+            SettingsFile file;
+            file.load(m_filename);
+            m_current = readWorldSettings(file, m_current);
+        } catch (const std::exception& e) {
+            std::cerr << "Settings not reloaded: " << e.what() << std::endl;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = m_current;
+        m_hasPending.store(true, std::memory_order_release);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SettingsWatcher::~SettingsWatcher() {
+        stop();
+    }
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SETTINGSWATCHER_H
+#define CENTIPEDE_SETTINGSWATCHER_H
+
+#include "Source/Simulation/World.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace centpd {
+    /**
+     * @brief Reloads the game settings when the settings file changes
+     *
+     * The file is watched on a background thread (with inotify on Linux,
+     * by polling its modification time elsewhere). When it changes it is
+     * parsed and validated on that thread, and the new settings are handed
+     * over to the game loop, which applies them at a tick boundary. A file
+     * with an invalid entry is reported and ignored, the game keeps
+     * running with the settings it has
+     *
+     * Only settings that can change while a game is running are reloaded:
+     * speeds, spawn intervals, the tick rate and the enabled actors. The
+     * other settings (e.g. the size of the player area) are kept
+     */
+    class SettingsWatcher {
+    public:
+        /**
+         * @brief Constructor
+         * @param filename The settings file to watch, including the path
+         * @param current The settings the game is running with
+         */
+        SettingsWatcher(std::string filename, const WorldSettings& current);
+
+        /**
+         * @brief Start watching the settings file
+         */
+        void start();
+
+        /**
+         * @brief Stop watching the settings file
+         */
+        void stop();
+
+        /**
+         * @brief Take the settings read since the last call
+         * @param settings Receives the new settings
+         * @return True if new settings were read, otherwise false
+         *
+         * This function never blocks on file access, it is meant to be
+         * called once per frame by the game loop
+         */
+        bool poll(WorldSettings& settings);
+
+        /**
+         * @brief Destructor
+         *
+         * Stops watching the settings file
+         */
+        ~SettingsWatcher();
+
+    private:
+        /**
+         * @brief Wait for changes to the file until stopped
+         */
+        void watch();
+
+        /**
+         * @brief Read and validate the settings file
+         */
+        void reload();
+
+    private:
+        std::string m_filename;         //!< The settings file
+        WorldSettings m_current;        //!< The settings the read values are applied on top of
+        WorldSettings m_pending;        //!< Validated settings waiting to be taken by the game loop
+        std::mutex m_mutex;             //!< Guards the pending settings
+        std::atomic<bool> m_hasPending; //!< A flag indicating whether or not there are pending settings
+        std::atomic<bool> m_isRunning;  //!< A flag indicating whether or not the file is being watched
+        std::thread m_watcher;          //!< Watches the file
+    };
+}
+
+#endif //CENTIPEDE_SETTINGSWATCHER_H
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/GameLoop/SimulationClock.h"
+#include <cassert>
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    SimulationClock::SimulationClock(unsigned int tickRate, unsigned int maxTicksPerFrame) :
+        m_tickRate{0},
+        m_maxTicksPerFrame{maxTicksPerFrame},
+        m_tickDuration{0.0},
+        m_accumulator{0.0},
+        m_tickCount{0}
+    {
+        assert(maxTicksPerFrame > 0 && "At least one tick must be allowed per frame");
+        setTickRate(tickRate);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SimulationClock::setTickRate(unsigned int tickRate) {
+        assert(tickRate > 0 && "The tick rate must be greater than zero");
+        m_tickRate = tickRate;
+        m_tickDuration = 1.0 / static_cast<double>(tickRate);
+        m_accumulator = 0.0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SimulationClock::getTickRate() const {
+        return m_tickRate;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    double SimulationClock::getTickDuration() const {
+        return m_tickDuration;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SimulationClock::advance(double frameTime) {
+        if (frameTime > 0.0)
+            m_accumulator += frameTime;
+
+        unsigned int numTicks = 0;
+        while (m_accumulator >= m_tickDuration && numTicks < m_maxTicksPerFrame) {
+            m_accumulator -= m_tickDuration;
+            numTicks++;
+        }
+
+        // Drop the time we could not catch up on, otherwise a long stall
+        // (e.g. dragging the window) would be followed by a burst of ticks
+        if (m_accumulator >= m_tickDuration)
+            m_accumulator = 0.0;
+
+        m_tickCount += numTicks;
+        return numTicks;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    float SimulationClock::getInterpolationFactor() const {
+        return static_cast<float>(m_accumulator / m_tickDuration);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t SimulationClock::getTickCount() const {
+        return m_tickCount;
+    }
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SIMULATIONCLOCK_H
+#define CENTIPEDE_SIMULATIONCLOCK_H
+
+#include <cstdint>
+
+namespace centpd {
+    /**
+     * @brief Converts variable frame times into fixed simulation ticks
+     *
+     * The clock accumulates the time elapsed between rendered frames and
+     * reports how many fixed-length ticks must be simulated to catch up
+     * with real time. Since every tick has the same duration, gameplay
+     * does not depend on the rate at which frames are delivered. The
+     * time left over after the ticks are consumed is exposed as an
+     * interpolation factor which can be used to render actors between
+     * their previous and current simulated positions
+     */
+    class SimulationClock {
+    public:
+        /**
+         * @brief Constructor
+         * @param tickRate The number of simulation ticks per second
+         * @param maxTicksPerFrame The maximum number of ticks to run in one frame
+         *
+         * @a maxTicksPerFrame prevents the simulation from spiralling when
+         * a frame takes longer than the ticks it has to catch up on. Any
+         * time beyond the limit is discarded
+         */
+        explicit SimulationClock(unsigned int tickRate = 120, unsigned int maxTicksPerFrame = 8);
+
+        /**
+         * @brief Set the number of simulation ticks per second
+         * @param tickRate The new tick rate
+         *
+         * The accumulated time is reset when the tick rate changes
+         */
+        void setTickRate(unsigned int tickRate);
+
+        /**
+         * @brief Get the number of simulation ticks per second
+         * @return The number of simulation ticks per second
+         */
+        unsigned int getTickRate() const;
+
+        /**
+         * @brief Get the duration of a single tick in seconds
+         * @return The duration of a single tick in seconds
+         */
+        double getTickDuration() const;
+
+        /**
+         * @brief Advance the clock by the time elapsed since the last frame
+         * @param frameTime The time elapsed since the last frame in seconds
+         * @return The number of ticks that must be simulated this frame
+         */
+        unsigned int advance(double frameTime);
+
+        /**
+         * @brief Get how far real time is between the last tick and the next
+         * @return A value in the range [0, 1)
+         *
+         * A value of 0 means the last tick is exactly at the current time,
+         * whilst a value close to 1 means the next tick is almost due
+         */
+        float getInterpolationFactor() const;
+
+        /**
+         * @brief Get the number of ticks simulated since the clock was created
+         * @return The total number of ticks
+         */
+        std::uint64_t getTickCount() const;
+
+    private:
+        unsigned int m_tickRate;         //!< Number of ticks per second
+        unsigned int m_maxTicksPerFrame; //!< Upper bound of ticks to run in a single frame
+        double m_tickDuration;           //!< Duration of a single tick in seconds
+        double m_accumulator;            //!< Real time that has not been simulated yet
+        std::uint64_t m_tickCount;       //!< Total number of ticks handed out
+    };
+}
+
+#endif //CENTIPEDE_SIMULATIONCLOCK_H
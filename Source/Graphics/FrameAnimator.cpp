@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/FrameAnimator.h"
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    FrameAnimator::FrameAnimator(SpriteAtlas::Actor actor, unsigned int animation) :
+        m_actor{actor},
+        m_animation{animation},
+        m_frame{0},
+        m_elapsed{0.0f}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    bool FrameAnimator::play(SpriteAtlas::Actor actor, unsigned int animation) {
+        if (m_actor == actor && m_animation == animation)
+            return false;
+
+        m_actor = actor;
+        m_animation = animation;
+        m_frame = 0;
+        m_elapsed = 0.0f;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool FrameAnimator::update(float deltaTime) {
+        const float frameDuration = SpriteAtlas::getFrameDuration(m_actor, m_animation);
+        if (frameDuration <= 0.0f)
+            return false;
+
+        m_elapsed += deltaTime;
+        if (m_elapsed < frameDuration)
+            return false;
+
+        const unsigned int frameCount = SpriteAtlas::getFrameCount(m_actor, m_animation);
+        while (m_elapsed >= frameDuration) {
+            m_elapsed -= frameDuration;
+            m_frame = (m_frame + 1) % frameCount;
+        }
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    ime::UIntRect FrameAnimator::getFrame() const {
+        const TextureRect& frame = SpriteAtlas::getFrame(m_actor, m_animation, m_frame);
+        return ime::UIntRect{frame.left, frame.top, frame.width, frame.height};
+    }
+}
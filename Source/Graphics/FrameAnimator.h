@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_FRAMEANIMATOR_H
+#define CENTIPEDE_FRAMEANIMATOR_H
+
+#include "Source/Graphics/SpriteAtlas.h"
+#include <IME/common/Rect.h>
+
+namespace centpd {
+    /**
+     * @brief Plays looping SpriteAtlas animations
+     *
+     * The animator only keeps track of which frame is current, it is up to
+     * the owner to apply the frame to its sprite when it changes
+     */
+    class FrameAnimator {
+    public:
+        /**
+         * @brief Constructor
+         * @param actor The actor whose animations are played
+         * @param animation The animation to start with
+         */
+        explicit FrameAnimator(SpriteAtlas::Actor actor, unsigned int animation = SpriteAtlas::Idle);
+
+        /**
+         * @brief Play an animation from its first frame
+         * @param actor The actor the animation belongs to
+         * @param animation The animation to be played
+         * @return True if the current frame changed, otherwise false
+         *
+         * Playing the animation that is already playing has no effect
+         */
+        bool play(SpriteAtlas::Actor actor, unsigned int animation);
+
+        /**
+         * @brief Advance the current animation
+         * @param deltaTime Time passed since the last update in seconds
+         * @return True if the current frame changed, otherwise false
+         */
+        bool update(float deltaTime);
+
+        /**
+         * @brief Get the texture rect of the current frame
+         * @return The texture rect of the current frame
+         */
+        ime::UIntRect getFrame() const;
+
+    private:
+        SpriteAtlas::Actor m_actor; //!< Actor whose animations are played
+        unsigned int m_animation;   //!< Animation being played
+        unsigned int m_frame;       //!< Current frame of the animation
+        float m_elapsed;            //!< Time the current frame has been shown for
+    };
+}
+
+#endif //CENTIPEDE_FRAMEANIMATOR_H
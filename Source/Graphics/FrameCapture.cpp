@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/FrameCapture.h"
+#include "Source/Graphics/Png.h"
+#include "Source/Diagnostics/AllocationCounter.h"
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace centpd {
+    namespace {
+        const std::uint32_t GRID_COLOUR = 0xFFFFFF30;
+
+        ///////////////////////////////////////////////////////////////
+        void savePam(const Image& image, const std::string& filename) {
+            std::ofstream file(filename, std::ios::binary);
+            file << "P7\nWIDTH " << image.getWidth() << "\nHEIGHT " << image.getHeight()
+                 << "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n";
+            file.write(reinterpret_cast<const char*>(image.getPixels().data()), static_cast<std::streamsize>(image.getPixels().size()));
+
+            if (!file)
+                throw std::runtime_error("Cannot write frame: " + filename);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    FrameCapture::FrameCapture(Image spritesheet, unsigned int width, unsigned int height, const std::string &outputDir) :
+        m_rasterizer{std::move(spritesheet)},
+        m_frame{width, height},
+        m_outputDir{outputDir},
+        m_interval{1},
+        m_format{Format::Png},
+        m_isWriting{false},
+        m_isStopped{false}
+    {
+        std::filesystem::create_directories(m_outputDir);
+        m_writer = std::thread(&FrameCapture::writeFrames, this);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::setInterval(unsigned int interval) {
+        assert(interval > 0 && "The capture interval must be greater than zero");
+        m_interval = interval;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::setFormat(FrameCapture::Format format) {
+        m_format = format;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool FrameCapture::isDue(std::uint64_t tick) const {
+        return tick % m_interval == 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::beginFrame(std::uint32_t rgba) {
+        m_frame.fill(rgba);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::drawLayer(const std::vector<SpriteQuad> &quads) {
+        m_rasterizer.draw(m_frame, quads);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::drawGrid(unsigned int rows, unsigned int cols, unsigned int tileSize) {
+        SoftwareRasterizer::drawGrid(m_frame, rows, cols, tileSize, GRID_COLOUR);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::endFrame(std::uint64_t tick) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queueChanged.wait(lock, [this] { return m_queue.size() < MAX_QUEUED_FRAMES; });
+        m_queue.push_back(QueuedFrame{tick, m_format, m_frame});
+        m_queueChanged.notify_all();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::flush() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_queueChanged.wait(lock, [this] { return m_queue.empty() && !m_isWriting; });
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void FrameCapture::writeFrames() {
+        // Encoding runs behind the game, it must not show up in the allocation counts of the frames
+        AllocationCounter::setThreadExcluded(true);
+
+        while (true) {
+            QueuedFrame frame;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_queueChanged.wait(lock, [this] { return !m_queue.empty() || m_isStopped; });
+                if (m_queue.empty())
+                    return;
+
+                frame = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_isWriting = true;
+                m_queueChanged.notify_all();
+            }
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "frame_%08llu", static_cast<unsigned long long>(frame.tick));
+            std::string filename = (std::filesystem::path(m_outputDir) / name).string();
+
+            try {
+                if (frame.format == Format::Png)
+                    Png::save(frame.image, filename + ".png");
+                else
+                    savePam(frame.image, filename + ".pam");
+            } catch (const std::exception&) {
+                // A failed write must not take down the game, the frame is skipped
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isWriting = false;
+            m_queueChanged.notify_all();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    FrameCapture::~FrameCapture() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopped = true;
+            m_queueChanged.notify_all();
+        }
+
+        m_writer.join();
+    }
+}
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_FRAMECAPTURE_H
+#define CENTIPEDE_FRAMECAPTURE_H
+
+#include "Source/Graphics/SoftwareRasterizer.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace centpd {
+    /**
+     * @brief Captures simulation frames to the disk without a graphics context
+     *
+     * Frames are drawn with a SoftwareRasterizer and written by a background
+     * thread, so the simulation only pays for rasterizing the frame, not for
+     * encoding it or for disk I/O. If the writer falls behind, capturing blocks
+     * until there is room in the queue (see endFrame), no frame is ever dropped
+     *
+     * A frame is written as "frame_<tick>.png" or "frame_<tick>.pam", where
+     * tick is zero padded to eight digits so that files sort in tick order
+     */
+    class FrameCapture {
+    public:
+        static constexpr std::size_t MAX_QUEUED_FRAMES = 8; //!< The number of frames that may wait to be written
+
+        /**
+         * @brief Captured frame file format
+         */
+        enum class Format {
+            Png, //!< Uncompressed PNG
+            Raw  //!< Raw RGBA pixels with a PAM (Netpbm) header
+        };
+
+        /**
+         * @brief Constructor
+         * @param spritesheet The texture shared by the actors
+         * @param width The width of the captured frames in pixels
+         * @param height The height of the captured frames in pixels
+         * @param outputDir The directory to write frames to
+         *
+         * @a outputDir is created if it does not exist
+         */
+        FrameCapture(Image spritesheet, unsigned int width, unsigned int height, const std::string& outputDir);
+
+        /**
+         * @brief Set how often frames are captured
+         * @param interval The number of ticks between captures
+         *
+         * By default, every tick is captured
+         */
+        void setInterval(unsigned int interval);
+
+        /**
+         * @brief Set the file format of captured frames
+         * @param format The new format
+         *
+         * The format applies to the frames ended after the call, frames
+         * that are already queued keep their format. By default, the
+         * format is Format::Png
+         */
+        void setFormat(Format format);
+
+        /**
+         * @brief Check if a tick should be captured
+         * @param tick The tick to be checked
+         * @return True if the tick should be captured, otherwise false
+         */
+        bool isDue(std::uint64_t tick) const;
+
+        /**
+         * @brief Start a new frame
+         * @param rgba The colour to clear the frame with (0xRRGGBBAA)
+         */
+        void beginFrame(std::uint32_t rgba = 0x000000FF);
+
+        /**
+         * @brief Draw a layer of quads on the current frame
+         * @param quads The quads to be drawn
+         */
+        void drawLayer(const std::vector<SpriteQuad>& quads);
+
+        /**
+         * @brief Draw grid lines on the current frame
+         * @param rows The number of rows in the grid
+         * @param cols The number of columns in the grid
+         * @param tileSize The size of a cell in pixels
+         */
+        void drawGrid(unsigned int rows, unsigned int cols, unsigned int tileSize);
+
+        /**
+         * @brief Finish the current frame and queue it for writing
+         * @param tick The tick the frame was captured on
+         *
+         * This function blocks the calling thread (the game thread) while
+         * MAX_QUEUED_FRAMES frames are waiting to be written. A game that
+         * captures faster than frames can be encoded and written is slowed
+         * down to the speed of the writer
+         */
+        void endFrame(std::uint64_t tick);
+
+        /**
+         * @brief Wait until all queued frames are written to the disk
+         */
+        void flush();
+
+        /**
+         * @brief Destructor
+         *
+         * Frames that are still queued are written before the capture is destroyed
+         */
+        ~FrameCapture();
+
+    private:
+        /**
+         * @brief A frame waiting to be written
+         */
+        struct QueuedFrame {
+            std::uint64_t tick; //!< The tick the frame was captured on
+            Format format;      //!< The format the frame is written in
+            Image image;        //!< The pixels of the frame
+        };
+
+        /**
+         * @brief Write queued frames until the capture is destroyed
+         */
+        void writeFrames();
+
+    private:
+        SoftwareRasterizer m_rasterizer;                     //!< Draws frames on the CPU
+        Image m_frame;                                       //!< The frame being drawn
+        std::string m_outputDir;                             //!< Where frames are written
+        unsigned int m_interval;                             //!< Number of ticks between captures
+        Format m_format;                                     //!< Captured frames file format
+        std::deque<QueuedFrame> m_queue;                     //!< Frames waiting to be written
+        std::mutex m_mutex;                                  //!< Guards the queue
+        std::condition_variable m_queueChanged;              //!< Signalled when a frame is queued or written
+        bool m_isWriting;                                    //!< A flag indicating whether or not the writer is busy with a frame
+        bool m_isStopped;                                    //!< A flag indicating whether or not the writer should exit
+        std::thread m_writer;                                //!< Writes frames to the disk
+    };
+}
+
+#endif //CENTIPEDE_FRAMECAPTURE_H
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/Image.h"
+#include <cassert>
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    Image::Image() :
+        m_width{0},
+        m_height{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    Image::Image(unsigned int width, unsigned int height, std::uint32_t rgba) :
+        m_width{width},
+        m_height{height},
+        m_pixels(static_cast<std::size_t>(width) * height * 4)
+    {
+        fill(rgba);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void Image::fill(std::uint32_t rgba) {
+        const std::uint8_t colour[4] = {
+            static_cast<std::uint8_t>(rgba >> 24),
+            static_cast<std::uint8_t>(rgba >> 16),
+            static_cast<std::uint8_t>(rgba >> 8),
+            static_cast<std::uint8_t>(rgba)
+        };
+
+        for (std::size_t i = 0; i < m_pixels.size(); i += 4) {
+            m_pixels[i] = colour[0];
+            m_pixels[i + 1] = colour[1];
+            m_pixels[i + 2] = colour[2];
+            m_pixels[i + 3] = colour[3];
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int Image::getWidth() const {
+        return m_width;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int Image::getHeight() const {
+        return m_height;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint8_t *Image::getPixel(unsigned int x, unsigned int y) {
+        assert(x < m_width && y < m_height && "Pixel out of bounds");
+        return &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::uint8_t *Image::getPixel(unsigned int x, unsigned int y) const {
+        assert(x < m_width && y < m_height && "Pixel out of bounds");
+        return &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::vector<std::uint8_t> &Image::getPixels() {
+        return m_pixels;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<std::uint8_t> &Image::getPixels() const {
+        return m_pixels;
+    }
+}
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_IMAGE_H
+#define CENTIPEDE_IMAGE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief An RGBA image stored in CPU memory
+     *
+     * Pixels are stored row by row, four bytes per pixel in the order
+     * red, green, blue and alpha
+     */
+    class Image {
+    public:
+        /**
+         * @brief Create an empty image
+         */
+        Image();
+
+        /**
+         * @brief Create an image filled with a colour
+         * @param width The width of the image in pixels
+         * @param height The height of the image in pixels
+         * @param rgba The colour to fill the image with (0xRRGGBBAA)
+         */
+        Image(unsigned int width, unsigned int height, std::uint32_t rgba = 0x000000FF);
+
+        /**
+         * @brief Fill the whole image with a colour
+         * @param rgba The colour to fill the image with (0xRRGGBBAA)
+         */
+        void fill(std::uint32_t rgba);
+
+        /**
+         * @brief Get the width of the image
+         * @return The width of the image in pixels
+         */
+        unsigned int getWidth() const;
+
+        /**
+         * @brief Get the height of the image
+         * @return The height of the image in pixels
+         */
+        unsigned int getHeight() const;
+
+        /**
+         * @brief Get a pointer to the first byte of a pixel
+         * @param x The horizontal position of the pixel
+         * @param y The vertical position of the pixel
+         * @return A pointer to the red component of the pixel
+         */
+        std::uint8_t* getPixel(unsigned int x, unsigned int y);
+        const std::uint8_t* getPixel(unsigned int x, unsigned int y) const;
+
+        /**
+         * @brief Get the pixels of the image
+         * @return The pixels of the image
+         */
+        std::vector<std::uint8_t>& getPixels();
+        const std::vector<std::uint8_t>& getPixels() const;
+
+    private:
+        unsigned int m_width;               //!< The width of the image in pixels
+        unsigned int m_height;              //!< The height of the image in pixels
+        std::vector<std::uint8_t> m_pixels; //!< RGBA pixels, row by row
+    };
+}
+
+#endif //CENTIPEDE_IMAGE_H
@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/MushroomBatch.h"
+#include "Source/Graphics/SpriteBatch.h"
+#include "Source/Graphics/SpriteAtlas.h"
+#include <IME/graphics/RenderTarget.h>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+
+namespace centpd {
+    namespace {
+        const std::size_t VERTICES_PER_QUAD = 4;
+        const std::size_t QUADS_PER_CHUNK = MushroomField::CHUNK_SIZE * MushroomField::CHUNK_SIZE;
+        const std::size_t NO_QUADS = ~std::size_t{0};
+
+        // Not a valid tile byte, forces a tile to be built on the next update
+        const std::uint8_t UNBUILT = 0xFF;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MushroomBatch::MushroomBatch(const sf::Texture &texture, unsigned int tileSize) :
+        m_texture{texture},
+        m_tileSize{tileSize},
+        m_rows{0},
+        m_cols{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomBatch::update(const MushroomField &field) {
+        if (field.getRows() != m_rows || field.getCols() != m_cols) {
+            m_rows = field.getRows();
+            m_cols = field.getCols();
+            m_chunkVersions.assign(field.getChunkRows() * field.getChunkCols(), 0);
+            m_chunkQuads.assign(m_chunkVersions.size(), NO_QUADS);
+            m_tiles.clear();
+            m_quads.clear();
+            m_vertices.clear();
+        }
+
+        // Chunks the field never allocated have version 0 and are skipped without being given quads
+        const unsigned int chunkSize = MushroomField::CHUNK_SIZE;
+        for (unsigned int chunkRow = 0; chunkRow < field.getChunkRows(); chunkRow++) {
+            for (unsigned int chunkCol = 0; chunkCol < field.getChunkCols(); chunkCol++) {
+                const std::size_t chunk = chunkRow * field.getChunkCols() + chunkCol;
+                const std::uint64_t version = field.getChunkVersion(chunkRow, chunkCol);
+                if (version == m_chunkVersions[chunk])
+                    continue;
+
+                m_chunkVersions[chunk] = version;
+                const std::size_t first = getChunkQuads(chunk);
+                const unsigned int lastRow = std::min((chunkRow + 1) * chunkSize, m_rows);
+                const unsigned int lastCol = std::min((chunkCol + 1) * chunkSize, m_cols);
+                for (unsigned int row = chunkRow * chunkSize; row < lastRow; row++) {
+                    for (unsigned int col = chunkCol * chunkSize; col < lastCol; col++) {
+                        const std::size_t index = first + (row % chunkSize) * chunkSize + col % chunkSize;
+                        updateTile(index, row, col, field.getTile(static_cast<int>(row), static_cast<int>(col)));
+                    }
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t MushroomBatch::getChunkQuads(std::size_t chunk) {
+        // Tiles of the chunk that are outside the grid keep an invisible quad
+        if (m_chunkQuads[chunk] == NO_QUADS) {
+            m_chunkQuads[chunk] = m_quads.size();
+            m_tiles.resize(m_tiles.size() + QUADS_PER_CHUNK, UNBUILT);
+            m_quads.resize(m_quads.size() + QUADS_PER_CHUNK);
+            m_vertices.resize(m_vertices.size() + QUADS_PER_CHUNK * VERTICES_PER_QUAD);
+        }
+
+        return m_chunkQuads[chunk];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomBatch::updateTile(std::size_t index, unsigned int row, unsigned int col, std::uint8_t tile) {
+        if (tile == m_tiles[index])
+            return;
+
+        m_tiles[index] = tile;
+
+        const auto tileSize = static_cast<float>(m_tileSize);
+        SpriteQuad& quad = m_quads[index];
+        quad.x = (static_cast<float>(col) + 0.5f) * tileSize;
+        quad.y = (static_cast<float>(row) + 0.5f) * tileSize;
+        quad.visible = tile & MushroomField::PRESENT;
+
+        if (quad.visible) {
+            auto animation = (tile & MushroomField::POISONED) ? SpriteAtlas::Poisoned : SpriteAtlas::Healthy;
+            const TextureRect& frame = SpriteAtlas::getFrame(SpriteAtlas::Actor::Mushroom, animation, tile & MushroomField::HITS);
+            quad.scaleX = quad.scaleY = 2.0f;
+            quad.originX = static_cast<float>(frame.width) / 2.0f;
+            quad.originY = static_cast<float>(frame.height) / 2.0f;
+            quad.left = frame.left;
+            quad.top = frame.top;
+            quad.width = frame.width;
+            quad.height = frame.height;
+        }
+
+        SpriteBatch::buildVertices(quad, &m_vertices[index * VERTICES_PER_QUAD]);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<SpriteQuad> &MushroomBatch::getQuads() const {
+        return m_quads;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomBatch::draw(ime::priv::RenderTarget &renderTarget) const {
+        if (m_vertices.empty())
+            return;
+
+        sf::RenderStates states;
+        states.texture = &m_texture;
+        renderTarget.getThirdPartyWindow().draw(m_vertices.data(), m_vertices.size(), sf::Quads, states);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::string MushroomBatch::getClassName() const {
+        return "MushroomBatch";
+    }
+}
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_MUSHROOMBATCH_H
+#define CENTIPEDE_MUSHROOMBATCH_H
+
+#include "Source/Graphics/SpriteQuad.h"
+#include "Source/Simulation/MushroomField.h"
+#include <IME/graphics/Drawable.h>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+#include <string>
+
+namespace centpd {
+    /**
+     * @brief Draws the mushrooms of a MushroomField with a single draw call
+     *
+     * Unlike SpriteBatch, the batch does not draw game objects, it reads
+     * the tile data of the field directly. Quads are kept per chunk of the
+     * field: a chunk gets a quad for each of its tiles when the field
+     * allocates it, so the memory of the batch grows with the area that
+     * has mushrooms, not with the size of the grid. Only the chunks whose
+     * version changed since the last update are visited, and the quad of
+     * a tile is only rebuilt when the byte of the tile changes
+     */
+    class MushroomBatch : public ime::Drawable {
+    public:
+        /**
+         * @brief Constructor
+         * @param texture The texture that contains the mushroom frames
+         * @param tileSize The size of a tile in pixels
+         *
+         * The texture must outlive the batch
+         */
+        MushroomBatch(const sf::Texture& texture, unsigned int tileSize);
+
+        /**
+         * @brief Rebuild the quads of the tiles that changed since the last update
+         * @param field The mushrooms to be drawn
+         *
+         * This function must be called once per frame, before the batch is drawn
+         */
+        void update(const MushroomField& field);
+
+        /**
+         * @brief Get the quads of the tiles
+         * @return The quads as of the last update, chunk by chunk
+         *
+         * Tiles without a mushroom have an invisible quad
+         */
+        const std::vector<SpriteQuad>& getQuads() const;
+
+        /**
+         * @brief Draw the batch
+         * @param renderTarget The target to draw the batch on
+         */
+        void draw(ime::priv::RenderTarget& renderTarget) const override;
+
+        /**
+         * @brief Get the name of this class in string format
+         * @return The name of this class
+         */
+        std::string getClassName() const override;
+
+    private:
+        /**
+         * @brief Get the quads of a chunk, creating them if needed
+         * @param chunk The index of the chunk in the field, row by row
+         * @return The index of the first quad of the chunk
+         */
+        std::size_t getChunkQuads(std::size_t chunk);
+
+        /**
+         * @brief Rebuild the quad of a tile if its byte changed
+         * @param index The index of the quad of the tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @param tile The current byte of the tile
+         */
+        void updateTile(std::size_t index, unsigned int row, unsigned int col, std::uint8_t tile);
+
+    private:
+        const sf::Texture& m_texture;               //!< Texture containing the mushroom frames
+        unsigned int m_tileSize;                    //!< The size of a tile in pixels
+        unsigned int m_rows;                        //!< The number of rows in the drawn field
+        unsigned int m_cols;                        //!< The number of columns in the drawn field
+        std::vector<std::uint64_t> m_chunkVersions; //!< The version of each chunk of the field as of the last update
+        std::vector<std::size_t> m_chunkQuads;      //!< The index of the first quad of each chunk, or NO_QUADS
+        std::vector<std::uint8_t> m_tiles;          //!< The byte each tiles quad was built from, chunk by chunk
+        std::vector<SpriteQuad> m_quads;            //!< The quad of each tile of the chunks with quads
+        std::vector<sf::Vertex> m_vertices;         //!< Four vertices per quad
+    };
+}
+
+#endif //CENTIPEDE_MUSHROOMBATCH_H
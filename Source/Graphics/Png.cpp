@@ -0,0 +1,548 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/Png.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace centpd {
+    namespace {
+        const std::array<std::uint8_t, 8> SIGNATURE = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        const std::size_t MAX_STORED_BLOCK_SIZE = 65535;
+
+        ///////////////////////////////////////////////////////////////
+        // Deflate decompression (RFC 1951)
+        ///////////////////////////////////////////////////////////////
+        struct Huffman {
+            std::array<std::uint16_t, 16> counts{};  // Number of codes of each length
+            std::array<std::uint16_t, 288> symbols{}; // Symbols ordered by code
+        };
+
+        class Inflater {
+        public:
+            Inflater(const std::uint8_t* data, std::size_t size, std::vector<std::uint8_t>& output) :
+                m_data{data},
+                m_size{size},
+                m_pos{0},
+                m_bitBuffer{0},
+                m_bitCount{0},
+                m_output{output}
+            {}
+
+            void inflate() {
+                bool isLastBlock;
+                do {
+                    isLastBlock = bits(1) == 1;
+                    switch (bits(2)) {
+                        case 0: stored(); break;
+                        case 1: fixed(); break;
+                        case 2: dynamic(); break;
+                        default: throw std::runtime_error("Invalid deflate block type");
+                    }
+                } while (!isLastBlock);
+            }
+
+            std::size_t getPosition() const {
+                // The last block ends within the byte at m_pos - 1, its unused bits are padding
+                return m_pos;
+            }
+
+        private:
+            unsigned int bits(int count) {
+                std::uint32_t value = m_bitBuffer;
+                while (m_bitCount < count) {
+                    if (m_pos == m_size)
+                        throw std::runtime_error("Unexpected end of deflate stream");
+
+                    value |= static_cast<std::uint32_t>(m_data[m_pos++]) << m_bitCount;
+                    m_bitCount += 8;
+                }
+
+                m_bitBuffer = value >> count;
+                m_bitCount -= count;
+                return value & ((1u << count) - 1u);
+            }
+
+            void stored() {
+                m_bitBuffer = 0;
+                m_bitCount = 0;
+
+                if (m_pos + 4 > m_size)
+                    throw std::runtime_error("Unexpected end of deflate stream");
+
+                unsigned int length = m_data[m_pos] | (m_data[m_pos + 1] << 8);
+                m_pos += 4; // Skip the length and its ones complement
+
+                if (m_pos + length > m_size)
+                    throw std::runtime_error("Unexpected end of deflate stream");
+
+                m_output.insert(m_output.end(), m_data + m_pos, m_data + m_pos + length);
+                m_pos += length;
+            }
+
+            static void build(Huffman& huffman, const std::uint8_t* lengths, int numSymbols) {
+                huffman.counts.fill(0);
+                for (int symbol = 0; symbol < numSymbols; symbol++)
+                    huffman.counts[lengths[symbol]]++;
+
+                std::array<std::uint16_t, 16> offsets{};
+                for (int length = 1; length < 15; length++)
+                    offsets[length + 1] = offsets[length] + huffman.counts[length];
+
+                for (int symbol = 0; symbol < numSymbols; symbol++) {
+                    if (lengths[symbol] != 0)
+                        huffman.symbols[offsets[lengths[symbol]]++] = static_cast<std::uint16_t>(symbol);
+                }
+            }
+
+            int decode(const Huffman& huffman) {
+                int code = 0, first = 0, index = 0;
+                for (int length = 1; length < 16; length++) {
+                    code |= static_cast<int>(bits(1));
+                    int count = huffman.counts[length];
+                    if (code - count < first)
+                        return huffman.symbols[index + (code - first)];
+
+                    index += count;
+                    first = (first + count) << 1;
+                    code <<= 1;
+                }
+
+                throw std::runtime_error("Invalid Huffman code in deflate stream");
+            }
+
+            void codes(const Huffman& lengthCodes, const Huffman& distCodes) {
+                static const std::uint16_t lengthBase[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+                static const std::uint8_t lengthExtra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+                static const std::uint16_t distBase[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+                static const std::uint8_t distExtra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+                while (true) {
+                    int symbol = decode(lengthCodes);
+                    if (symbol < 256)
+                        m_output.push_back(static_cast<std::uint8_t>(symbol));
+                    else if (symbol == 256)
+                        return;
+                    else {
+                        symbol -= 257;
+                        if (symbol >= 29)
+                            throw std::runtime_error("Invalid length code in deflate stream");
+
+                        std::size_t length = lengthBase[symbol] + bits(lengthExtra[symbol]);
+                        int distSymbol = decode(distCodes);
+                        if (distSymbol >= 30)
+                            throw std::runtime_error("Invalid distance code in deflate stream");
+
+                        std::size_t distance = distBase[distSymbol] + bits(distExtra[distSymbol]);
+                        if (distance > m_output.size())
+                            throw std::runtime_error("Deflate distance too far back");
+
+                        // The source and destination may overlap, so copy byte by byte
+                        std::size_t from = m_output.size() - distance;
+                        for (std::size_t i = 0; i < length; i++)
+                            m_output.push_back(m_output[from + i]);
+                    }
+                }
+            }
+
+            void fixed() {
+                static Huffman lengthCodes, distCodes;
+                static bool isBuilt = false;
+                if (!isBuilt) {
+                    std::array<std::uint8_t, 288> lengths{};
+                    for (int symbol = 0; symbol < 288; symbol++)
+                        lengths[symbol] = symbol < 144 ? 8 : (symbol < 256 ? 9 : (symbol < 280 ? 7 : 8));
+                    build(lengthCodes, lengths.data(), 288);
+
+                    lengths.fill(5);
+                    build(distCodes, lengths.data(), 30);
+                    isBuilt = true;
+                }
+
+                codes(lengthCodes, distCodes);
+            }
+
+            void dynamic() {
+                static const std::uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+                int numLengths = static_cast<int>(bits(5)) + 257;
+                int numDists = static_cast<int>(bits(5)) + 1;
+                int numCodes = static_cast<int>(bits(4)) + 4;
+                if (numLengths > 286 || numDists > 30)
+                    throw std::runtime_error("Invalid dynamic block header in deflate stream");
+
+                std::array<std::uint8_t, 320> lengths{};
+                for (int i = 0; i < numCodes; i++)
+                    lengths[order[i]] = static_cast<std::uint8_t>(bits(3));
+
+                Huffman codeLengthCodes;
+                build(codeLengthCodes, lengths.data(), 19);
+
+                int index = 0;
+                lengths.fill(0);
+                while (index < numLengths + numDists) {
+                    int symbol = decode(codeLengthCodes);
+                    if (symbol < 16) {
+                        lengths[index++] = static_cast<std::uint8_t>(symbol);
+                        continue;
+                    }
+
+                    std::uint8_t repeated = 0;
+                    unsigned int repeat;
+                    if (symbol == 16) {
+                        if (index == 0)
+                            throw std::runtime_error("Invalid code length repeat in deflate stream");
+                        repeated = lengths[index - 1];
+                        repeat = 3 + bits(2);
+                    } else if (symbol == 17)
+                        repeat = 3 + bits(3);
+                    else
+                        repeat = 11 + bits(7);
+
+                    if (index + static_cast<int>(repeat) > numLengths + numDists)
+                        throw std::runtime_error("Too many code lengths in deflate stream");
+
+                    while (repeat-- > 0)
+                        lengths[index++] = repeated;
+                }
+
+                Huffman lengthCodes, distCodes;
+                build(lengthCodes, lengths.data(), numLengths);
+                build(distCodes, lengths.data() + numLengths, numDists);
+                codes(lengthCodes, distCodes);
+            }
+
+        private:
+            const std::uint8_t* m_data;
+            std::size_t m_size;
+            std::size_t m_pos;
+            std::uint32_t m_bitBuffer;
+            int m_bitCount;
+            std::vector<std::uint8_t>& m_output;
+        };
+
+        ///////////////////////////////////////////////////////////////
+        // Checksums
+        ///////////////////////////////////////////////////////////////
+        std::uint32_t crc32(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+            static const auto table = [] {
+                std::array<std::uint32_t, 256> entries{};
+                for (std::uint32_t n = 0; n < 256; n++) {
+                    std::uint32_t c = n;
+                    for (int k = 0; k < 8; k++)
+                        c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    entries[n] = c;
+                }
+                return entries;
+            }();
+
+            crc = ~crc;
+            for (std::size_t i = 0; i < size; i++)
+                crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        std::uint32_t adler32(const std::uint8_t* data, std::size_t size, std::uint32_t adler) {
+            std::uint32_t a = adler & 0xFFFFu, b = adler >> 16;
+            while (size > 0) {
+                // 5552 is the largest run that cannot overflow before the modulo
+                std::size_t run = size < 5552 ? size : 5552;
+                size -= run;
+                while (run-- > 0) {
+                    a += *data++;
+                    b += a;
+                }
+                a %= 65521u;
+                b %= 65521u;
+            }
+
+            return (b << 16) | a;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::uint32_t readU32(const std::uint8_t* data) {
+            return (static_cast<std::uint32_t>(data[0]) << 24) | (static_cast<std::uint32_t>(data[1]) << 16)
+                | (static_cast<std::uint32_t>(data[2]) << 8) | static_cast<std::uint32_t>(data[3]);
+        }
+
+        void writeU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            out.push_back(static_cast<std::uint8_t>(value >> 24));
+            out.push_back(static_cast<std::uint8_t>(value >> 16));
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        void writeChunk(std::vector<std::uint8_t>& out, const char* type, const std::uint8_t* data, std::size_t size) {
+            writeU32(out, static_cast<std::uint32_t>(size));
+            std::size_t crcStart = out.size();
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), data, data + size);
+            writeU32(out, crc32(&out[crcStart], size + 4));
+        }
+
+        ///////////////////////////////////////////////////////////////
+        bool isSupportedBitDepth(unsigned int colourType, unsigned int bitDepth) {
+            switch (colourType) {
+                case 0: // Greyscale
+                case 3: // Palette
+                    return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+                case 2: // RGB
+                case 4: // Greyscale with alpha
+                case 6: // RGBA
+                    return bitDepth == 8;
+                default:
+                    return false;
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////
+        int paeth(int a, int b, int c) {
+            int p = a + b - c;
+            int pa = p > a ? p - a : a - p;
+            int pb = p > b ? p - b : b - p;
+            int pc = p > c ? p - c : c - p;
+            return (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Image Png::load(const std::string &filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("Cannot open PNG file: " + filename);
+
+        std::vector<std::uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        return decode(data);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Image Png::decode(const std::vector<std::uint8_t> &data) {
+        if (data.size() < SIGNATURE.size() || !std::equal(SIGNATURE.begin(), SIGNATURE.end(), data.begin()))
+            throw std::runtime_error("Not a PNG file");
+
+        unsigned int width = 0, height = 0, bitDepth = 0, colourType = 0;
+        bool hasHeader = false, hasEnd = false;
+        std::vector<std::uint8_t> palette, transparency, compressed;
+
+        std::size_t pos = SIGNATURE.size();
+        while (!hasEnd && pos + 12 <= data.size()) {
+            const std::size_t length = readU32(&data[pos]);
+            std::string type(reinterpret_cast<const char*>(&data[pos + 4]), 4);
+            const std::uint8_t* chunk = &data[pos + 8];
+            if (length > data.size() - pos - 12)
+                throw std::runtime_error("Truncated PNG chunk");
+
+            // The CRC covers the type and the data of the chunk
+            if (readU32(chunk + length) != crc32(&data[pos + 4], length + 4))
+                throw std::runtime_error("PNG chunk " + type + " is corrupt (CRC mismatch)");
+
+            if (type == "IHDR") {
+                if (hasHeader || length != 13)
+                    throw std::runtime_error("Invalid PNG header");
+
+                width = readU32(chunk);
+                height = readU32(chunk + 4);
+                bitDepth = chunk[8];
+                colourType = chunk[9];
+                if (chunk[10] != 0 || chunk[11] != 0)
+                    throw std::runtime_error("Unknown PNG compression or filter method");
+                if (chunk[12] != 0)
+                    throw std::runtime_error("Interlaced PNG files are not supported");
+
+                hasHeader = true;
+            } else if (!hasHeader)
+                throw std::runtime_error("PNG file does not start with a header");
+            else if (type == "PLTE")
+                palette.assign(chunk, chunk + length);
+            else if (type == "tRNS")
+                transparency.assign(chunk, chunk + length);
+            else if (type == "IDAT")
+                compressed.insert(compressed.end(), chunk, chunk + length);
+            else if (type == "IEND")
+                hasEnd = true;
+
+            pos += 12 + length;
+        }
+
+        if (!hasEnd)
+            throw std::runtime_error("Truncated PNG file");
+
+        static const unsigned int channelsPerType[] = {1, 0, 3, 1, 2, 0, 4};
+        if (width == 0 || height == 0 || !isSupportedBitDepth(colourType, bitDepth))
+            throw std::runtime_error("Unsupported PNG format");
+
+        // zlib header (RFC 1950): deflate with a window of at most 32K, no preset dictionary
+        if (compressed.size() < 6)
+            throw std::runtime_error("PNG file has no image data");
+
+        const unsigned int method = compressed[0], flags = compressed[1];
+        if ((method & 0x0Fu) != 8 || (method >> 4) > 7 || (method * 256 + flags) % 31 != 0 || (flags & 0x20u) != 0)
+            throw std::runtime_error("Invalid zlib header in PNG image data");
+
+        std::vector<std::uint8_t> raw;
+        const std::size_t bitsPerPixel = channelsPerType[colourType] * bitDepth;
+        const std::size_t stride = (width * bitsPerPixel + 7) / 8;
+        raw.reserve((stride + 1) * height);
+        Inflater inflater(compressed.data() + 2, compressed.size() - 2, raw);
+        inflater.inflate();
+
+        const std::size_t adlerPos = 2 + inflater.getPosition();
+        if (adlerPos + 4 > compressed.size() || readU32(&compressed[adlerPos]) != adler32(raw.data(), raw.size(), 1))
+            throw std::runtime_error("PNG image data is corrupt (Adler-32 mismatch)");
+
+        if (raw.size() < (stride + 1) * height)
+            throw std::runtime_error("PNG image data is too short");
+
+        // Undo the scanline filters in place
+        const std::size_t bytesPerPixel = bitsPerPixel < 8 ? 1 : bitsPerPixel / 8;
+        for (std::size_t y = 0; y < height; y++) {
+            std::uint8_t* line = &raw[y * (stride + 1) + 1];
+            const std::uint8_t* prevLine = y > 0 ? &raw[(y - 1) * (stride + 1) + 1] : nullptr;
+            std::uint8_t filter = line[-1];
+
+            for (std::size_t i = 0; i < stride; i++) {
+                int left = i >= bytesPerPixel ? line[i - bytesPerPixel] : 0;
+                int up = prevLine ? prevLine[i] : 0;
+                int upLeft = (prevLine && i >= bytesPerPixel) ? prevLine[i - bytesPerPixel] : 0;
+
+                switch (filter) {
+                    case 0: break;
+                    case 1: line[i] = static_cast<std::uint8_t>(line[i] + left); break;
+                    case 2: line[i] = static_cast<std::uint8_t>(line[i] + up); break;
+                    case 3: line[i] = static_cast<std::uint8_t>(line[i] + ((left + up) >> 1)); break;
+                    case 4: line[i] = static_cast<std::uint8_t>(line[i] + paeth(left, up, upLeft)); break;
+                    default: throw std::runtime_error("Invalid PNG scanline filter");
+                }
+            }
+        }
+
+        // Expand to RGBA
+        Image image(width, height);
+        const unsigned int maxSample = (1u << bitDepth) - 1u;
+        for (unsigned int y = 0; y < height; y++) {
+            const std::uint8_t* line = &raw[y * (stride + 1) + 1];
+            for (unsigned int x = 0; x < width; x++) {
+                std::uint8_t* pixel = image.getPixel(x, y);
+                auto sample = [&](unsigned int channel) -> unsigned int {
+                    std::size_t bit = (static_cast<std::size_t>(x) * channelsPerType[colourType] + channel) * bitDepth;
+                    return (line[bit / 8] >> (8 - bitDepth - bit % 8)) & maxSample;
+                };
+
+                switch (colourType) {
+                    case 0: { // Greyscale
+                        auto grey = static_cast<std::uint8_t>(sample(0) * 255 / maxSample);
+                        pixel[0] = pixel[1] = pixel[2] = grey;
+                        pixel[3] = (transparency.size() >= 2 && sample(0) == transparency[1]) ? 0 : 255;
+                        break;
+                    }
+                    case 2: // RGB
+                        pixel[0] = line[x * 3];
+                        pixel[1] = line[x * 3 + 1];
+                        pixel[2] = line[x * 3 + 2];
+                        pixel[3] = (transparency.size() >= 6 && pixel[0] == transparency[1]
+                            && pixel[1] == transparency[3] && pixel[2] == transparency[5]) ? 0 : 255;
+                        break;
+                    case 3: { // Palette
+                        unsigned int entry = sample(0);
+                        if (entry * 3 + 2 >= palette.size())
+                            throw std::runtime_error("PNG palette index out of range");
+                        pixel[0] = palette[entry * 3];
+                        pixel[1] = palette[entry * 3 + 1];
+                        pixel[2] = palette[entry * 3 + 2];
+                        pixel[3] = entry < transparency.size() ? transparency[entry] : 255;
+                        break;
+                    }
+                    case 4: // Greyscale with alpha
+                        pixel[0] = pixel[1] = pixel[2] = line[x * 2];
+                        pixel[3] = line[x * 2 + 1];
+                        break;
+                    default: // RGBA
+                        std::copy_n(&line[x * 4], 4, pixel);
+                        break;
+                }
+            }
+        }
+
+        return image;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::vector<std::uint8_t> Png::encode(const Image &image) {
+        const std::size_t stride = static_cast<std::size_t>(image.getWidth()) * 4 + 1;
+
+        // Scanlines prefixed with filter type 0 (none)
+        std::vector<std::uint8_t> raw;
+        raw.reserve(stride * image.getHeight());
+        for (unsigned int y = 0; y < image.getHeight(); y++) {
+            raw.push_back(0);
+            if (image.getWidth() > 0)
+                raw.insert(raw.end(), image.getPixel(0, y), image.getPixel(0, y) + stride - 1);
+        }
+
+        // zlib stream made of stored deflate blocks
+        std::vector<std::uint8_t> zlib;
+        zlib.reserve(raw.size() + raw.size() / MAX_STORED_BLOCK_SIZE * 5 + 16);
+        zlib.push_back(0x78);
+        zlib.push_back(0x01);
+        std::size_t offset = 0;
+        do {
+            std::size_t blockSize = std::min(MAX_STORED_BLOCK_SIZE, raw.size() - offset);
+            bool isLastBlock = offset + blockSize == raw.size();
+            zlib.push_back(isLastBlock ? 1 : 0);
+            zlib.push_back(static_cast<std::uint8_t>(blockSize));
+            zlib.push_back(static_cast<std::uint8_t>(blockSize >> 8));
+            zlib.push_back(static_cast<std::uint8_t>(~blockSize));
+            zlib.push_back(static_cast<std::uint8_t>(~blockSize >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+            offset += blockSize;
+        } while (offset < raw.size());
+        writeU32(zlib, adler32(raw.data(), raw.size(), 1));
+
+        std::vector<std::uint8_t> png(SIGNATURE.begin(), SIGNATURE.end());
+        std::vector<std::uint8_t> header;
+        writeU32(header, image.getWidth());
+        writeU32(header, image.getHeight());
+        header.insert(header.end(), {8, 6, 0, 0, 0}); // 8 bit RGBA, deflate, standard filters, not interlaced
+
+        writeChunk(png, "IHDR", header.data(), header.size());
+        writeChunk(png, "IDAT", zlib.data(), zlib.size());
+        writeChunk(png, "IEND", nullptr, 0);
+        return png;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void Png::save(const Image &image, const std::string &filename) {
+        std::vector<std::uint8_t> png = encode(image);
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size())))
+            throw std::runtime_error("Cannot write PNG file: " + filename);
+    }
+}
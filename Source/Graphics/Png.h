@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_PNG_H
+#define CENTIPEDE_PNG_H
+
+#include "Source/Graphics/Image.h"
+#include <string>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Reads and writes PNG files without a graphics context
+     *
+     * Decoding supports non-interlaced images of all colour types with a
+     * bit depth of 8 (greyscale and palette images may also be 1, 2 or 4
+     * bits), which covers all the textures shipped with the game. The CRC
+     * of every chunk, the zlib header and the Adler-32 checksum of the
+     * image data are verified, a corrupt file is refused. Encoding always
+     * produces 8 bit RGBA images with uncompressed deflate blocks, this
+     * trades file size for speed since captures are written while the game
+     * is running
+     */
+    class Png {
+    public:
+        /**
+         * @brief Decode a PNG file
+         * @param filename The name of the file including the path
+         * @return The decoded image
+         * @throws std::runtime_error If the file cannot be read or decoded
+         */
+        static Image load(const std::string& filename);
+
+        /**
+         * @brief Decode a PNG file that is already in memory
+         * @param data The contents of the file
+         * @return The decoded image
+         * @throws std::runtime_error If the data is not a supported PNG
+         */
+        static Image decode(const std::vector<std::uint8_t>& data);
+
+        /**
+         * @brief Encode an image as a PNG file
+         * @param image The image to be encoded
+         * @return The contents of the PNG file
+         */
+        static std::vector<std::uint8_t> encode(const Image& image);
+
+        /**
+         * @brief Encode an image and write it to the disk
+         * @param image The image to be written
+         * @param filename The name of the file including the path
+         * @throws std::runtime_error If the file cannot be written
+         */
+        static void save(const Image& image, const std::string& filename);
+    };
+}
+
+#endif //CENTIPEDE_PNG_H
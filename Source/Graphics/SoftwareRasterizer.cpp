@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/SoftwareRasterizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace centpd {
+    namespace {
+        ///////////////////////////////////////////////////////////////
+        void blend(std::uint8_t* dst, const std::uint8_t* src) {
+            const unsigned int alpha = src[3];
+            if (alpha == 255) {
+                std::copy_n(src, 4, dst);
+                return;
+            }
+
+            const unsigned int invAlpha = 255 - alpha;
+            for (int i = 0; i < 3; i++)
+                dst[i] = static_cast<std::uint8_t>((src[i] * alpha + dst[i] * invAlpha + 127) / 255);
+            dst[3] = static_cast<std::uint8_t>(alpha + (dst[3] * invAlpha + 127) / 255);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SoftwareRasterizer::SoftwareRasterizer(Image texture) :
+        m_texture{std::move(texture)}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void SoftwareRasterizer::draw(Image &target, const SpriteQuad &quad) const {
+        if (!quad.visible || quad.width == 0 || quad.height == 0 || quad.scaleX == 0.0f || quad.scaleY == 0.0f)
+            return;
+
+        if (quad.left + quad.width > m_texture.getWidth() || quad.top + quad.height > m_texture.getHeight())
+            return;
+
+        // Bounds of the quad in the target, the scale may be negative (flipped)
+        float x0 = quad.x - quad.originX * quad.scaleX;
+        float x1 = quad.x + (static_cast<float>(quad.width) - quad.originX) * quad.scaleX;
+        float y0 = quad.y - quad.originY * quad.scaleY;
+        float y1 = quad.y + (static_cast<float>(quad.height) - quad.originY) * quad.scaleY;
+
+        int minX = std::max(0, static_cast<int>(std::floor(std::min(x0, x1))));
+        int maxX = std::min(static_cast<int>(target.getWidth()), static_cast<int>(std::ceil(std::max(x0, x1))));
+        int minY = std::max(0, static_cast<int>(std::floor(std::min(y0, y1))));
+        int maxY = std::min(static_cast<int>(target.getHeight()), static_cast<int>(std::ceil(std::max(y0, y1))));
+
+        const float invScaleX = 1.0f / quad.scaleX;
+        const float invScaleY = 1.0f / quad.scaleY;
+
+        for (int y = minY; y < maxY; y++) {
+            // Map the centre of the target pixel back into the texture rect
+            float v = (static_cast<float>(y) + 0.5f - quad.y) * invScaleY + quad.originY;
+            if (v < 0.0f || v >= static_cast<float>(quad.height))
+                continue;
+
+            unsigned int srcY = quad.top + static_cast<unsigned int>(v);
+            std::uint8_t* dst = target.getPixel(static_cast<unsigned int>(minX), static_cast<unsigned int>(y));
+
+            for (int x = minX; x < maxX; x++, dst += 4) {
+                float u = (static_cast<float>(x) + 0.5f - quad.x) * invScaleX + quad.originX;
+                if (u < 0.0f || u >= static_cast<float>(quad.width))
+                    continue;
+
+                const std::uint8_t* src = m_texture.getPixel(quad.left + static_cast<unsigned int>(u), srcY);
+                if (src[3] != 0)
+                    blend(dst, src);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SoftwareRasterizer::draw(Image &target, const std::vector<SpriteQuad> &quads) const {
+        for (const auto& quad : quads)
+            draw(target, quad);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SoftwareRasterizer::drawGrid(Image &target, unsigned int rows, unsigned int cols, unsigned int tileSize, std::uint32_t rgba) {
+        const std::uint8_t colour[4] = {
+            static_cast<std::uint8_t>(rgba >> 24),
+            static_cast<std::uint8_t>(rgba >> 16),
+            static_cast<std::uint8_t>(rgba >> 8),
+            static_cast<std::uint8_t>(rgba)
+        };
+
+        const unsigned int width = std::min(target.getWidth(), cols * tileSize);
+        const unsigned int height = std::min(target.getHeight(), rows * tileSize);
+        if (width == 0 || height == 0)
+            return;
+
+        for (unsigned int row = 0; row <= rows; row++) {
+            unsigned int y = std::min(row * tileSize, height - 1);
+            for (unsigned int x = 0; x < width; x++)
+                blend(target.getPixel(x, y), colour);
+        }
+
+        for (unsigned int col = 0; col <= cols; col++) {
+            unsigned int x = std::min(col * tileSize, width - 1);
+            for (unsigned int y = 0; y < height; y++)
+                blend(target.getPixel(x, y), colour);
+        }
+    }
+}
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SOFTWARERASTERIZER_H
+#define CENTIPEDE_SOFTWARERASTERIZER_H
+
+#include "Source/Graphics/Image.h"
+#include "Source/Graphics/SpriteQuad.h"
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Draws sprites into an image on the CPU
+     *
+     * The rasterizer samples the texture with the nearest pixel, which is
+     * what the game uses on the GPU for its pixel art, so frames drawn by
+     * the rasterizer match the rendered ones without needing a window or a
+     * graphics context. Pixels are blended with the alpha of the texture
+     */
+    class SoftwareRasterizer {
+    public:
+        /**
+         * @brief Constructor
+         * @param texture The texture the quads are mapped to
+         */
+        explicit SoftwareRasterizer(Image texture);
+
+        /**
+         * @brief Draw a quad
+         * @param target The image to draw the quad on
+         * @param quad The quad to be drawn
+         *
+         * Parts of the quad that are outside the target are clipped
+         */
+        void draw(Image& target, const SpriteQuad& quad) const;
+
+        /**
+         * @brief Draw multiple quads
+         * @param target The image to draw the quads on
+         * @param quads The quads to be drawn
+         *
+         * Quads are drawn in order, later quads are drawn on top
+         */
+        void draw(Image& target, const std::vector<SpriteQuad>& quads) const;
+
+        /**
+         * @brief Draw the lines of a grid
+         * @param target The image to draw the grid on
+         * @param rows The number of rows in the grid
+         * @param cols The number of columns in the grid
+         * @param tileSize The size of a cell in pixels
+         * @param rgba The colour of the lines (0xRRGGBBAA)
+         */
+        static void drawGrid(Image& target, unsigned int rows, unsigned int cols, unsigned int tileSize, std::uint32_t rgba);
+
+    private:
+        Image m_texture; //!< The texture quads are mapped to
+    };
+}
+
+#endif //CENTIPEDE_SOFTWARERASTERIZER_H
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/SpriteAtlas.h"
+#include <cassert>
+#include <initializer_list>
+#include <utility>
+
+namespace centpd {
+    namespace {
+        /**
+         * @brief A region of the spritesheet divided into equally sized frames
+         *
+         * Spacing is the gap before each frame, so the first frame of a
+         * grid with a spacing of one pixel starts one pixel into the region
+         */
+        struct FrameGrid {
+            unsigned int left;
+            unsigned int top;
+            unsigned int frameWidth;
+            unsigned int frameHeight;
+            unsigned int spacingX = 0;
+            unsigned int spacingY = 0;
+
+            TextureRect getFrame(unsigned int row, unsigned int col) const {
+                return TextureRect{left + spacingX + col * (frameWidth + spacingX),
+                                     top + spacingY + row * (frameHeight + spacingY),
+                                     frameWidth, frameHeight};
+            }
+        };
+
+        using Cell = std::pair<unsigned int, unsigned int>; // Row and column of a frame in a FrameGrid
+
+        const FrameGrid MUSHROOM_GRID{65, 0, 8, 8};
+        const FrameGrid FLEA_GRID{65, 32, 9, 8};
+        const FrameGrid SCORPION_GRID{1, 55, 16, 8};
+        const FrameGrid CENTIPEDE_HOR_GRID{0, 0, 7, 8, 1, 0};
+        const FrameGrid CENTIPEDE_DIAG_GRID{33, 0, 8, 8};
+        const FrameGrid CENTIPEDE_VERT_GRID{49, 1, 8, 7};
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpriteAtlas::build() {
+        if (m_isBuilt)
+            return;
+
+        auto addAnimation = [](Actor actor, unsigned int animation, float duration, const FrameGrid& grid,
+            std::initializer_list<Cell> cells)
+        {
+            Range& range = m_ranges[static_cast<std::size_t>(actor) * MaxAnimations + animation];
+            range.first = static_cast<unsigned int>(m_frames.size());
+            range.count = static_cast<unsigned int>(cells.size());
+            range.frameDuration = duration / static_cast<float>(cells.size());
+
+            for (const auto& [row, col] : cells)
+                m_frames.push_back(grid.getFrame(row, col));
+        };
+
+        // Mushroom damage states, the frame is the number of bullet hits
+        addAnimation(Actor::Mushroom, Healthy, 0.0f, MUSHROOM_GRID, {{0, 0}, {0, 1}, {0, 2}, {0, 3}});
+        addAnimation(Actor::Mushroom, Poisoned, 0.0f, MUSHROOM_GRID, {{1, 0}, {1, 1}, {1, 2}, {1, 3}});
+
+        addAnimation(Actor::Flea, Moving, 0.4f, FLEA_GRID, {{0, 0}, {1, 0}, {2, 0}, {3, 0}});
+        addAnimation(Actor::Scorpion, Moving, 0.4f, SCORPION_GRID, {{0, 0}, {0, 1}, {0, 2}, {0, 3}});
+
+        // On the spritesheet, head frames are in the first two rows and body frames in the last two
+        for (auto [actor, row] : {std::pair{Actor::CentipedeHead, 0u}, std::pair{Actor::CentipedeBody, 2u}}) {
+            addAnimation(actor, Horizontal, 0.2f, CENTIPEDE_HOR_GRID, {{row, 3}, {row + 1, 3}, {row, 2}, {row + 1, 1}, {row, 1}});
+            addAnimation(actor, Vertical, 0.2f, CENTIPEDE_VERT_GRID, {{row + 1, 1}, {row, 1}, {row + 1, 0}});
+            addAnimation(actor, Diagonal, 0.2f, CENTIPEDE_DIAG_GRID, {{row, 0}, {row + 1, 0}});
+        }
+
+        addAnimation(Actor::Player, Idle, 0.0f, FrameGrid{1, 80, 7, 8}, {{0, 0}});
+        addAnimation(Actor::Bullet, Idle, 0.0f, FrameGrid{12, 80, 1, 6}, {{0, 0}});
+
+        m_isBuilt = true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpriteAtlas::isBuilt() {
+        return m_isBuilt;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const TextureRect &SpriteAtlas::getFrame(SpriteAtlas::Actor actor, unsigned int animation, unsigned int frame) {
+        const Range& range = getRange(actor, animation);
+        assert(frame < range.count && "Frame index out of range");
+        return m_frames[range.first + frame];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SpriteAtlas::getFrameCount(SpriteAtlas::Actor actor, unsigned int animation) {
+        return getRange(actor, animation).count;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    float SpriteAtlas::getFrameDuration(SpriteAtlas::Actor actor, unsigned int animation) {
+        return getRange(actor, animation).frameDuration;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const char *SpriteAtlas::getTexture() {
+        return "Spritesheet.png";
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const SpriteAtlas::Range &SpriteAtlas::getRange(SpriteAtlas::Actor actor, unsigned int animation) {
+        assert(m_isBuilt && "The sprite atlas must be built before it is used");
+        assert(animation < MaxAnimations && "Animation out of range");
+        return m_ranges[static_cast<std::size_t>(actor) * MaxAnimations + animation];
+    }
+}
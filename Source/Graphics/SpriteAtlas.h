@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPRITEATLAS_H
+#define CENTIPEDE_SPRITEATLAS_H
+
+#include <array>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief A rectangle of a texture in pixels
+     */
+    struct TextureRect {
+        unsigned int left;   //!< The left of the rectangle
+        unsigned int top;    //!< The top of the rectangle
+        unsigned int width;  //!< The width of the rectangle
+        unsigned int height; //!< The height of the rectangle
+    };
+
+    /**
+     * @brief Texture rects of every animation frame of every actor
+     *
+     * All actors are drawn from "Spritesheet.png". Instead of having each
+     * actor build its own ime::SpriteSheet and look frames up by row and
+     * column, the atlas computes the rect of every frame once at startup
+     * and stores them in a flat table indexed by actor, animation and frame.
+     * Changing an animation frame or a damage state is therefore an array
+     * lookup
+     *
+     * The atlas does not depend on the engine, so that frames can also be
+     * drawn by builds without a window (see WorldRenderer). The atlas must
+     * be built with build() before it is used
+     */
+    class SpriteAtlas {
+    public:
+        /**
+         * @brief Actors that have frames in the atlas
+         */
+        enum class Actor : unsigned int {
+            Mushroom,      //!< Mushroom
+            Flea,          //!< Flea
+            Scorpion,      //!< Scorpion
+            CentipedeHead, //!< CentipedeSegment of type Head
+            CentipedeBody, //!< CentipedeSegment of type Body
+            Player,        //!< Player
+            Bullet,        //!< Bullet
+            Count          //!< Number of actors, keep last
+        };
+
+        /**
+         * @brief Animations of the actors
+         *
+         * The meaning of an animation depends on the actor, actors with a
+         * single animation use Idle (or its alias Moving). The frames of the
+         * Mushroom animations are indexed by the mushroom hit count
+         */
+        enum Animation : unsigned int {
+            Idle = 0,         //!< Player, Bullet
+            Moving = 0,       //!< Flea, Scorpion
+            Healthy = 0,      //!< Mushroom that is not poisoned
+            Poisoned = 1,     //!< Mushroom that is poisoned
+            Horizontal = 0,   //!< CentipedeSegment moving left or right
+            Vertical = 1,     //!< CentipedeSegment moving up or down
+            Diagonal = 2,     //!< CentipedeSegment switching rows
+            MaxAnimations = 3 //!< Maximum number of animations per actor
+        };
+
+        /**
+         * @brief Compute the frames of all actors
+         *
+         * Calling this function more than once has no effect
+         */
+        static void build();
+
+        /**
+         * @brief Check if the atlas has been built
+         * @return True if built, otherwise false
+         */
+        static bool isBuilt();
+
+        /**
+         * @brief Get the texture rect of a frame
+         * @param actor The actor the frame belongs to
+         * @param animation The animation the frame belongs to
+         * @param frame The index of the frame in the animation
+         * @return The texture rect of the frame
+         */
+        static const TextureRect& getFrame(Actor actor, unsigned int animation, unsigned int frame = 0);
+
+        /**
+         * @brief Get the number of frames in an animation
+         * @param actor The actor the animation belongs to
+         * @param animation The animation to get the frame count of
+         * @return The number of frames in the animation
+         */
+        static unsigned int getFrameCount(Actor actor, unsigned int animation);
+
+        /**
+         * @brief Get how long each frame of an animation is shown
+         * @param actor The actor the animation belongs to
+         * @param animation The animation to get the frame duration of
+         * @return The duration of a single frame in seconds
+         */
+        static float getFrameDuration(Actor actor, unsigned int animation);
+
+        /**
+         * @brief Get the name of the texture the frames belong to
+         * @return The name of the texture
+         */
+        static const char* getTexture();
+
+    private:
+        /**
+         * @brief A contiguous range of frames in the frame table
+         */
+        struct Range {
+            unsigned int first;  //!< Index of the first frame
+            unsigned int count;  //!< Number of frames
+            float frameDuration; //!< How long each frame is shown in seconds
+        };
+
+        /**
+         * @brief Get the range of an animation
+         * @param actor The actor the animation belongs to
+         * @param animation The animation to get the range of
+         * @return The range of the animation
+         */
+        static const Range& getRange(Actor actor, unsigned int animation);
+
+    private:
+        static inline std::vector<TextureRect> m_frames{}; //!< Frames of all animations of all actors
+        static inline std::array<Range, static_cast<std::size_t>(Actor::Count) * MaxAnimations> m_ranges{}; //!< Animation ranges indexed by actor and animation
+        static inline bool m_isBuilt = false; //!< A flag indicating whether or not the atlas is built
+    };
+}
+
+#endif //CENTIPEDE_SPRITEATLAS_H
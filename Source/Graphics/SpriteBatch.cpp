@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/SpriteBatch.h"
+#include <IME/graphics/RenderTarget.h>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace centpd {
+    namespace {
+        const std::size_t VERTICES_PER_QUAD = 4;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SpriteBatch::SpriteBatch(const sf::Texture &texture) :
+        m_texture{texture}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void SpriteBatch::add(ime::GameObject *actor) {
+        assert(actor && "A nullptr cannot be added to a sprite batch");
+        if (m_slots.find(actor->getObjectId()) != m_slots.end())
+            return;
+
+        m_slots[actor->getObjectId()] = m_actors.size();
+        m_actors.push_back(actor);
+        m_quads.emplace_back();
+        m_vertices.resize(m_vertices.size() + VERTICES_PER_QUAD);
+
+        m_destructionIds[actor->getObjectId()] = actor->onDestruction([this, actor] {
+            m_destructionIds.erase(actor->getObjectId());
+            remove(actor);
+        });
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpriteBatch::remove(ime::GameObject *actor) {
+        auto found = m_slots.find(actor->getObjectId());
+        if (found == m_slots.end())
+            return;
+
+        // Fill the gap with the last actor so that the buffer stays contiguous
+        std::size_t slot = found->second;
+        std::size_t last = m_actors.size() - 1;
+        if (slot != last) {
+            m_actors[slot] = m_actors[last];
+            m_quads[slot] = m_quads[last];
+            std::copy_n(m_vertices.begin() + last * VERTICES_PER_QUAD, VERTICES_PER_QUAD, m_vertices.begin() + slot * VERTICES_PER_QUAD);
+            m_slots[m_actors[slot]->getObjectId()] = slot;
+        }
+
+        m_actors.pop_back();
+        m_quads.pop_back();
+        m_vertices.resize(m_vertices.size() - VERTICES_PER_QUAD);
+        m_slots.erase(found);
+
+        auto destructionId = m_destructionIds.find(actor->getObjectId());
+        if (destructionId != m_destructionIds.end()) {
+            actor->removeDestructionListener(destructionId->second);
+            m_destructionIds.erase(destructionId);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t SpriteBatch::getSize() const {
+        return m_actors.size();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpriteBatch::update() {
+        for (std::size_t slot = 0; slot < m_actors.size(); slot++) {
+            const ime::Sprite& sprite = m_actors[slot]->getSprite();
+            const ime::UIntRect textureRect = sprite.getTextureRect();
+
+            SpriteQuad quad;
+            quad.x = sprite.getPosition().x;
+            quad.y = sprite.getPosition().y;
+            quad.scaleX = sprite.getScale().x;
+            quad.scaleY = sprite.getScale().y;
+            quad.originX = sprite.getOrigin().x;
+            quad.originY = sprite.getOrigin().y;
+            quad.left = textureRect.left;
+            quad.top = textureRect.top;
+            quad.width = textureRect.width;
+            quad.height = textureRect.height;
+            quad.visible = sprite.isVisible() && m_actors[slot]->isActive();
+
+            if (quad != m_quads[slot]) {
+                buildVertices(quad, &m_vertices[slot * VERTICES_PER_QUAD]);
+                m_quads[slot] = quad;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<SpriteQuad> &SpriteBatch::getQuads() const {
+        return m_quads;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpriteBatch::buildVertices(const SpriteQuad &quad, sf::Vertex* vertices) {
+        // Hidden actors are collapsed into a degenerate quad instead of being
+        // removed, this keeps the slots stable while the actor is invisible
+        if (!quad.visible) {
+            for (std::size_t i = 0; i < VERTICES_PER_QUAD; i++)
+                vertices[i].position = sf::Vector2f{quad.x, quad.y};
+            return;
+        }
+
+        const auto width = static_cast<float>(quad.width);
+        const auto height = static_cast<float>(quad.height);
+        const auto left = static_cast<float>(quad.left);
+        const auto top = static_cast<float>(quad.top);
+
+        // A negative scale flips the quad, which is how actors face other directions
+        auto corner = [&quad](float x, float y) {
+            return sf::Vector2f{quad.x + (x - quad.originX) * quad.scaleX,
+                                quad.y + (y - quad.originY) * quad.scaleY};
+        };
+
+        vertices[0].position = corner(0.0f, 0.0f);
+        vertices[1].position = corner(width, 0.0f);
+        vertices[2].position = corner(width, height);
+        vertices[3].position = corner(0.0f, height);
+
+        vertices[0].texCoords = sf::Vector2f{left, top};
+        vertices[1].texCoords = sf::Vector2f{left + width, top};
+        vertices[2].texCoords = sf::Vector2f{left + width, top + height};
+        vertices[3].texCoords = sf::Vector2f{left, top + height};
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpriteBatch::draw(ime::priv::RenderTarget &renderTarget) const {
+        if (m_vertices.empty())
+            return;
+
+        sf::RenderStates states;
+        states.texture = &m_texture;
+        renderTarget.getThirdPartyWindow().draw(m_vertices.data(), m_vertices.size(), sf::Quads, states);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::string SpriteBatch::getClassName() const {
+        return "SpriteBatch";
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SpriteBatch::~SpriteBatch() {
+        for (auto* actor : m_actors) {
+            auto destructionId = m_destructionIds.find(actor->getObjectId());
+            if (destructionId != m_destructionIds.end())
+                actor->removeDestructionListener(destructionId->second);
+        }
+    }
+}
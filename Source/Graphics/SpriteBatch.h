@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPRITEBATCH_H
+#define CENTIPEDE_SPRITEBATCH_H
+
+#include "Source/Graphics/SpriteQuad.h"
+#include <IME/core/game_object/GameObject.h>
+#include <IME/graphics/Drawable.h>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+namespace centpd {
+    /**
+     * @brief Draws many actors that share a texture with a single draw call
+     *
+     * Instead of drawing the sprite of each actor individually, the batch
+     * packs the sprites of all its actors into one vertex buffer and draws
+     * the buffer at once. The vertices of an actor are only rebuilt when its
+     * texture rect, position, scale or visibility changes, so the per frame
+     * cost of actors that do not move is a single comparison
+     *
+     * The sprites of the actors have no texture of their own, they only
+     * provide the texture rect, position, scale and origin of each quad.
+     * All quads are drawn with the texture the batch was created with
+     */
+    class SpriteBatch : public ime::Drawable {
+    public:
+        /**
+         * @brief Constructor
+         * @param texture The texture shared by the actors
+         *
+         * The texture must outlive the batch
+         */
+        explicit SpriteBatch(const sf::Texture& texture);
+
+        /**
+         * @brief Add an actor to the batch
+         * @param actor The actor to be added
+         *
+         * The actor is automatically removed from the batch when it is destroyed
+         */
+        void add(ime::GameObject* actor);
+
+        /**
+         * @brief Remove an actor from the batch
+         * @param actor The actor to be removed
+         */
+        void remove(ime::GameObject* actor);
+
+        /**
+         * @brief Get the number of actors in the batch
+         * @return The number of actors in the batch
+         */
+        std::size_t getSize() const;
+
+        /**
+         * @brief Rebuild the vertices of the actors that changed since the last update
+         *
+         * This function must be called once per frame, before the batch is drawn
+         */
+        void update();
+
+        /**
+         * @brief Get the quads of the actors in the batch
+         * @return The quads as of the last update
+         *
+         * @see update
+         */
+        const std::vector<SpriteQuad>& getQuads() const;
+
+        /**
+         * @brief Draw the batch
+         * @param renderTarget The target to draw the batch on
+         */
+        void draw(ime::priv::RenderTarget& renderTarget) const override;
+
+        /**
+         * @brief Get the name of this class in string format
+         * @return The name of this class
+         */
+        std::string getClassName() const override;
+
+        /**
+         * @brief Destructor
+         */
+        ~SpriteBatch() override;
+
+        /**
+         * @brief Build the four vertices of a quad
+         * @param quad The quad to build the vertices from
+         * @param vertices The vertices to be built
+         *
+         * An invisible quad is collapsed into a degenerate quad
+         */
+        static void buildVertices(const SpriteQuad& quad, sf::Vertex* vertices);
+
+    private:
+        const sf::Texture& m_texture;                  //!< Texture shared by all the actors in the batch
+        std::vector<ime::GameObject*> m_actors;        //!< Actors in the batch
+        std::vector<SpriteQuad> m_quads;               //!< The quad each actors vertices were built from
+        std::vector<sf::Vertex> m_vertices;            //!< Four vertices per actor
+        std::unordered_map<int, std::size_t> m_slots;  //!< Maps an actor id to its position in the batch
+        std::unordered_map<int, int> m_destructionIds; //!< Maps an actor id to its destruction listener id
+    };
+}
+
+#endif //CENTIPEDE_SPRITEBATCH_H
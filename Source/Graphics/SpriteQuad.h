@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPRITEQUAD_H
+#define CENTIPEDE_SPRITEQUAD_H
+
+namespace centpd {
+    /**
+     * @brief The geometry of a sprite, independent of the graphics backend
+     *
+     * A quad is the textured rectangle a sprite is drawn as. It is used by
+     * SpriteBatch to build GPU vertices and by SoftwareRasterizer to draw
+     * sprites on the CPU
+     */
+    struct SpriteQuad {
+        float x = 0.0f;          //!< Horizontal position of the origin in the world
+        float y = 0.0f;          //!< Vertical position of the origin in the world
+        float scaleX = 1.0f;     //!< Horizontal scale, negative flips the sprite horizontally
+        float scaleY = 1.0f;     //!< Vertical scale, negative flips the sprite vertically
+        float originX = 0.0f;    //!< Horizontal origin relative to the texture rect
+        float originY = 0.0f;    //!< Vertical origin relative to the texture rect
+        unsigned int left = 0;   //!< Left of the texture rect
+        unsigned int top = 0;    //!< Top of the texture rect
+        unsigned int width = 0;  //!< Width of the texture rect
+        unsigned int height = 0; //!< Height of the texture rect
+        bool visible = false;    //!< A flag indicating whether or not the quad is drawn
+
+        /**
+         * @brief Check if two quads are the same
+         * @param rhs The quad to compare against this quad
+         * @return True if the quads are the same, otherwise false
+         */
+        bool operator==(const SpriteQuad& rhs) const {
+            return x == rhs.x && y == rhs.y && scaleX == rhs.scaleX && scaleY == rhs.scaleY
+                && originX == rhs.originX && originY == rhs.originY && left == rhs.left && top == rhs.top
+                && width == rhs.width && height == rhs.height && visible == rhs.visible;
+        }
+
+        /**
+         * @brief Check if two quads are not the same
+         * @param rhs The quad to compare against this quad
+         * @return True if the quads are not the same, otherwise false
+         */
+        bool operator!=(const SpriteQuad& rhs) const {
+            return !(*this == rhs);
+        }
+    };
+}
+
+#endif //CENTIPEDE_SPRITEQUAD_H
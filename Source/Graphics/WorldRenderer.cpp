@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Graphics/WorldRenderer.h"
+#include "Source/Graphics/SpriteAtlas.h"
+#include <algorithm>
+
+namespace centpd {
+    namespace {
+        // The sprites are drawn at twice the size of their texture, as in the rendered build
+        const float SPRITE_SCALE = 2.0f;
+
+        ///////////////////////////////////////////////////////////////
+        SpriteQuad makeQuad(const TextureRect& frame, float x, float y, bool isFlippedX = false, bool isFlippedY = false) {
+            SpriteQuad quad;
+            quad.x = x;
+            quad.y = y;
+            quad.scaleX = isFlippedX ? -SPRITE_SCALE : SPRITE_SCALE;
+            quad.scaleY = isFlippedY ? -SPRITE_SCALE : SPRITE_SCALE;
+            quad.originX = static_cast<float>(frame.width) / 2.0f;
+            quad.originY = static_cast<float>(frame.height) / 2.0f;
+            quad.left = frame.left;
+            quad.top = frame.top;
+            quad.width = frame.width;
+            quad.height = frame.height;
+            quad.visible = true;
+            return quad;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        SpriteQuad makeSegmentQuad(const ActorArrays& segments, std::size_t index, const Position& pos) {
+            // On the texture a segment faces left, down or down-left, the other directions are flipped (see CentipedeSegment)
+            auto actor = segments.type[index] == ActorType::CentipedeHead ? SpriteAtlas::Actor::CentipedeHead : SpriteAtlas::Actor::CentipedeBody;
+            const Direction dir = segments.dir[index];
+            if (dir == Direction::Left || dir == Direction::Right)
+                return makeQuad(SpriteAtlas::getFrame(actor, SpriteAtlas::Horizontal), pos.x, pos.y, dir == Direction::Right);
+            else if (dir == Direction::Up || dir == Direction::Down)
+                return makeQuad(SpriteAtlas::getFrame(actor, SpriteAtlas::Vertical), pos.x, pos.y, false, dir == Direction::Up);
+            else
+                return makeQuad(SpriteAtlas::getFrame(actor, SpriteAtlas::Diagonal), pos.x, pos.y,
+                    dir == Direction::DownRight || dir == Direction::UpRight, dir == Direction::UpLeft || dir == Direction::UpRight);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void WorldRenderer::draw(const World& world, FrameCapture& capture) {
+        buildMushrooms(world);
+        buildActors(world);
+        capture.drawLayer(m_mushrooms);
+        capture.drawLayer(m_actors);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int WorldRenderer::getFrameWidth(const WorldSettings& settings) {
+        return settings.cols * settings.tileSize;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int WorldRenderer::getFrameHeight(const WorldSettings& settings) {
+        return settings.rows * settings.tileSize;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void WorldRenderer::buildMushrooms(const World& world) {
+        m_mushrooms.clear();
+
+        // Chunks the field never allocated have version 0 and cannot have mushrooms
+        const MushroomField& field = world.getMushrooms();
+        const unsigned int chunkSize = MushroomField::CHUNK_SIZE;
+        const auto tileSize = static_cast<float>(world.getSettings().tileSize);
+        for (unsigned int chunkRow = 0; chunkRow < field.getChunkRows(); chunkRow++) {
+            for (unsigned int chunkCol = 0; chunkCol < field.getChunkCols(); chunkCol++) {
+                if (field.getChunkVersion(chunkRow, chunkCol) == 0)
+                    continue;
+
+                const unsigned int lastRow = std::min((chunkRow + 1) * chunkSize, field.getRows());
+                const unsigned int lastCol = std::min((chunkCol + 1) * chunkSize, field.getCols());
+                for (unsigned int row = chunkRow * chunkSize; row < lastRow; row++) {
+                    for (unsigned int col = chunkCol * chunkSize; col < lastCol; col++) {
+                        const std::uint8_t tile = field.getTile(static_cast<int>(row), static_cast<int>(col));
+                        if (!(tile & MushroomField::PRESENT))
+                            continue;
+
+                        auto animation = (tile & MushroomField::POISONED) ? SpriteAtlas::Poisoned : SpriteAtlas::Healthy;
+                        m_mushrooms.push_back(makeQuad(SpriteAtlas::getFrame(SpriteAtlas::Actor::Mushroom, animation, tile & MushroomField::HITS),
+                            (static_cast<float>(col) + 0.5f) * tileSize, (static_cast<float>(row) + 0.5f) * tileSize));
+                    }
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void WorldRenderer::buildActors(const World& world) {
+        m_actors.clear();
+
+        for (std::size_t k = 0; k < static_cast<std::size_t>(ActorKind::Count); k++) {
+            const auto kind = static_cast<ActorKind>(k);
+            const ActorArrays& actors = world.getActors(kind);
+
+            for (std::size_t i = 0; i < actors.size(); i++) {
+                if (!actors.active[i])
+                    continue;
+
+                const Position pos = world.getPosition(kind, i);
+                switch (kind) {
+                    case ActorKind::Player:
+                        m_actors.push_back(makeQuad(SpriteAtlas::getFrame(SpriteAtlas::Actor::Player, SpriteAtlas::Idle), pos.x, pos.y));
+                        break;
+                    case ActorKind::Bullet:
+                        m_actors.push_back(makeQuad(SpriteAtlas::getFrame(SpriteAtlas::Actor::Bullet, SpriteAtlas::Idle), pos.x, pos.y));
+                        break;
+                    case ActorKind::CentipedeSegment:
+                        m_actors.push_back(makeSegmentQuad(actors, i, pos));
+                        break;
+                    case ActorKind::Scorpion:
+                        // By default the scorpion texture is facing left
+                        m_actors.push_back(makeQuad(SpriteAtlas::getFrame(SpriteAtlas::Actor::Scorpion, SpriteAtlas::Moving), pos.x, pos.y,
+                            actors.dir[i] == Direction::Right));
+                        break;
+                    default:
+                        m_actors.push_back(makeQuad(SpriteAtlas::getFrame(SpriteAtlas::Actor::Flea, SpriteAtlas::Moving), pos.x, pos.y));
+                        break;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_WORLDRENDERER_H
+#define CENTIPEDE_WORLDRENDERER_H
+
+#include "Source/Graphics/FrameCapture.h"
+#include "Source/Graphics/SpriteQuad.h"
+#include "Source/Simulation/World.h"
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Draws a World on a FrameCapture without game objects
+     *
+     * The quads are built straight from the actor arrays and the mushroom
+     * field with the frames of the SpriteAtlas, so frames can be captured
+     * by builds that have no window or graphics context, such as the
+     * simulation only build and the benchmark. Animated actors are drawn
+     * with the first frame of their animation, a world is therefore always
+     * drawn the same way
+     *
+     * The SpriteAtlas must be built before a world is drawn
+     */
+    class WorldRenderer {
+    public:
+        /**
+         * @brief Draw the simulated state of a world on the current frame
+         * @param world The world to be drawn
+         * @param capture The capture to draw on, between beginFrame and endFrame
+         *
+         * Mushrooms are drawn first and the actors on top of them
+         */
+        void draw(const World& world, FrameCapture& capture);
+
+        /**
+         * @brief Get the width of the frames of a world
+         * @param settings The settings of the world
+         * @return The width of the grid in pixels
+         */
+        static unsigned int getFrameWidth(const WorldSettings& settings);
+
+        /**
+         * @brief Get the height of the frames of a world
+         * @param settings The settings of the world
+         * @return The height of the grid in pixels
+         */
+        static unsigned int getFrameHeight(const WorldSettings& settings);
+
+    private:
+        /**
+         * @brief Build the quads of the mushrooms
+         * @param world The world whose mushrooms are drawn
+         */
+        void buildMushrooms(const World& world);
+
+        /**
+         * @brief Build the quads of the actors
+         * @param world The world whose actors are drawn
+         */
+        void buildActors(const World& world);
+
+    private:
+        std::vector<SpriteQuad> m_mushrooms; //!< The quads of the mushrooms, reused between frames
+        std::vector<SpriteQuad> m_actors;    //!< The quads of the actors, reused between frames
+    };
+}
+
+#endif //CENTIPEDE_WORLDRENDERER_H
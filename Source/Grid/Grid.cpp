@@ -23,23 +23,51 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Source/Grid/Grid.h"
+#include <algorithm>
 #include <cassert>
 
 namespace centpd {
+    namespace {
+        // Sprites of batched actors are placed in this layer, which is never
+        // rendered. The batch of the actors class layer draws them instead
+        const std::string BATCHED_LAYER = "Batched";
+    }
+
+#ifndef CENTIPEDE_HEADLESS
     ///////////////////////////////////////////////////////////////
-    Grid::Grid(ime::TileMap& tileMap, ime::GameObjectContainer& gameObjects) :
+    Grid::Grid(ime::TileMap& tileMap, ime::GameObjectContainer& gameObjects, const sf::Texture& spritesheet) :
         m_grid{tileMap},
         m_gameObjects{gameObjects}
     {
         // By default, IME sorts render layers by the order in which they are created
         m_grid.renderLayers().create("GameObject"); // ime::GameObject instances go to this layer
-        m_grid.renderLayers().create("Bullet");
-        m_grid.renderLayers().create("Mushroom");
-        m_grid.renderLayers().create("CentipedeSegment");
-        m_grid.renderLayers().create("Scorpion");
-        m_grid.renderLayers().create("Player");
-        m_grid.renderLayers().create("Flea");
+
+        for (const std::string actorLayer : {"Bullet", "Mushroom", "CentipedeSegment", "Scorpion", "Player", "Flea"}) {
+            // Mushrooms are not game objects, their layer is drawn from the tile data of the simulation
+            if (actorLayer == "Mushroom") {
+                m_mushroomBatch = std::make_unique<MushroomBatch>(spritesheet, m_grid.getTileSize().x);
+                m_grid.renderLayers().create(actorLayer)->add(*m_mushroomBatch);
+                m_layerQuads.push_back(&m_mushroomBatch->getQuads());
+                continue;
+            }
+
+            auto batch = std::make_unique<SpriteBatch>(spritesheet);
+            m_grid.renderLayers().create(actorLayer)->add(*batch);
+            m_layerQuads.push_back(&batch->getQuads());
+            m_batches.emplace_back(actorLayer, std::move(batch));
+        }
+
+        m_grid.renderLayers().create(BATCHED_LAYER)->setShouldRender(false);
+    }
+#else
+    ///////////////////////////////////////////////////////////////
+    Grid::Grid(ime::TileMap& tileMap, ime::GameObjectContainer& gameObjects) :
+        m_grid{tileMap},
+        m_gameObjects{gameObjects}
+    {
+        m_grid.renderLayers().create(BATCHED_LAYER)->setShouldRender(false);
     }
+#endif
 
     ///////////////////////////////////////////////////////////////
     void Grid::create(unsigned int rows, unsigned int cols) {
@@ -53,23 +81,25 @@ namespace centpd {
     }
 
     ///////////////////////////////////////////////////////////////
-    ime::GameObject* Grid::addActor(ime::GameObject::Ptr object, ime::Index index) {
+    ime::GameObject* Grid::addActor(ime::GameObject::Ptr object) {
         assert(object && "Object must not be a nullptr");
 
-        m_grid.addChild(object.get(), index);
-        std::string renderLayer = object->getClassName();
-        const std::string& group = renderLayer;
-        return m_gameObjects.add(group, std::move(object), 0, renderLayer);
-    }
+        std::string group = object->getClassName();
 
-    ///////////////////////////////////////////////////////////////
-    void Grid::addActor(ime::GameObject *actor, ime::Index index) {
-        m_grid.addChild(actor, index);
-    }
+#ifdef CENTIPEDE_HEADLESS
+        return m_gameObjects.add(group, std::move(object), 0, BATCHED_LAYER);
+#else
+        auto batch = std::find_if(m_batches.begin(), m_batches.end(), [&group](const auto& layerBatch) {
+            return layerBatch.first == group;
+        });
 
-    ///////////////////////////////////////////////////////////////
-    ime::Index Grid::getActorTile(ime::GameObject *actor) {
-        return m_grid.getTileOccupiedByChild(actor).getIndex();
+        if (batch == m_batches.end())
+            return m_gameObjects.add(group, std::move(object), 0, group);
+
+        ime::GameObject* actor = m_gameObjects.add(group, std::move(object), 0, BATCHED_LAYER);
+        batch->second->add(actor);
+        return actor;
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
@@ -83,27 +113,23 @@ namespace centpd {
     }
 
     ///////////////////////////////////////////////////////////////
-    bool Grid::isCellOccupied(const ime::Index &index) const {
-        return m_grid.isTileOccupied(index);
+    ime::Scene &Grid::getScene() {
+        return m_grid.getScene();
     }
 
+#ifndef CENTIPEDE_HEADLESS
     ///////////////////////////////////////////////////////////////
-    bool Grid::isMushroomInCell(const ime::Index &index) const {
-        bool hasMushroom = false;
-        m_grid.forEachChildInTile(m_grid.getTile(index), [&hasMushroom](ime::GameObject* gameObject) {
-            // IME v2.3.0 has no way of terminating loop early :(
-            if (hasMushroom)
-                return;
-
-            if (gameObject->getClassName() == "Mushroom")
-                hasMushroom = true;
-        });
+    void Grid::update(const MushroomField& mushrooms) {
+        for (auto& [layer, batch] : m_batches)
+            batch->update();
 
-        return hasMushroom;
+        m_mushroomBatch->update(mushrooms);
     }
 
     ///////////////////////////////////////////////////////////////
-    ime::Scene &Grid::getScene() {
-        return m_grid.getScene();
+    void Grid::forEachBatch(const std::function<void(const std::vector<SpriteQuad>&)>& callback) const {
+        for (const auto* quads : m_layerQuads)
+            callback(*quads);
     }
+#endif
 }
@@ -27,6 +27,14 @@
 
 #include <IME/core/game_object/GameObject.h>
 #include <IME/core/tilemap/TileMap.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifndef CENTIPEDE_HEADLESS
+#include "Source/Graphics/SpriteBatch.h"
+#include "Source/Graphics/MushroomBatch.h"
+#endif
 
 namespace centpd {
     /**
@@ -34,12 +42,25 @@ namespace centpd {
      */
     class Grid {
     public:
+#ifndef CENTIPEDE_HEADLESS
         /**
          * @brief Constructors
          * @param tileMap Third party grid
          * @param objects Scene objects container
+         * @param spritesheet The texture shared by the actors
+         */
+        Grid(ime::TileMap& tileMap, ime::GameObjectContainer& objects, const sf::Texture& spritesheet);
+#else
+        /**
+         * @brief Constructor
+         * @param tileMap Third party grid
+         * @param objects Scene objects container
+         *
+         * The simulation only grid has no render layer batches, actors are
+         * placed in a single render layer which is never rendered
          */
         Grid(ime::TileMap& tileMap, ime::GameObjectContainer& objects);
+#endif
 
         /**
          * @brief Create the grid
@@ -50,31 +71,16 @@ namespace centpd {
 
         /**
          * @brief Add an actor to the grid
-         * @param actor The actor to be added to the grid
-         * @param index The index of the cell to add the actor to
+         * @param actor The actor to be added
+         * @return The added actor
          *
          * Note that @a actor is assigned to an object group and render layer
          * that have the same name as its class name (see ime::Object::getClassName()).
+         * Actors are not drawn individually, the render layer draws all its
+         * actors at once with a SpriteBatch. The grid does not position the
+         * actor, its position is set from the World
          */
-        ime::GameObject* addActor(ime::GameObject::Ptr actor, ime::Index index);
-
-        /**
-         * @brief Add an actor to the grid
-         * @param actor The actor to be added to the grid
-         * @param index The index of the cell to add the actor to
-         *
-         * This function does not assign @a actor to a group or render layer.
-         * It is used for objects that already have them but are not in the
-         * grid
-         */
-        void addActor(ime::GameObject* actor, ime::Index index);
-
-        /**
-         * @brief Get the index of the cell occupied by an actor
-         * @param actor The actor to get the index of
-         * @return The index of the actor in the grid, otherwise {-1, -1}
-         */
-        ime::Index getActorTile(ime::GameObject* actor);
+        ime::GameObject* addActor(ime::GameObject::Ptr actor);
 
         /**
          * @brief Get the number of rows
@@ -89,30 +95,38 @@ namespace centpd {
         unsigned int getCols() const;
 
         /**
-         * @brief Check if a cell is occupied
-         * @param index The index of the cell to be checked
-         * @return True if occupied, otherwise false
+         * @brief Get the scene the grid belongs to
+         * @return The scene the grid belongs to
          */
-        bool isCellOccupied(const ime::Index& index) const;
+        ime::Scene& getScene();
 
+#ifndef CENTIPEDE_HEADLESS
         /**
-         * @brief Check if a cell has a Mushroom or not
-         * @param index The index of the cell to be checked
-         * @return True if the cell contains a mushroom, otherwise false
+         * @brief Update the render layer batches
+         * @param mushrooms The mushrooms to be drawn
          *
-         * @see isCellOccupied
+         * This function must be called once per frame after the actors
+         * have been moved
          */
-        bool isMushroomInCell(const ime::Index& index) const;
+        void update(const MushroomField& mushrooms);
 
         /**
-         * @brief Get the scene the grid belongs to
-         * @return The scene the grid belongs to
+         * @brief Execute a function for each render layer batch
+         * @param callback Function to be executed with the quads of the batch
+         *
+         * Batches are visited in render order, from the bottom layer to the top
          */
-        ime::Scene& getScene();
+        void forEachBatch(const std::function<void(const std::vector<SpriteQuad>&)>& callback) const;
+#endif
 
     private:
         ime::TileMap& m_grid;
         ime::GameObjectContainer& m_gameObjects;
+#ifndef CENTIPEDE_HEADLESS
+        std::vector<std::pair<std::string, std::unique_ptr<SpriteBatch>>> m_batches; //!< Actor render layer batches
+        std::unique_ptr<MushroomBatch> m_mushroomBatch;                              //!< Draws the mushroom field
+        std::vector<const std::vector<SpriteQuad>*> m_layerQuads;                    //!< Quads of each batch in render order
+#endif
     };
 }
 
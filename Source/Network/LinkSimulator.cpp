@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Network/LinkSimulator.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace centpd {
+    namespace {
+        ///////////////////////////////////////////////////////////////
+        float toFraction(std::uint64_t number) {
+            return static_cast<float>(number >> 40) / static_cast<float>(1u << 24);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    LinkSimulator::LinkSimulator(UdpSocket& socket, std::uint64_t seed) :
+        m_socket{socket},
+        m_random{seed},
+        m_dropCount{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void LinkSimulator::setConditions(const LinkConditions& conditions) {
+        m_conditions = conditions;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const LinkConditions &LinkSimulator::getConditions() const {
+        return m_conditions;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void LinkSimulator::send(const void* data, std::size_t size) {
+        assert(size <= UdpSocket::MAX_DATAGRAM_SIZE && "Datagram too large");
+
+        if (m_conditions.loss > 0.0f && toFraction(m_random.next()) < m_conditions.loss) {
+            m_dropCount++;
+            return;
+        }
+
+        float delay = m_conditions.latency + (toFraction(m_random.next()) * 2.0f - 1.0f) * m_conditions.jitter;
+        if (delay <= 0.0f && m_delayed.empty()) {
+            m_socket.send(data, size);
+            return;
+        }
+
+        Datagram& datagram = m_delayed.emplace_back();
+        datagram.due = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(std::max(delay, 0.0f)));
+        datagram.size = size;
+        std::memcpy(datagram.data.data(), data, size);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void LinkSimulator::flush() {
+        if (m_delayed.empty())
+            return;
+
+        const Clock::time_point now = Clock::now();
+        auto isSent = [this, now](const Datagram& datagram) {
+            if (datagram.due > now)
+                return false;
+
+            m_socket.send(datagram.data.data(), datagram.size);
+            return true;
+        };
+
+        m_delayed.erase(std::remove_if(m_delayed.begin(), m_delayed.end(), isSent), m_delayed.end());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t LinkSimulator::getDropCount() const {
+        return m_dropCount;
+    }
+}
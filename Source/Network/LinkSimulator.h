@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_LINKSIMULATOR_H
+#define CENTIPEDE_LINKSIMULATOR_H
+
+#include "Source/Network/UdpSocket.h"
+#include "Source/Simulation/Random.h"
+#include <array>
+#include <chrono>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Conditions of a simulated network link
+     */
+    struct LinkConditions {
+        float loss = 0.0f;    //!< The fraction of datagrams that are dropped, in the range [0, 1]
+        float latency = 0.0f; //!< The time a datagram takes to arrive in seconds
+        float jitter = 0.0f;  //!< The maximum random deviation from the latency in seconds
+    };
+
+    /**
+     * @brief Sends datagrams over a socket as if the link was lossy and slow
+     *
+     * Datagrams are dropped or held back before they reach the socket.
+     * Datagrams whose delays differ by more than the time between them
+     * arrive out of order. With the default conditions every datagram is
+     * sent immediately. Simulating the conditions on both peers lets a
+     * game be tested over the loopback interface
+     */
+    class LinkSimulator {
+    public:
+        /**
+         * @brief Constructor
+         * @param socket The socket datagrams are sent over
+         * @param seed The seed of the generator that decides the fate of each datagram
+         */
+        explicit LinkSimulator(UdpSocket& socket, std::uint64_t seed = 0);
+
+        /**
+         * @brief Set the simulated conditions
+         * @param conditions The conditions of the link
+         */
+        void setConditions(const LinkConditions& conditions);
+
+        /**
+         * @brief Get the simulated conditions
+         * @return The conditions of the link
+         */
+        const LinkConditions& getConditions() const;
+
+        /**
+         * @brief Send a datagram
+         * @param data The datagram
+         * @param size The size of the datagram, at most UdpSocket::MAX_DATAGRAM_SIZE bytes
+         *
+         * The datagram is sent immediately, held back or dropped
+         * depending on the conditions of the link
+         */
+        void send(const void* data, std::size_t size);
+
+        /**
+         * @brief Send the held back datagrams that are due
+         *
+         * This function must be called regularly, at least once a frame
+         */
+        void flush();
+
+        /**
+         * @brief Get the number of dropped datagrams
+         * @return The number of datagrams dropped so far
+         */
+        std::uint64_t getDropCount() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief A datagram that is held back
+         */
+        struct Datagram {
+            Clock::time_point due;                                       //!< The time the datagram is sent
+            std::size_t size;                                            //!< The size of the datagram in bytes
+            std::array<std::uint8_t, UdpSocket::MAX_DATAGRAM_SIZE> data; //!< The contents of the datagram
+        };
+
+        UdpSocket& m_socket;             //!< The socket datagrams are sent over
+        LinkConditions m_conditions;     //!< The simulated conditions
+        Random m_random;                 //!< Decides which datagrams are dropped and how long they are held
+        std::vector<Datagram> m_delayed; //!< The datagrams that are held back, in the order they were sent
+        std::uint64_t m_dropCount;       //!< The number of dropped datagrams
+    };
+}
+
+#endif //CENTIPEDE_LINKSIMULATOR_H
@@ -0,0 +1,412 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Network/RollbackSession.h"
+#include "Source/Simulation/Random.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace centpd {
+    namespace {
+        const std::uint8_t MAGIC[] = {'C', 'P'};
+        const std::uint8_t VERSION = 2;
+        const std::size_t HEADER_SIZE = 37;
+        const std::size_t MAX_INPUTS = 255;
+
+        /**
+         * @brief The contents of a datagram
+         *
+         * Layout, integers are little endian:
+         *  0  2 bytes  Magic "CP"
+         *  2  1 byte   Version
+         *  3  1 byte   Player of the sender
+         *  4  4 bytes  Session id
+         *  8  8 bytes  Hash of the settings and the initial state of the world
+         *  16 4 bytes  Last tick of the receivers input the sender has
+         *  20 4 bytes  Tick of the first input
+         *  24 4 bytes  Tick of the state hash, 0 if there is none yet
+         *  28 8 bytes  State hash of the world after that tick
+         *  36 1 byte   Number of inputs
+         *  37 1 byte   per input: the direction in the low 4 bits, fire in bit 4
+         */
+        struct InputPacket {
+            std::uint8_t player;
+            std::uint32_t sessionId;
+            std::uint64_t configHash;
+            std::uint32_t ack;
+            std::uint32_t firstTick;
+            std::uint32_t hashTick;
+            std::uint64_t stateHash;
+            std::uint8_t count;
+            const std::uint8_t* inputs;
+        };
+
+        ///////////////////////////////////////////////////////////////
+        void writeUint32(std::uint8_t* data, std::uint32_t value) {
+            for (int i = 0; i < 4; i++)
+                data[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::uint32_t readUint32(const std::uint8_t* data) {
+            std::uint32_t value = 0;
+            for (int i = 0; i < 4; i++)
+                value |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+
+            return value;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        void writeUint64(std::uint8_t* data, std::uint64_t value) {
+            writeUint32(data, static_cast<std::uint32_t>(value));
+            writeUint32(data + 4, static_cast<std::uint32_t>(value >> 32));
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::uint64_t readUint64(const std::uint8_t* data) {
+            return readUint32(data) | static_cast<std::uint64_t>(readUint32(data + 4)) << 32;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::uint64_t hashConfig(const World& world) {
+            const WorldSettings& settings = world.getSettings();
+            std::uint64_t hash = 0;
+            auto add = [&hash](std::uint32_t value) { hash = Random::mix(hash ^ value); };
+            auto addFloat = [&add](float value) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                add(bits);
+            };
+
+            add(settings.rows);
+            add(settings.cols);
+            add(settings.tileSize);
+            add(settings.tickRate);
+            add(settings.playerAreaHeight);
+            add(settings.numPlayers);
+            add(settings.numMushrooms);
+            add(settings.centipedeLength);
+            add(settings.centipedeLengthPerLevel);
+            add(static_cast<std::uint32_t>(settings.playerLives));
+            addFloat(settings.playerSpeed);
+            addFloat(settings.bulletSpeed);
+            addFloat(settings.centipedeSpeed);
+            addFloat(settings.scorpionSpeed);
+            addFloat(settings.fleaSpeed);
+            addFloat(settings.centipedeSpeedPerLevel);
+            addFloat(settings.scorpionSpawnInterval);
+            addFloat(settings.fleaSpawnInterval);
+            add(settings.enablePlayer | settings.enableMushrooms << 1 | settings.enableCentipedes << 2
+                | settings.enableScorpions << 3 | settings.enableFleas << 4);
+
+            // The seed is not kept by the world, the initial state covers it through the mushroom layout
+            return Random::mix(hash ^ world.getStateHash());
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::uint8_t encodeInput(const PlayerInput& input) {
+            return static_cast<std::uint8_t>(static_cast<std::uint8_t>(input.move) | (input.fire ? 0x10 : 0x00));
+        }
+
+        ///////////////////////////////////////////////////////////////
+        bool decodeInput(std::uint8_t byte, PlayerInput& input) {
+            if ((byte & 0x0F) > static_cast<std::uint8_t>(Direction::DownRight) || (byte & 0xE0) != 0)
+                return false;
+
+            input.move = static_cast<Direction>(byte & 0x0F);
+            input.fire = (byte & 0x10) != 0;
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        bool decodePacket(const std::uint8_t* data, std::size_t size, InputPacket& packet) {
+            if (size < HEADER_SIZE || data[0] != MAGIC[0] || data[1] != MAGIC[1] || data[2] != VERSION)
+                return false;
+
+            packet.player = data[3];
+            packet.sessionId = readUint32(data + 4);
+            packet.configHash = readUint64(data + 8);
+            packet.ack = readUint32(data + 16);
+            packet.firstTick = readUint32(data + 20);
+            packet.hashTick = readUint32(data + 24);
+            packet.stateHash = readUint64(data + 28);
+            packet.count = data[36];
+            packet.inputs = data + HEADER_SIZE;
+            return size == HEADER_SIZE + packet.count;
+        }
+
+        static_assert(HEADER_SIZE + MAX_INPUTS <= UdpSocket::MAX_DATAGRAM_SIZE, "Input datagrams must fit in a datagram");
+    }
+
+    ///////////////////////////////////////////////////////////////
+    RollbackSession::RollbackSession(const RollbackSettings& settings, const LinkConditions& conditions) :
+        m_settings{settings},
+        m_link{m_socket, settings.sessionId},
+        m_localPlayer{0},
+        m_tick{0},
+        m_inputs{},
+        m_confirmed{},
+        m_remoteAck{0},
+        m_mispredictedTick{0},
+        m_configHash{0},
+        m_stateHashes{},
+        m_remoteHashTick{0},
+        m_remoteHash{0},
+        m_checkedHashTick{0},
+        m_desyncTick{0},
+        m_isConfigMismatched{false},
+        m_isPeerConnected{false},
+        m_rollbackCount{0},
+        m_resimulatedTicks{0}
+    {
+        // The peer may be ahead by the rollback window plus both input delays, all of it must fit in the history
+        assert(settings.maxRollback > 0 && 2 * (settings.maxRollback + settings.inputDelay) < HISTORY / 2 && "Invalid rollback window");
+        m_link.setConditions(conditions);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool RollbackSession::open(const std::string& peerHost, std::uint16_t basePort, int player) {
+        for (unsigned int candidate = 0; candidate < NUM_PLAYERS; candidate++) {
+            if (player >= 0 && candidate != static_cast<unsigned int>(player))
+                continue;
+
+            if (m_socket.bind(static_cast<std::uint16_t>(basePort + candidate))) {
+                m_localPlayer = candidate;
+                return m_socket.setPeer(peerHost, static_cast<std::uint16_t>(basePort + (1 - candidate)));
+            }
+        }
+
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int RollbackSession::getLocalPlayer() const {
+        return m_localPlayer;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::start(const World& world) {
+        // Nobody has input for the first ticks, they are simulated without input on both peers
+        m_tick = 0;
+        m_confirmed.fill(m_settings.inputDelay);
+        m_remoteAck = m_settings.inputDelay;
+        m_snapshots.assign(m_settings.maxRollback + 1, world);
+        m_configHash = hashConfig(world);
+        m_remoteHashTick = m_checkedHashTick = m_desyncTick = 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool RollbackSession::canAdvance() const {
+        return m_tick + 1 <= m_confirmed[1 - m_localPlayer] + m_settings.maxRollback;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::advance(World& world, const PlayerInput& input) {
+        assert(canAdvance() && "The remote input is too far behind");
+
+        receive();
+        if (m_mispredictedTick != 0)
+            rollback(world);
+
+        const std::uint32_t tick = m_tick + 1;
+        const std::uint32_t inputTick = tick + m_settings.inputDelay;
+        m_inputs[m_localPlayer][inputTick % HISTORY] = input;
+        m_confirmed[m_localPlayer] = inputTick;
+
+        m_snapshots[tick % m_snapshots.size()] = world;
+        simulate(world, tick);
+        m_tick = tick;
+        checkStateHash();
+
+        send();
+        m_link.flush();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::poll() {
+        receive();
+        send();
+        m_link.flush();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool RollbackSession::isPeerConnected() const {
+        return m_isPeerConnected;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool RollbackSession::isConfigMismatched() const {
+        return m_isConfigMismatched;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint32_t RollbackSession::getDesyncTick() const {
+        return m_desyncTick;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t RollbackSession::getRollbackCount() const {
+        return m_rollbackCount;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t RollbackSession::getResimulatedTickCount() const {
+        return m_resimulatedTicks;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t RollbackSession::getDropCount() const {
+        return m_link.getDropCount();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    World::PlayerInputs RollbackSession::getInputs(std::uint32_t tick) {
+        World::PlayerInputs inputs{};
+        for (std::size_t player = 0; player < NUM_PLAYERS; player++) {
+            PlayerInput& input = m_inputs[player][tick % HISTORY];
+
+            // Unknown input is predicted and remembered, so that the real input can be compared with it
+            if (tick > m_confirmed[player]) {
+                input.move = m_inputs[player][m_confirmed[player] % HISTORY].move;
+                input.fire = false;
+            }
+
+            inputs[player] = input;
+        }
+
+        return inputs;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::rollback(World& world) {
+        world = m_snapshots[m_mispredictedTick % m_snapshots.size()];
+        for (std::uint32_t tick = m_mispredictedTick; tick <= m_tick; tick++) {
+            if (tick != m_mispredictedTick)
+                m_snapshots[tick % m_snapshots.size()] = world;
+
+            simulate(world, tick);
+            m_resimulatedTicks++;
+        }
+
+        m_rollbackCount++;
+        m_mispredictedTick = 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::simulate(World& world, std::uint32_t tick) {
+        world.tick(getInputs(tick));
+        m_stateHashes[tick % HISTORY] = world.getStateHash();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint32_t RollbackSession::getConfirmedTick() const {
+        const std::uint32_t tick = std::min(m_tick, m_confirmed[1 - m_localPlayer]);
+        return m_mispredictedTick != 0 ? std::min(tick, m_mispredictedTick - 1) : tick;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::checkStateHash() {
+        // A hash older than the history can no longer be compared, it is skipped
+        if (m_remoteHashTick <= m_checkedHashTick || m_remoteHashTick > getConfirmedTick() || m_remoteHashTick + HISTORY <= m_tick)
+            return;
+
+        if (m_stateHashes[m_remoteHashTick % HISTORY] != m_remoteHash && m_desyncTick == 0)
+            m_desyncTick = m_remoteHashTick;
+
+        m_checkedHashTick = m_remoteHashTick;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::receive() {
+        const unsigned int remotePlayer = 1 - m_localPlayer;
+        std::uint8_t data[UdpSocket::MAX_DATAGRAM_SIZE];
+        InputPacket packet{};
+
+        while (std::size_t size = m_socket.receive(data, sizeof(data))) {
+            if (!decodePacket(data, size, packet) || packet.sessionId != m_settings.sessionId || packet.player != remotePlayer)
+                continue;
+
+            // The peer is refused, its input would be simulated in a different world
+            if (packet.configHash != m_configHash) {
+                m_isConfigMismatched = true;
+                continue;
+            }
+
+            m_isPeerConnected = true;
+            if (packet.hashTick > m_remoteHashTick) {
+                m_remoteHashTick = packet.hashTick;
+                m_remoteHash = packet.stateHash;
+            }
+
+            m_remoteAck = std::max(m_remoteAck, std::min(packet.ack, m_confirmed[m_localPlayer]));
+
+            for (std::uint32_t i = 0; i < packet.count; i++) {
+                const std::uint32_t tick = packet.firstTick + i;
+                PlayerInput input;
+                if (tick <= m_confirmed[remotePlayer])
+                    continue;
+
+                // Input is only accepted in order, and never so far ahead that it would overwrite history in use
+                if (tick != m_confirmed[remotePlayer] + 1 || tick >= m_tick + HISTORY / 2 || !decodeInput(packet.inputs[i], input))
+                    break;
+
+                PlayerInput& used = m_inputs[remotePlayer][tick % HISTORY];
+                if (tick <= m_tick && (used.move != input.move || used.fire != input.fire) && (m_mispredictedTick == 0 || tick < m_mispredictedTick))
+                    m_mispredictedTick = tick;
+
+                used = input;
+                m_confirmed[remotePlayer] = tick;
+            }
+        }
+
+        checkStateHash();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void RollbackSession::send() {
+        std::uint8_t data[HEADER_SIZE + MAX_INPUTS];
+        const std::uint32_t firstTick = m_remoteAck + 1;
+        const auto count = static_cast<std::uint8_t>(std::min<std::uint32_t>(m_confirmed[m_localPlayer] - m_remoteAck, MAX_INPUTS));
+        const std::uint32_t confirmedTick = getConfirmedTick();
+        const std::uint32_t hashTick = confirmedTick - confirmedTick % STATE_HASH_INTERVAL;
+
+        data[0] = MAGIC[0];
+        data[1] = MAGIC[1];
+        data[2] = VERSION;
+        data[3] = static_cast<std::uint8_t>(m_localPlayer);
+        writeUint32(data + 4, m_settings.sessionId);
+        writeUint64(data + 8, m_configHash);
+        writeUint32(data + 16, m_confirmed[1 - m_localPlayer]);
+        writeUint32(data + 20, firstTick);
+        writeUint32(data + 24, hashTick);
+        writeUint64(data + 28, hashTick != 0 ? m_stateHashes[hashTick % HISTORY] : 0);
+        data[36] = count;
+
+        for (std::uint32_t i = 0; i < count; i++)
+            data[HEADER_SIZE + i] = encodeInput(m_inputs[m_localPlayer][(firstTick + i) % HISTORY]);
+
+        m_link.send(data, HEADER_SIZE + count);
+    }
+}
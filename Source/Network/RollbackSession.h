@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_ROLLBACKSESSION_H
+#define CENTIPEDE_ROLLBACKSESSION_H
+
+#include "Source/Network/LinkSimulator.h"
+#include "Source/Network/UdpSocket.h"
+#include "Source/Simulation/World.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Parameters of a rollback session, both peers must use the same values
+     */
+    struct RollbackSettings {
+        unsigned int inputDelay = 2;  //!< The number of ticks local input is held back before it is simulated
+        unsigned int maxRollback = 8; //!< The maximum number of ticks the local simulation may run ahead of the remote input
+        std::uint32_t sessionId = 0;  //!< Identifies the game, datagrams of other games are ignored
+    };
+
+    /**
+     * @brief Runs a two player game over UDP with rollback
+     *
+     * Both peers run the same deterministic World and only exchange their
+     * inputs. Local input is simulated @a inputDelay ticks after it was
+     * read, which gives it time to reach the peer. When the input of the
+     * remote player for a tick has not arrived yet, it is predicted: the
+     * player keeps moving the way it last moved and does not fire
+     *
+     * A snapshot of the world is taken before every tick. When the remote
+     * input of a tick that was already simulated arrives and differs from
+     * the prediction, the world is restored to the snapshot of that tick
+     * and the ticks since then are simulated again with the corrected
+     * input, within the same call. At most @a maxRollback ticks are
+     * simulated again, the session does not advance any further until the
+     * remote input catches up
+     *
+     * Every datagram carries all the local input the peer has not
+     * acknowledged yet, so a lost datagram is recovered by the next one
+     *
+     * Both worlds must be created with the same settings, grid size and
+     * seed. Every datagram carries a hash of them, and the datagrams of a
+     * peer whose hash differs are refused (see isConfigMismatched). Every
+     * datagram also carries the state hash of the world at the latest
+     * confirmed tick that is a multiple of STATE_HASH_INTERVAL. A tick is
+     * confirmed once the input of both players is known and the world was
+     * simulated with it. A peer whose state hash differs for the same tick
+     * has desynchronized (see getDesyncTick)
+     */
+    class RollbackSession {
+    public:
+        static constexpr std::size_t NUM_PLAYERS = 2;             //!< The number of players in a session
+        static constexpr std::uint32_t STATE_HASH_INTERVAL = 60; //!< The number of ticks between state hashes compared with the peer
+
+        /**
+         * @brief Constructor
+         * @param settings The parameters of the session
+         * @param conditions The simulated conditions of the outgoing link
+         */
+        explicit RollbackSession(const RollbackSettings& settings, const LinkConditions& conditions = {});
+
+        /**
+         * @brief Open the socket of the session
+         * @param peerHost The IPv4 address of the peer
+         * @param basePort The port of player 0, player 1 uses the next port
+         * @param player The local player, or -1 to take the first player whose port is free
+         * @return True if the socket was opened, otherwise false
+         *
+         * Letting the port decide the player allows two instances of the
+         * game to be started on the same machine with the same settings
+         */
+        bool open(const std::string& peerHost, std::uint16_t basePort, int player = -1);
+
+        /**
+         * @brief Get the local player
+         * @return The index of the local player
+         */
+        unsigned int getLocalPlayer() const;
+
+        /**
+         * @brief Start the session
+         * @param world The world at the start of the game
+         *
+         * The settings and the state of the world are hashed, the peer is
+         * only accepted if its world hashes to the same value
+         */
+        void start(const World& world);
+
+        /**
+         * @brief Check if the session can advance by another tick
+         * @return False if the remote input is too far behind, otherwise true
+         */
+        bool canAdvance() const;
+
+        /**
+         * @brief Advance the world by one tick
+         * @param world The world of the session
+         * @param input The input of the local player
+         *
+         * Received remote input is applied first, which may roll the world
+         * back and simulate it again up to the current tick. This function
+         * must only be called if canAdvance returns true
+         */
+        void advance(World& world, const PlayerInput& input);
+
+        /**
+         * @brief Exchange input with the peer without advancing
+         *
+         * This function must be called once a frame, including frames in
+         * which the session cannot advance
+         */
+        void poll();
+
+        /**
+         * @brief Check if anything was received from the peer
+         * @return True if the peer sent a valid datagram, otherwise false
+         */
+        bool isPeerConnected() const;
+
+        /**
+         * @brief Check if the peer runs a different world
+         * @return True if a datagram was refused because the settings, grid
+         *         size or seed of the peer differ, otherwise false
+         */
+        bool isConfigMismatched() const;
+
+        /**
+         * @brief Get the first tick the worlds of the peers differed at
+         * @return The tick whose state hash differed from the hash of the peer, or 0 if none did
+         */
+        std::uint32_t getDesyncTick() const;
+
+        /**
+         * @brief Get the number of rollbacks
+         * @return The number of times the world was restored from a snapshot
+         */
+        std::uint64_t getRollbackCount() const;
+
+        /**
+         * @brief Get the number of ticks that were simulated again
+         * @return The number of ticks simulated again after rollbacks
+         */
+        std::uint64_t getResimulatedTickCount() const;
+
+        /**
+         * @brief Get the number of outgoing datagrams dropped by the link simulator
+         * @return The number of dropped datagrams
+         */
+        std::uint64_t getDropCount() const;
+
+    private:
+        /**
+         * @brief Get the inputs of a tick
+         * @param tick The tick
+         * @return The confirmed or predicted input of each player
+         */
+        World::PlayerInputs getInputs(std::uint32_t tick);
+
+        /**
+         * @brief Restore the earliest mispredicted tick and simulate up to the current tick
+         * @param world The world of the session
+         */
+        void rollback(World& world);
+
+        /**
+         * @brief Simulate a tick and remember the state hash it led to
+         * @param world The world of the session
+         * @param tick The tick to simulate
+         */
+        void simulate(World& world, std::uint32_t tick);
+
+        /**
+         * @brief Get the latest tick that will not be simulated again
+         * @return The latest tick simulated with the confirmed input of both players
+         */
+        std::uint32_t getConfirmedTick() const;
+
+        /**
+         * @brief Compare the state hash received from the peer with the local one
+         *
+         * The hashes are compared once the tick of the received hash is confirmed locally
+         */
+        void checkStateHash();
+
+        /**
+         * @brief Apply the input received from the peer
+         */
+        void receive();
+
+        /**
+         * @brief Send the local input the peer has not acknowledged
+         */
+        void send();
+
+    private:
+        static constexpr std::uint32_t HISTORY = 256; //!< The number of ticks of input kept per player
+        using InputHistory = std::array<PlayerInput, HISTORY>;
+
+        RollbackSettings m_settings;                        //!< The parameters of the session
+        UdpSocket m_socket;                                 //!< Exchanges datagrams with the peer
+        LinkSimulator m_link;                               //!< Simulates the conditions of the outgoing link
+        unsigned int m_localPlayer;                         //!< The index of the local player
+        std::uint32_t m_tick;                               //!< The number of ticks simulated
+        std::array<InputHistory, NUM_PLAYERS> m_inputs;     //!< The input used for each tick, by tick modulo HISTORY
+        std::array<std::uint32_t, NUM_PLAYERS> m_confirmed; //!< The last tick with known input of each player
+        std::uint32_t m_remoteAck;                          //!< The last tick of local input the peer acknowledged
+        std::uint32_t m_mispredictedTick;                   //!< The earliest simulated tick with a wrong prediction, or 0
+        std::uint64_t m_configHash;                         //!< The hash of the settings and the initial state of the world
+        std::array<std::uint64_t, HISTORY> m_stateHashes;   //!< The state hash after each tick, by tick modulo HISTORY
+        std::uint32_t m_remoteHashTick;                     //!< The tick of the latest state hash received from the peer, or 0
+        std::uint64_t m_remoteHash;                         //!< The latest state hash received from the peer
+        std::uint32_t m_checkedHashTick;                    //!< The tick of the last state hash compared with the peer
+        std::uint32_t m_desyncTick;                         //!< The first tick whose state hash differed from the peer, or 0
+        bool m_isConfigMismatched;                          //!< A flag indicating whether or not the peer runs a different world
+        std::vector<World> m_snapshots;                     //!< The world before each recent tick, by tick modulo size
+        bool m_isPeerConnected;                             //!< A flag indicating whether or not the peer was heard from
+        std::uint64_t m_rollbackCount;                      //!< The number of rollbacks
+        std::uint64_t m_resimulatedTicks;                   //!< The number of ticks simulated again
+    };
+}
+
+#endif //CENTIPEDE_ROLLBACKSESSION_H
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Network/UdpSocket.h"
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace centpd {
+    namespace {
+        const std::intptr_t NO_SOCKET = -1;
+
+        // Report the full size of a datagram that did not fit into the buffer
+#ifdef MSG_TRUNC
+        const int RECEIVE_FLAGS = MSG_TRUNC;
+#else
+        const int RECEIVE_FLAGS = 0;
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////
+    UdpSocket::UdpSocket() :
+        m_socket{NO_SOCKET},
+        m_peerHost{0},
+        m_peerPort{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    bool UdpSocket::bind(std::uint16_t port) {
+        close();
+
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (::WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+            return false;
+
+        auto socket = static_cast<std::intptr_t>(::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+        if (socket == static_cast<std::intptr_t>(INVALID_SOCKET)) {
+            ::WSACleanup();
+            return false;
+        }
+
+        u_long isNonBlocking = 1;
+        ::ioctlsocket(static_cast<SOCKET>(socket), FIONBIO, &isNonBlocking);
+#else
+        std::intptr_t socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (socket < 0)
+            return false;
+
+        ::fcntl(static_cast<int>(socket), F_SETFL, ::fcntl(static_cast<int>(socket), F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        m_socket = socket;
+        if (::bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool UdpSocket::setPeer(const std::string& host, std::uint16_t port) {
+        in_addr address{};
+        if (::inet_pton(AF_INET, host.c_str(), &address) != 1)
+            return false;
+
+        m_peerHost = address.s_addr;
+        m_peerPort = htons(port);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool UdpSocket::isOpen() const {
+        return m_socket != NO_SOCKET;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool UdpSocket::send(const void* data, std::size_t size) {
+        if (m_socket == NO_SOCKET || m_peerPort == 0)
+            return false;
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = m_peerPort;
+        address.sin_addr.s_addr = m_peerHost;
+
+        auto sent = ::sendto(m_socket, static_cast<const char*>(data), static_cast<int>(size), 0,
+            reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        return sent == static_cast<decltype(sent)>(size);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t UdpSocket::receive(void* buffer, std::size_t capacity) {
+        if (m_socket == NO_SOCKET)
+            return 0;
+
+        while (true) {
+            sockaddr_in sender{};
+            socklen_t senderSize = sizeof(sender);
+            auto received = ::recvfrom(m_socket, static_cast<char*>(buffer), static_cast<int>(capacity), RECEIVE_FLAGS,
+                reinterpret_cast<sockaddr*>(&sender), &senderSize);
+
+            // Nothing pending. On Windows a datagram that did not fit is also reported as an error
+            if (received < 0)
+                return 0;
+
+            const auto size = static_cast<std::size_t>(received);
+            if (sender.sin_addr.s_addr == m_peerHost && sender.sin_port == m_peerPort && size > 0 && size <= capacity)
+                return size;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void UdpSocket::close() {
+        if (m_socket == NO_SOCKET)
+            return;
+
+#ifdef _WIN32
+        ::closesocket(static_cast<SOCKET>(m_socket));
+        ::WSACleanup();
+#else
+        ::close(static_cast<int>(m_socket));
+#endif
+        m_socket = NO_SOCKET;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    UdpSocket::~UdpSocket() {
+        close();
+    }
+}
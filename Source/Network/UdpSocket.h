@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_UDPSOCKET_H
+#define CENTIPEDE_UDPSOCKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace centpd {
+    /**
+     * @brief Non-blocking UDP socket that exchanges datagrams with one peer
+     */
+    class UdpSocket {
+    public:
+        static constexpr std::size_t MAX_DATAGRAM_SIZE = 512; //!< The largest datagram the game sends
+
+        /**
+         * @brief Default constructor
+         */
+        UdpSocket();
+
+        /**
+         * @brief Bind the socket to a local port
+         * @param port The port to receive datagrams on
+         * @return True if the socket is bound, otherwise false
+         *
+         * The socket accepts datagrams on every local address. Binding
+         * fails if another socket already uses the port
+         */
+        bool bind(std::uint16_t port);
+
+        /**
+         * @brief Set the peer datagrams are sent to
+         * @param host The IPv4 address of the peer, e.g. "127.0.0.1"
+         * @param port The port of the peer
+         * @return True if the address is valid, otherwise false
+         *
+         * Only datagrams from the peer are received
+         */
+        bool setPeer(const std::string& host, std::uint16_t port);
+
+        /**
+         * @brief Check if the socket is bound
+         * @return True if the socket is bound, otherwise false
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Send a datagram to the peer
+         * @param data The datagram
+         * @param size The size of the datagram in bytes
+         * @return True if the datagram was handed to the network, otherwise false
+         *
+         * Like any UDP datagram, a sent datagram may be lost, duplicated or
+         * arrive out of order
+         */
+        bool send(const void* data, std::size_t size);
+
+        /**
+         * @brief Receive the next pending datagram
+         * @param buffer Receives the datagram
+         * @param capacity The size of @a buffer in bytes
+         * @return The size of the received datagram, or 0 if no datagram is pending
+         *
+         * This function never blocks. Datagrams larger than @a capacity
+         * and datagrams that do not come from the peer are discarded
+         */
+        std::size_t receive(void* buffer, std::size_t capacity);
+
+        /**
+         * @brief Close the socket
+         */
+        void close();
+
+        /**
+         * @brief Destructor
+         */
+        ~UdpSocket();
+
+        UdpSocket(const UdpSocket&) = delete;
+        UdpSocket& operator=(const UdpSocket&) = delete;
+
+    private:
+        std::intptr_t m_socket;   //!< The socket handle
+        std::uint32_t m_peerHost; //!< The address of the peer in network byte order
+        std::uint16_t m_peerPort; //!< The port of the peer in network byte order
+    };
+}
+
+#endif //CENTIPEDE_UDPSOCKET_H
@@ -23,294 +23,646 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Source/Scenes/GameplayScene.h"
-#include "Source/Actors/MushroomField.h"
-#include "Source/Actors/Mushroom.h"
 #include "Source/Actors/Player.h"
 #include "Source/Actors/Scorpion.h"
 #include "Source/Actors/Flea.h"
 #include "Source/Actors/CentipedeSegment.h"
 #include "Source/Common/Constants.h"
+#include "Source/Diagnostics/Metrics.h"
+#include "Source/Graphics/SpriteAtlas.h"
+#include "Source/GameLoop/AssetLoader.h"
 #include <IME/core/engine/Engine.h>
-#include <IME/utility/Utils.h>
-#include <IME/core/physics/grid/KeyboardGridMover.h>
-#include <cassert>
+#include <IME/core/input/Keyboard.h>
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
 
 namespace centpd {
     ///////////////////////////////////////////////////////////////
     namespace {
         const unsigned int TILE_SIZE = 16;
+
+        // The names of the actor kinds in memory reports
+        const char* const ACTOR_NAMES[] = {"Player", "Bullet", "CentipedeSegment", "Scorpion", "Flea"};
+        static_assert(std::size(ACTOR_NAMES) == static_cast<std::size_t>(ActorKind::Count), "Every actor kind needs a name");
+
+#ifndef CENTIPEDE_HEADLESS
+        ///////////////////////////////////////////////////////////////
+        template <typename T>
+        void animate(ime::GameObjectContainer& gameObjects, const std::string& group, float deltaTime) {
+            gameObjects.forEachInGroup(group, [deltaTime](ime::GameObject* actor) {
+                static_cast<T*>(actor)->animate(deltaTime);
+            });
+        }
+
+        ///////////////////////////////////////////////////////////////
+        ime::Vector2i toVector(Direction dir) {
+            return ime::Vector2i{getColOffset(dir), getRowOffset(dir)};
+        }
+
+        ///////////////////////////////////////////////////////////////
+        ime::GameObject::Ptr createView(ime::Scene& scene, ActorKind kind, const ActorArrays& actors, std::size_t index, int lives) {
+            switch (kind) {
+                case ActorKind::Player:
+                    return Player::create(scene, lives);
+                case ActorKind::Bullet: {
+                    Bullet::Ptr bullet = Bullet::create(scene);
+                    bullet->fire();
+                    return bullet;
+                }
+                case ActorKind::CentipedeSegment:
+                    return CentipedeSegment::create(scene, actors.type[index] == ActorType::CentipedeHead ?
+                        CentipedeSegment::Type::Head : CentipedeSegment::Type::Body);
+                case ActorKind::Scorpion: {
+                    Scorpion::Ptr scorpion = Scorpion::create(scene);
+                    // Horizontally flip the scorpion texture, by default the texture is facing left
+                    if (actors.dir[index] == Direction::Right)
+                        scorpion->getSprite().scale(-1.0f, 1.0f);
+
+                    return scorpion;
+                }
+                default:
+                    return Flea::create(scene);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::size_t getViewSize(ActorKind kind) {
+            switch (kind) {
+                case ActorKind::Player:           return sizeof(Player);
+                case ActorKind::Bullet:           return sizeof(Bullet);
+                case ActorKind::CentipedeSegment: return sizeof(CentipedeSegment);
+                case ActorKind::Scorpion:         return sizeof(Scorpion);
+                default:                          return sizeof(Flea);
+            }
+        }
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
-    GameplayScene::GameplayScene() :
-        m_shouldFire{false},
-        m_playerAreaHeight{0},
-        m_fleaSpawnTimer{nullptr}
+    struct GameplayScene::SceneMetrics {
+        static constexpr std::size_t NUM_KINDS = static_cast<std::size_t>(ActorKind::Count);
+
+        Metric& frameTime;
+        Metric& frames;
+        Metric& ticks;
+        Metric& tickRate;
+        Metric& bulletsFired;
+        Metric& level;
+        Metric& rollbacks;
+        Metric& resimulatedTicks;
+        Metric& stalledTicks;
+        Metric& autopilotDecisionTime;
+        Metric& autopilotOverBudget;
+        Metric& spectators;
+        Metric& spectatorStreamSize;
+        Metric& frameAllocations;
+        Metric& mushrooms;
+        Metric& views;
+        std::array<Metric*, NUM_KINDS> actors;
+        std::array<Metric*, NUM_KINDS> capacities;
+
+        ///////////////////////////////////////////////////////////////
+        explicit SceneMetrics(MetricRegistry& registry) :
+            frameTime{registry.add("centipede_frame_time_seconds", "Duration of the last frame", MetricType::Gauge)},
+            frames{registry.add("centipede_frames_total", "Number of frames rendered", MetricType::Counter)},
+            ticks{registry.add("centipede_ticks_total", "Number of simulation ticks", MetricType::Counter)},
+            tickRate{registry.add("centipede_tick_rate", "Simulation ticks per second", MetricType::Gauge)},
+            bulletsFired{registry.add("centipede_bullets_fired_total", "Number of bullets fired", MetricType::Counter)},
+            level{registry.add("centipede_level", "Current level", MetricType::Gauge)},
+            rollbacks{registry.add("centipede_rollbacks_total", "Number of times the simulation was rolled back", MetricType::Counter)},
+            resimulatedTicks{registry.add("centipede_resimulated_ticks_total", "Number of ticks simulated again after a rollback", MetricType::Counter)},
+            stalledTicks{registry.add("centipede_stalled_ticks_total", "Number of ticks skipped waiting for the remote player", MetricType::Counter)},
+            autopilotDecisionTime{registry.add("centipede_autopilot_decision_seconds", "Duration of the last autopilot decision", MetricType::Gauge)},
+            autopilotOverBudget{registry.add("centipede_autopilot_over_budget_total", "Number of autopilot decisions that exceeded the budget", MetricType::Counter)},
+            spectators{registry.add("centipede_spectators", "Connected spectators", MetricType::Gauge)},
+            spectatorStreamSize{registry.add("centipede_spectator_stream_bytes_total", "Size of the spectator stream", MetricType::Counter)},
+            frameAllocations{registry.add("centipede_frame_allocations", "Heap allocations in the last frame", MetricType::Gauge)},
+            mushrooms{registry.add("centipede_actors", "Live actors by kind", MetricType::Gauge, "kind=\"Mushroom\"")},
+            views{registry.add("centipede_game_objects", "Live game objects that display actors", MetricType::Gauge)},
+            actors{},
+            capacities{}
+        {
+            for (std::size_t k = 0; k < NUM_KINDS; k++) {
+                const std::string label = std::string("kind=\"") + ACTOR_NAMES[k] + "\"";
+                actors[k] = &registry.add("centipede_actors", "Live actors by kind", MetricType::Gauge, label);
+                capacities[k] = &registry.add("centipede_actor_pool_capacity", "Actors each kind can hold without allocating", MetricType::Gauge, label);
+            }
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////
+    GameplayScene::GameplayScene(FrameAllocations& frameAllocations) :
+        m_fireRequested{false},
+        m_movePressed{Direction::None},
+        m_isConfigMismatchReported{false},
+        m_isDesyncReported{false},
+        m_frameAllocations{frameAllocations}
+#ifndef CENTIPEDE_HEADLESS
+        , m_viewFrame{0},
+        m_memoryOverlay{nullptr}
+#endif
     {}
 
     ///////////////////////////////////////////////////////////////
-    GameplayScene::Ptr GameplayScene::create() {
-        return std::make_unique<GameplayScene>();
+    GameplayScene::Ptr GameplayScene::create(FrameAllocations& frameAllocations) {
+        return std::make_unique<GameplayScene>(frameAllocations);
     }
 
     ///////////////////////////////////////////////////////////////
     void GameplayScene::onInit() {
-        m_playerAreaHeight = sCache().getPref("PLAYER_AREA_HEIGHT").getValue<int>();
-        Constants::PLAYER_AREA_HEIGHT = m_playerAreaHeight;
+        Constants::PLAYER_AREA_HEIGHT = sCache().getPref("PLAYER_AREA_HEIGHT").getValue<int>();
+        m_clock.setTickRate(sCache().getPref("SIMULATION_TICK_RATE").getValue<unsigned int>());
+        m_memoryReportFile = sCache().getPref("MEMORY_REPORT_FILE").getValue<std::string>();
+        m_metrics = std::make_unique<SceneMetrics>(MetricRegistry::getGlobal());
+        m_metrics->tickRate.set(m_clock.getTickRate());
+
+        if (sCache().getPref("NETWORK_ENABLED").getValue<bool>())
+            createSession();
 
         createGrid();
+        createWorld();
+        createSpectatorServer();
+
+        if (sCache().getPref("AUTOPILOT").getValue<bool>()) {
+            const auto budget = std::chrono::microseconds(sCache().getPref("AUTOPILOT_BUDGET_US").getValue<unsigned int>());
+            m_autopilot = std::make_unique<Autopilot>(m_session ? m_session->getLocalPlayer() : 0, budget);
+        } else {
+            m_inputLatency = std::make_unique<InputLatency>(MetricRegistry::getGlobal(), m_session ? m_session->getLocalPlayer() : 0);
+        }
+
+        // Runs of two builds with the same seed and input can be diffed tick by tick to find where they diverge
+        const auto stateHashFile = sCache().getPref("STATE_HASH_FILE").getValue<std::string>();
+        if (!stateHashFile.empty()) {
+            m_stateHashFile.open(stateHashFile);
+            if (!m_stateHashFile)
+                std::cerr << "Failed to write the state hashes to " << stateHashFile << std::endl;
+        }
+
+        // Both peers of a network game must simulate with the same settings
+        if (sCache().getPref("HOT_RELOAD_SETTINGS").getValue<bool>() && !m_session) {
+            m_settingsWatcher = std::make_unique<SettingsWatcher>(Constants::SETTINGS_DIR + "GameSettings.txt", m_world->getSettings());
+            m_settingsWatcher->start();
+        }
+
+        auto captureInterval = sCache().getPref("CAPTURE_INTERVAL").getValue<unsigned int>();
+        if (captureInterval > 0) {
+            m_frameCapture = std::make_unique<FrameCapture>(AssetLoader::getImage(SpriteAtlas::getTexture()),
+                m_grid->getCols() * TILE_SIZE, m_grid->getRows() * TILE_SIZE,
+                sCache().getPref("CAPTURE_DIR").getValue<std::string>());
+            m_frameCapture->setInterval(captureInterval);
+
+            if (sCache().getPref("CAPTURE_FORMAT").getValue<std::string>() == "raw")
+                m_frameCapture->setFormat(FrameCapture::Format::Raw);
+        }
+
+#ifndef CENTIPEDE_HEADLESS
+#ifndef NDEBUG
+        gui().addWidget(ime::ui::Label::create(), "memoryOverlay");
+        m_memoryOverlay = gui().getWidget<ime::ui::Label>("memoryOverlay");
+        m_memoryOverlay->setTextSize(10);
+        m_memoryOverlay->setPosition(4.0f, 4.0f);
+#endif
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
     void GameplayScene::onEnter() {
-        createActors();
+        m_world->start();
+
+        if (m_session)
+            m_session->start(*m_world);
 
-        if (sCache().getPref("ENABLE_PLAYER").getValue<bool>()) {
-            // Shoot the players bullet when the user presses the shoot key
+        if (m_world->getSettings().enablePlayer) {
+            // Presses are timestamped when they are received, the world buffers them until they can take effect
             input().onKeyDown([this](ime::Keyboard::Key key) {
-                if (key == ime::Keyboard::Key::Space) {
-                    m_shouldFire = true;
-
-                    ime::GridMover* playerMover = gridMovers().findByTag("playerMover");
-                    // The bullet must also be in the grid, if shot while the player is
-                    // moving, it will not come out of the player as the player may be between grid cells
-                    if (!playerMover->isTargetMoving())
-                        fireBullet(gameObjects().findByTag<Player>("player"), playerMover->getCurrentTileIndex());
+                using Key = ime::Keyboard::Key;
+                const auto time = InputLatency::Clock::now();
+
+                if (key == Key::Space) {
+                    m_fireRequested = true;
+                    if (m_inputLatency)
+                        m_inputLatency->onFirePressed(time);
+                } else if (key == Key::Left || key == Key::Right || key == Key::Up || key == Key::Down) {
+                    m_movePressed = key == Key::Left ? Direction::Left : key == Key::Right ? Direction::Right : key == Key::Up ? Direction::Up : Direction::Down;
+                    if (m_inputLatency)
+                        m_inputLatency->onMovePressed(m_movePressed, time);
                 }
             });
         }
 
-        if (sCache().getPref("ENABLE_SCORPIONS").getValue<bool>()) {
-            auto scorpionSpawnInterval = sCache().getPref("SCORPION_SPAWN_INTERVAL").getValue<float>();
-            timer().setInterval(ime::seconds(scorpionSpawnInterval), [this] {
-                spawnScorpion();
-            });
-        }
-
-        if (sCache().getPref("ENABLE_FLEAS").getValue<bool>()) {
-            auto fleaSpawnInterval = sCache().getPref("FLEA_SPAWN_INTERVAL").getValue<float>();
-            m_fleaSpawnTimer = &timer().setInterval(ime::seconds(fleaSpawnInterval), [this] {
-                spawnFlea();
-            });
-        }
+        input().onKeyDown([this](ime::Keyboard::Key key) {
+            if (key == ime::Keyboard::Key::F9)
+                saveMemoryReport();
+#ifndef CENTIPEDE_HEADLESS
+            else if (key == ime::Keyboard::Key::F3 && m_memoryOverlay)
+                m_memoryOverlay->setVisible(!m_memoryOverlay->isVisible());
+#endif
+        });
 
         // Destroy inactive objects at the end of the each frame
         engine().onFrameEnd([this] {
             gameObjects().removeIf([](const ime::GameObject* actor) {
                 return !actor->isActive();
             });
+
+            m_frameAllocations.endFrame();
         });
     }
 
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::createGrid() {
-        createTilemap(TILE_SIZE, TILE_SIZE);
-        m_grid = std::make_unique<Grid>(tilemap(), gameObjects());
-        ime::Vector2u windowSize = engine().getWindow().getSize();
-        m_grid->create( windowSize.y / TILE_SIZE - ((m_grid->getRows() + 2) % TILE_SIZE), windowSize.x / TILE_SIZE - ((m_grid->getCols() + 3) % TILE_SIZE));
+    void GameplayScene::onUpdate(ime::Time deltaTime) {
+        applyReloadedSettings();
+
+        if (m_session)
+            m_session->poll();
+
+        unsigned int numTicks = m_clock.advance(deltaTime.asSeconds());
+        std::uint64_t firstTick = m_clock.getTickCount() - numTicks + 1;
+        for (auto i = 0u; i < numTicks; i++)
+            tick(firstTick + i);
+
+        if (m_session)
+            reportSessionErrors();
 
-        // Divide the grid into two sections (top and bottom) with invisible obstacles.
-        // However, note that only the Player character can collide with these invisible
-        // walls, other characters will simply pass through them like they are not there
-        const int row = (static_cast<int>(m_grid->getRows()) - 1) - m_playerAreaHeight;
-        for (int col = 0; col < m_grid->getCols(); col++) {
-            auto wall = ime::GameObject::create(*this);
-            wall->setAsObstacle(true);
-            wall->setCollisionGroup("invisibleWall");
-            m_grid->addActor(std::move(wall), ime::Index{row, col});
+        updateMetrics(deltaTime.asSeconds(), numTicks);
+
+#ifndef CENTIPEDE_HEADLESS
+        syncViews(m_clock.getInterpolationFactor());
+        updateMemoryOverlay();
+
+        animate<CentipedeSegment>(gameObjects(), "CentipedeSegment", deltaTime.asSeconds());
+        animate<Scorpion>(gameObjects(), "Scorpion", deltaTime.asSeconds());
+        animate<Flea>(gameObjects(), "Flea", deltaTime.asSeconds());
+
+        m_grid->update(m_world->getMushrooms());
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::reportSessionErrors() {
+        if (m_session->isConfigMismatched() && !m_isConfigMismatchReported) {
+            m_isConfigMismatchReported = true;
+            std::cerr << "The network peer uses different settings, grid size or seed, its input is refused" << std::endl;
+        }
+
+        if (m_session->getDesyncTick() != 0 && !m_isDesyncReported) {
+            m_isDesyncReported = true;
+            std::cerr << "The network game desynchronized at tick " << m_session->getDesyncTick() << std::endl;
         }
     }
 
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::createActors() {
-        if (sCache().getPref("ENABLE_MUSHROOMS").getValue<bool>())
-            MushroomField::create(*m_grid, sCache().getPref("NUM_MUSHROOMS").getValue<unsigned int>());
+    PlayerInput GameplayScene::readInput() {
+        using Key = ime::Keyboard::Key;
+
+        // Key presses are ignored while the autopilot plays
+        const bool fireRequested = m_fireRequested;
+        const Direction movePressed = m_movePressed;
+        m_fireRequested = false;
+        m_movePressed = Direction::None;
+
+        if (m_autopilot) {
+            const PlayerInput input = m_autopilot->decide(*m_world);
+            m_metrics->autopilotDecisionTime.set(std::chrono::duration<double>(m_autopilot->getLastDecisionTime()).count());
+            return input;
+        }
+
+        PlayerInput input;
+        if (ime::Keyboard::isKeyPressed(Key::Left))
+            input.move = Direction::Left;
+        else if (ime::Keyboard::isKeyPressed(Key::Right))
+            input.move = Direction::Right;
+        else if (ime::Keyboard::isKeyPressed(Key::Up))
+            input.move = Direction::Up;
+        else if (ime::Keyboard::isKeyPressed(Key::Down))
+            input.move = Direction::Down;
+        else
+            input.move = movePressed;
+
+        input.fire = fireRequested;
+        return input;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::tick(std::uint64_t tickNumber) {
+        // A network game waits for the remote player when it is too far ahead, the input is kept for the next tick
+        if (m_session && !m_session->canAdvance()) {
+            m_metrics->stalledTicks.increment();
+            return;
+        }
 
-        if (sCache().getPref("ENABLE_PLAYER").getValue<bool>())
-            createPlayer();
+        const PlayerInput input = readInput();
 
-        if (sCache().getPref("ENABLE_CENTIPEDES").getValue<bool>()) {
-            createCentipede();
+        if (m_session)
+            m_session->advance(*m_world, input);
+        else
+            m_world->tick(input);
+
+        if (m_spectatorServer)
+            m_spectatorServer->publish(*m_world);
+
+        if (m_inputLatency)
+            m_inputLatency->onTick(*m_world, InputLatency::Clock::now());
+
+        if (m_stateHashFile.is_open()) {
+            m_stateHashFile << m_world->getTickCount() << ' ' << std::hex << std::setw(16) << std::setfill('0')
+                << m_world->getStateHash() << std::dec << '\n';
         }
+
+        if (m_frameCapture && m_frameCapture->isDue(tickNumber))
+            captureFrame(tickNumber);
     }
 
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::createPlayer() {
-        auto startPos = ime::Index{static_cast<int>(m_grid->getRows() - 1), static_cast<int>((m_grid->getCols() - 1) / 2)};
-        auto lives = sCache().getPref("PLAYER_LIVES").getValue<int>();
-        auto* player = static_cast<Player*>(m_grid->addActor(Player::create(*this, lives), startPos));
-
-        // By default the player can fire a bullet, so we give them one
-        Bullet::Ptr bullet = Bullet::create(*this);
-        player->setBullet(bullet.get());
-        gameObjects().add(std::move(bullet));
-
-        // Players grid movement controller
-        auto playerSpeed = sCache().getPref("PLAYER_SPEED").getValue<float>();
-        auto playerMover = ime::KeyboardGridMover::create(tilemap(), player);
-        playerMover->setTag("playerMover");
-        playerMover->setMovementTrigger(ime::MovementTrigger::OnKeyDownHeld);
-        playerMover->setMaxLinearSpeed(ime::Vector2f{playerSpeed, playerSpeed});
-
-        // Since we are using ime::GridMover to move the bullet, it must be
-        // in the grid before starting the movement. But we want to fire only
-        // when the player is not moving so that the bullet appears to be coming
-        // out the mouth of the player
-        playerMover->onAdjacentMoveEnd([player, this](ime::Index index) {
-            fireBullet(player, index);
+    void GameplayScene::captureFrame(std::uint64_t tick) {
+#ifdef CENTIPEDE_HEADLESS
+        m_frameCapture->beginFrame();
+        m_worldRenderer.draw(*m_world, *m_frameCapture);
+        m_frameCapture->endFrame(tick);
+#else
+        // Capture the simulated state rather than an in-between frame, the mushrooms are never interpolated
+        syncViews(1.0f);
+        m_grid->update(m_world->getMushrooms());
+
+        m_frameCapture->beginFrame();
+
+#ifndef NDEBUG
+        m_frameCapture->drawGrid(m_grid->getRows(), m_grid->getCols(), TILE_SIZE);
+#endif
+
+        m_grid->forEachBatch([this](const std::vector<SpriteQuad>& quads) {
+            m_frameCapture->drawLayer(quads);
         });
 
-        gridMovers().addObject(std::move(playerMover));
+        m_frameCapture->endFrame(tick);
+#endif
     }
 
+#ifndef CENTIPEDE_HEADLESS
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::createCentipede() {
-        auto startPos = ime::Index{0, static_cast<int>((m_grid->getCols() - 1) / 2)};
-
-        ime::GameObject* segment = nullptr;
-        ime::GameObject* prevSegment = nullptr;
-        auto bodyCount = sCache().getPref("CENTIPEDE_LENGTH").getValue<unsigned int>();
-        for (auto i = 0u; i < bodyCount; i++) {
-            if (i == 0u)
-                segment = m_grid->addActor(CentipedeSegment::create(*this, CentipedeSegment::Type::Head), startPos);
-            else
-                segment = m_grid->addActor(CentipedeSegment::create(*this, CentipedeSegment::Type::Body), ime::Index{0, static_cast<int>(startPos.colm - i)});
-
-            ime::GridMover* gridMover = createGridMover("CENTIPEDE", segment);
-            static_cast<CentipedeSegment*>(segment)->setGridMover(gridMover);
-
-            static const bool isMushroomsEnabled = sCache().getPref("ENABLE_MUSHROOMS").getValue<bool>();
-            if (isMushroomsEnabled) {
-                // Replace shot segment with mushroom
-                segment->onPropertyChange("active", [this, segment](const ime::Property& property) {
-                    m_grid->addActor(Mushroom::create(*this), m_grid->getActorTile(segment));
-                });
-            }
+    void GameplayScene::syncViews(float alpha) {
+        m_viewFrame++;
+
+        for (std::size_t k = 0; k < static_cast<std::size_t>(ActorKind::Count); k++) {
+            const auto kind = static_cast<ActorKind>(k);
+            const ActorArrays& actors = m_world->getActors(kind);
+
+            for (std::size_t i = 0; i < actors.size(); i++) {
+                View& view = m_views[actors.id[i]];
+                if (!view.actor) {
+                    view.actor = static_cast<Actor*>(m_grid->addActor(createView(*this, kind, actors, i,
+                        m_world->getSettings().playerLives)));
+                    view.kind = kind;
+                }
 
-            if (prevSegment) {
-                static_cast<CentipedeSegment*>(prevSegment)->attachSegment(static_cast<CentipedeSegment*>(segment));
+                view.frame = m_viewFrame;
+
+                Position pos = m_world->getPosition(kind, i, alpha);
+                ime::Transform& transform = view.actor->getTransform();
+                if (transform.getPosition() != ime::Vector2f{pos.x, pos.y}) {
+                    transform.setPosition(pos.x, pos.y);
+                    view.actor->notify<ActorEvent::Moved>(transform.getPosition());
+                }
+
+                switch (kind) {
+                    case ActorKind::Player:
+                        static_cast<Player*>(view.actor)->setLives(m_world->getLives(i));
+                        break;
+                    case ActorKind::CentipedeSegment: {
+                        auto* segment = static_cast<CentipedeSegment*>(view.actor);
+                        segment->setType(actors.type[i] == ActorType::CentipedeHead ?
+                            CentipedeSegment::Type::Head : CentipedeSegment::Type::Body);
+                        segment->setDirection(toVector(actors.dir[i]));
+                        break;
+                    }
+                    default:
+                        break;
+                }
             }
+        }
 
-            prevSegment = segment;
+        // Views that were not visited no longer have an actor in the simulation
+        for (auto iter = m_views.begin(); iter != m_views.end();) {
+            if (iter->second.frame != m_viewFrame) {
+                iter->second.actor->deactivate();
+                iter = m_views.erase(iter);
+            } else
+                ++iter;
         }
+
+        syncHeldBullet();
     }
 
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::spawnScorpion() {
-        // The scorpion and the player do not interact directly, i.e. it must not enter the player area
-        int row = ime::utility::generateRandomNum(0,(static_cast<int>(m_grid->getRows()) - 1) - m_playerAreaHeight);
-
-        int colm;
-        ime::Vector2i moveDirection;
-        if (ime::utility::generateRandomNum(0, 1) == 0) { // Spawn from the left of the screen
-            colm = 0;
-            moveDirection = ime::Right;
-        } else { // Spawn from the right of the screen
-            colm = static_cast<int>(m_grid->getCols() - 1);
-            moveDirection = ime::Left;
+    void GameplayScene::syncHeldBullet() {
+        const ActorArrays& players = m_world->getActors(ActorKind::Player);
+        for (std::size_t i = 0; i < players.size(); i++) {
+            auto* player = static_cast<Player*>(m_views[players.id[i]].actor);
+            if (m_world->canShoot(i) && !player->canShoot()) {
+                Bullet::Ptr bullet = Bullet::create(*this);
+                player->setBullet(bullet.get());
+                m_grid->addActor(std::move(bullet));
+            } else if (!m_world->canShoot(i) && player->canShoot()) {
+                // The fired bullet has its own view, the held one is no longer needed
+                player->shoot()->deactivate();
+            }
         }
+    }
 
-        ime::GameObject* scorpion = m_grid->addActor(Scorpion::create(*this), ime::Index{row, colm});
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::updateMemoryOverlay() {
+        // The report allocates, refreshing it every frame would dominate the counts it shows
+        static const std::uint64_t REFRESH_INTERVAL = 30;
+        if (m_memoryOverlay && m_memoryOverlay->isVisible() && m_frameAllocations.getFrameCount() % REFRESH_INTERVAL == 0)
+            m_memoryOverlay->setText(createMemoryReport().toString());
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////
+    MemoryReport GameplayScene::createMemoryReport() const {
+        MemoryReport report;
+
+        // Simulation data
+        for (std::size_t k = 0; k < static_cast<std::size_t>(ActorKind::Count); k++) {
+            const ActorArrays& actors = m_world->getActors(static_cast<ActorKind>(k));
+            report.add(ACTOR_NAMES[k], actors.size(), actors.getMemoryUsage());
+        }
+
+        const MushroomField& mushrooms = m_world->getMushrooms();
+        report.add("Mushroom", mushrooms.getCount(), mushrooms.getMemoryUsage());
 
-        if (moveDirection == ime::Right) {
-            // Horizontally flip the scorpion texture, by default the texture is facing left
-            scorpion->getSprite().scale(-1.0f, 1.0f);
+#ifndef CENTIPEDE_HEADLESS
+        // Game objects, including their signals, listener slots and animators
+        std::size_t viewCounts[static_cast<std::size_t>(ActorKind::Count)] = {};
+        for (const auto& [id, view] : m_views)
+            viewCounts[static_cast<std::size_t>(view.kind)]++;
+
+        for (std::size_t k = 0; k < static_cast<std::size_t>(ActorKind::Count); k++) {
+            report.add(std::string(ACTOR_NAMES[k]) + "View", viewCounts[k],
+                viewCounts[k] * getViewSize(static_cast<ActorKind>(k)));
         }
+#endif
+
+        report.setAllocations(m_frameAllocations.getLastFrame(), m_frameAllocations.getPeakFrame(),
+            m_frameAllocations.getBudget());
 
-        createGridMover("SCORPION", scorpion, moveDirection);
+        return report;
     }
 
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::spawnFlea() {
-        ime::Index spawnPos{0, ime::utility::generateRandomNum(0, static_cast<int>(m_grid->getCols()) - 1)};
-        ime::GameObject* flea = m_grid->addActor(Flea::create(*this), spawnPos);
-        ime::GridMover* fleaMover = createGridMover("FLEA", flea, ime::Down);
-
-        // A new Flea is automatically spawned if the player kills the flea we are
-        // about to spawn. Since there can only be one Flea character at a time, we
-        // pause the spawn timer and resume it only if the active flea reaches the bottom of the screen
-        m_fleaSpawnTimer->pause();
-
-        // If the flea is killed by the player, immediately spawn another one
-        flea->onPropertyChange("active", [this, flea](const ime::Property& property) {
-            auto isActive = property.getValue<bool>();
-
-            if (!isActive) {
-                if (static_cast<Flea*>(flea)->getHitCount() == 2) // Flea killed by player
-                    spawnFlea();
-                else
-                    m_fleaSpawnTimer->restart();
-            }
-        });
+    void GameplayScene::updateMetrics(float frameTime, unsigned int numTicks) {
+        m_metrics->frameTime.set(frameTime);
+        m_metrics->frames.increment();
+        m_metrics->ticks.increment(numTicks);
+        m_metrics->bulletsFired.set(static_cast<double>(m_world->getBulletsFired()));
+        m_metrics->level.set(m_world->getLevel());
+
+        if (m_spectatorServer) {
+            m_metrics->spectators.set(static_cast<double>(m_spectatorServer->getSpectatorCount()));
+            m_metrics->spectatorStreamSize.set(static_cast<double>(m_spectatorServer->getStreamSize()));
+        }
 
-        static const bool isMushroomsEnabled = sCache().getPref("ENABLE_MUSHROOMS").getValue<bool>();
-        if (isMushroomsEnabled) {
-            // Randomly spawn Mushrooms as flea descends
-            fleaMover->onAdjacentMoveEnd([this] (ime::Index index) {
-                if (index.row != m_grid->getRows() - 1) { // Mushrooms forbidden in last row
-                    if (ime::utility::generateRandomNum(0, 100) >= 75 && !m_grid->isMushroomInCell(index)) {
-                        m_grid->addActor(Mushroom::create(*this), index);
-                    }
-                }
-            });
+        if (m_session) {
+            m_metrics->rollbacks.set(static_cast<double>(m_session->getRollbackCount()));
+            m_metrics->resimulatedTicks.set(static_cast<double>(m_session->getResimulatedTickCount()));
+        }
+
+        if (m_autopilot)
+            m_metrics->autopilotOverBudget.set(static_cast<double>(m_autopilot->getOverBudgetCount()));
+
+        m_metrics->frameAllocations.set(static_cast<double>(m_frameAllocations.getLastFrame().count));
+        m_metrics->mushrooms.set(static_cast<double>(m_world->getMushrooms().getCount()));
+
+        for (std::size_t k = 0; k < SceneMetrics::NUM_KINDS; k++) {
+            const ActorArrays& actors = m_world->getActors(static_cast<ActorKind>(k));
+            m_metrics->actors[k]->set(static_cast<double>(actors.size()));
+            m_metrics->capacities[k]->set(static_cast<double>(actors.capacity()));
         }
+
+#ifndef CENTIPEDE_HEADLESS
+        m_metrics->views.set(static_cast<double>(m_views.size()));
+#endif
     }
 
     ///////////////////////////////////////////////////////////////
-    void GameplayScene::fireBullet(Player* player, ime::Index index) {
-        if (m_shouldFire) {
-            m_shouldFire = false;
-            if (player->canShoot()) {
-                Bullet *bullet = player->shoot();
-                m_grid->addActor(bullet, index);
-
-                // Give the player another bullet, when this one is destroyed
-                bullet->onPropertyChange("active", [this](const ime::Property& property) {
-                    if (!property.getValue<bool>()) {
-                        auto *player = gameObjects().findByTag<Player>("player");
-                        if (player) {
-                            Bullet::Ptr bullet = Bullet::create(*this);
-                            player->setBullet(bullet.get());
-                            gameObjects().add(std::move(bullet));
-                        }
-                    }
-                });
+    void GameplayScene::applyReloadedSettings() {
+        WorldSettings settings;
+        if (!m_settingsWatcher || !m_settingsWatcher->poll(settings))
+            return;
 
-                // Create the bullet mover, at this point it no longer moves with the player
-                createGridMover("BULLET", bullet, ime::Up);
-            }
+        m_world->applySettings(settings);
+
+        if (settings.tickRate != m_clock.getTickRate()) {
+            m_clock.setTickRate(settings.tickRate);
+            m_metrics->tickRate.set(settings.tickRate);
         }
     }
 
     ///////////////////////////////////////////////////////////////
-    ime::GridMover* GameplayScene::createGridMover(const std::string& objType, ime::GameObject* target, ime::Vector2i dir) {
-        assert(target && "A grid mover target cannot be a nullptr");
-        ime::GridMover* gridMover = gridMovers().addObject(ime::GridMover::create(tilemap(), target));
-        auto speed = sCache().getPref(objType + "_SPEED").getValue<float>(); // e.g BULLET_SPEED, SCORPION_SPEED etc
-        gridMover->setMaxLinearSpeed(ime::Vector2f{speed, speed});
-
-        // Automatically destroy the grid mover when its target gets destroyed
-        target->onDestruction([gridMover, this] {
-            gridMovers().removeById(gridMover->getObjectId());
-        });
+    void GameplayScene::saveMemoryReport() const {
+        if (!m_memoryReportFile.empty() && m_world)
+            createMemoryReport().saveToFile(m_memoryReportFile);
+    }
 
-        if (dir != ime::Unknown) {
-            // Automatically move the target to the next adjacent cell
-            gridMover->onAdjacentMoveEnd([gridMover, dir](ime::Index) {
-                gridMover->requestDirectionChange(dir);
-            });
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::createGrid() {
+        createTilemap(TILE_SIZE, TILE_SIZE);
+#ifndef CENTIPEDE_HEADLESS
+        m_grid = std::make_unique<Grid>(tilemap(), gameObjects(), AssetLoader::getTexture(SpriteAtlas::getTexture()));
+#else
+        m_grid = std::make_unique<Grid>(tilemap(), gameObjects());
+#endif
+        ime::Vector2u windowSize = engine().getWindow().getSize();
+        m_grid->create( windowSize.y / TILE_SIZE - ((m_grid->getRows() + 2) % TILE_SIZE), windowSize.x / TILE_SIZE - ((m_grid->getCols() + 3) % TILE_SIZE));
+    }
 
-            // Start the movement
-            gridMover->requestDirectionChange(dir);
-        }
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::createWorld() {
+        WorldSettings settings;
+        settings.rows = m_grid->getRows();
+        settings.cols = m_grid->getCols();
+        settings.tileSize = TILE_SIZE;
+        settings.tickRate = m_clock.getTickRate();
+        settings.numPlayers = m_session ? static_cast<unsigned int>(RollbackSession::NUM_PLAYERS) : 1;
+        settings.playerAreaHeight = static_cast<unsigned int>(Constants::PLAYER_AREA_HEIGHT);
+        settings.numMushrooms = sCache().getPref("NUM_MUSHROOMS").getValue<unsigned int>();
+        settings.centipedeLength = sCache().getPref("CENTIPEDE_LENGTH").getValue<unsigned int>();
+        settings.centipedeLengthPerLevel = sCache().getPref("CENTIPEDE_LENGTH_PER_LEVEL").getValue<unsigned int>();
+        settings.playerLives = sCache().getPref("PLAYER_LIVES").getValue<int>();
+        settings.playerSpeed = sCache().getPref("PLAYER_SPEED").getValue<float>();
+        settings.bulletSpeed = sCache().getPref("BULLET_SPEED").getValue<float>();
+        settings.centipedeSpeed = sCache().getPref("CENTIPEDE_SPEED").getValue<float>();
+        settings.scorpionSpeed = sCache().getPref("SCORPION_SPEED").getValue<float>();
+        settings.fleaSpeed = sCache().getPref("FLEA_SPEED").getValue<float>();
+        settings.centipedeSpeedPerLevel = sCache().getPref("CENTIPEDE_SPEED_PER_LEVEL").getValue<float>();
+        settings.scorpionSpawnInterval = sCache().getPref("SCORPION_SPAWN_INTERVAL").getValue<float>();
+        settings.fleaSpawnInterval = sCache().getPref("FLEA_SPAWN_INTERVAL").getValue<float>();
+        settings.enablePlayer = sCache().getPref("ENABLE_PLAYER").getValue<bool>();
+        settings.enableMushrooms = sCache().getPref("ENABLE_MUSHROOMS").getValue<bool>();
+        settings.enableCentipedes = sCache().getPref("ENABLE_CENTIPEDES").getValue<bool>();
+        settings.enableScorpions = sCache().getPref("ENABLE_SCORPIONS").getValue<bool>();
+        settings.enableFleas = sCache().getPref("ENABLE_FLEAS").getValue<bool>();
+
+        // The peers of a network game must start from the same world, a local game is random unless a seed is set
+        if (m_session)
+            m_world = std::make_unique<World>(settings, sCache().getPref("NETWORK_SEED").getValue<unsigned int>());
+        else if (const auto seed = sCache().getPref("SIMULATION_SEED").getValue<unsigned int>(); seed != 0)
+            m_world = std::make_unique<World>(settings, seed);
+        else
+            m_world = std::make_unique<World>(settings, std::random_device{}());
+    }
 
-        // Some actors are destroyed when the reach the other side of the grid
-        if (objType != "PLAYER" && objType != "CENTIPEDE") {
-            gridMover->onGridBorderCollision([gridMover] {
-                gridMover->getTarget()->setActive(false);
-            });
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::createSpectatorServer() {
+        const auto file = sCache().getPref("SPECTATOR_FILE").getValue<std::string>();
+        const auto socket = sCache().getPref("SPECTATOR_SOCKET").getValue<std::string>();
+        const auto port = sCache().getPref("SPECTATOR_PORT").getValue<unsigned int>();
+        if (file.empty() && socket.empty() && port == 0)
+            return;
+
+        // Like the metrics, the stream is optional and the game runs normally without it
+        m_spectatorServer = std::make_unique<SpectatorServer>();
+        if (!file.empty() && !m_spectatorServer->openFile(file))
+            std::cerr << "Failed to write the spectator stream to " << file << std::endl;
+
+        if (!socket.empty() && !m_spectatorServer->listenUnix(socket))
+            std::cerr << "Failed to serve the spectator stream on " << socket << std::endl;
+        else if (socket.empty() && port > 0 && !m_spectatorServer->listenTcp(static_cast<std::uint16_t>(port)))
+            std::cerr << "Failed to serve the spectator stream on port " << port << std::endl;
+
+        if (!m_spectatorServer->isOpen())
+            m_spectatorServer.reset();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void GameplayScene::createSession() {
+        RollbackSettings settings;
+        settings.inputDelay = sCache().getPref("NETWORK_INPUT_DELAY").getValue<unsigned int>();
+        settings.maxRollback = sCache().getPref("NETWORK_MAX_ROLLBACK").getValue<unsigned int>();
+        settings.sessionId = sCache().getPref("NETWORK_SEED").getValue<unsigned int>();
+
+        LinkConditions conditions;
+        conditions.loss = sCache().getPref("NETWORK_SIM_LOSS").getValue<float>();
+        conditions.latency = sCache().getPref("NETWORK_SIM_LATENCY").getValue<float>();
+        conditions.jitter = sCache().getPref("NETWORK_SIM_JITTER").getValue<float>();
+
+        const auto host = sCache().getPref("NETWORK_HOST").getValue<std::string>();
+        const auto port = sCache().getPref("NETWORK_PORT").getValue<unsigned int>();
+        const auto player = sCache().getPref("NETWORK_PLAYER").getValue<int>();
+
+        // The game falls back to a single player game if the session cannot be opened
+        m_session = std::make_unique<RollbackSession>(settings, conditions);
+        if (!m_session->open(host, static_cast<std::uint16_t>(port), player)) {
+            std::cerr << "Failed to open a network session on port " << port << std::endl;
+            m_session.reset();
         }
+    }
 
-        return gridMover;
+    ///////////////////////////////////////////////////////////////
+    GameplayScene::~GameplayScene() {
+        saveMemoryReport();
     }
 }
@@ -26,10 +26,28 @@
 #define CENTIPEDE_GAMEPLAYSCENE_H
 
 #include "Source/Grid/Grid.h"
+#include "Source/GameLoop/SimulationClock.h"
+#include "Source/Simulation/World.h"
+#include "Source/Simulation/Autopilot.h"
+#include "Source/GameLoop/SettingsWatcher.h"
+#include "Source/Network/RollbackSession.h"
+#include "Source/Spectator/SpectatorServer.h"
+#include "Source/Diagnostics/FrameAllocations.h"
+#include "Source/Diagnostics/InputLatency.h"
+#include "Source/Diagnostics/MemoryReport.h"
+#include "Source/Graphics/FrameCapture.h"
 #include <IME/core/scene/Scene.h>
+#include <fstream>
+#include <unordered_map>
+
+#ifndef CENTIPEDE_HEADLESS
+#include <IME/ui/widgets/Label.h>
+#else
+#include "Source/Graphics/WorldRenderer.h"
+#endif
 
 namespace centpd {
-    class Player;
+    class Actor;
 
     /**
      * @brief Defines the main gameplay
@@ -40,14 +58,16 @@ namespace centpd {
 
         /**
          * @brief Constructor
+         * @param frameAllocations Counts the heap allocations of each frame
          */
-        GameplayScene();
+        explicit GameplayScene(FrameAllocations& frameAllocations);
 
         /**
          * @brief Create a scene
+         * @param frameAllocations Counts the heap allocations of each frame
          * @return A pointer to the created scene
          */
-        static GameplayScene::Ptr create();
+        static GameplayScene::Ptr create(FrameAllocations& frameAllocations);
 
         /**
          * @brief Initialize scene
@@ -59,6 +79,27 @@ namespace centpd {
          */
         void onEnter() override;
 
+        /**
+         * @brief Update the scene
+         * @param deltaTime Time passed since the last frame
+         *
+         * The time is converted into fixed simulation ticks, see SimulationClock
+         */
+        void onUpdate(ime::Time deltaTime) override;
+
+        /**
+         * @brief Get the live instances and memory of each actor type
+         * @return The memory used by the simulation and its game objects
+         */
+        MemoryReport createMemoryReport() const;
+
+        /**
+         * @brief Destructor
+         *
+         * Writes the final memory report to the file set by MEMORY_REPORT_FILE
+         */
+        ~GameplayScene() override;
+
     private:
         /**
          * @brief Create the gameplay grid
@@ -66,59 +107,142 @@ namespace centpd {
         void createGrid();
 
         /**
-         * @brief Create game objects
+         * @brief Create the gameplay simulation
+         */
+        void createWorld();
+
+        /**
+         * @brief Create the server that streams the game to spectators
+         *
+         * The server is only created if SPECTATOR_FILE, SPECTATOR_SOCKET or
+         * SPECTATOR_PORT is set
          */
-        void createActors();
+        void createSpectatorServer();
 
         /**
-         * @brief Create the player actor
+         * @brief Create the network session of a two player game
+         *
+         * The session is only created if NETWORK_ENABLED is set
          */
-        void createPlayer();
+        void createSession();
 
         /**
-         * @brief Create a Centipede
+         * @brief Report a peer with a different world or a desync of the network session
+         *
+         * Each error is reported once
          */
-        void createCentipede();
+        void reportSessionErrors();
 
         /**
-         * @brief Spawn a Scorpion
+         * @brief Get the input of the local player for the next tick
+         * @return The input of the local player
+         *
+         * The input comes from the autopilot when it is enabled, otherwise
+         * from the keyboard. A movement key pressed and released within a
+         * frame still counts as a move for the next tick
          */
-        void spawnScorpion();
+        PlayerInput readInput();
 
         /**
-         * @brief Spawn a Flea character
+         * @brief Advance the simulation by one fixed tick
+         * @param tickNumber The number of the tick, starting at 1
          */
-        void spawnFlea();
+        void tick(std::uint64_t tickNumber);
 
         /**
-         * @brief Fire the players bullet
-         * @param player The player whose bullet is to be fired
-         * @param index Where the bullet should be fired from
+         * @brief Write a memory report to the file set by MEMORY_REPORT_FILE
          *
-         * The bullet will only be fired if there is no active bullet (previously
-         * fired) in the game
+         * No report is written if the file name is empty
          */
-        void fireBullet(Player* player, ime::Index index);
+        void saveMemoryReport() const;
 
         /**
-         * @brief Create a grid mover for a character
-         * @param objType The type of the grid mover target in caps (e.g BULLET, PLAYER, SCORPION)
-         * @param target The character to be moved by the grid mover
-         * @param dir The direction in which the target moves in
-         * @return A grid mover initialized for the specified character
+         * @brief Update the exported metrics
+         * @param frameTime The duration of the frame in seconds
+         * @param numTicks The number of ticks simulated in the frame
+         */
+        void updateMetrics(float frameTime, unsigned int numTicks);
+
+        /**
+         * @brief Apply the settings reloaded since the last frame
+         *
+         * This function must be called between ticks
+         */
+        void applyReloadedSettings();
+
+        /**
+         * @brief Draw the current simulation state into a captured frame
+         * @param tick The tick the frame belongs to
+         *
+         * The simulation only build has no game objects, it draws the
+         * frame straight from the world (see WorldRenderer)
+         *
+         * @see FrameCapture
+         */
+        void captureFrame(std::uint64_t tick);
+
+#ifndef CENTIPEDE_HEADLESS
+        /**
+         * @brief Update the game objects from the state of the simulation
+         * @param alpha How far the current time is between the last tick and the next
          *
-         * Note that @a dir is specified by characters that only move in
-         * one direction until the end of their lifetime (e.g. a Bullet
-         * always moves upwards until it is destroyed)
+         * A game object is created for each new actor in the simulation and
+         * game objects whose actors no longer exist are deactivated
          */
-        ime::GridMover* createGridMover(const std::string& objType, ime::GameObject* target,
-            ime::Vector2i dir = ime::Unknown);
+        void syncViews(float alpha);
+
+        /**
+         * @brief Update the bullet the player is holding
+         *
+         * The held bullet only exists as a game object, in the simulation a
+         * bullet only exists once it has been fired
+         */
+        void syncHeldBullet();
+
+        /**
+         * @brief Update the text of the memory overlay
+         */
+        void updateMemoryOverlay();
+#endif
 
     private:
-        std::unique_ptr<Grid> m_grid;      //!< The gameplay grid
-        bool m_shouldFire;                 //!< A flag indicating whether or not the player should release its bullet
-        int m_playerAreaHeight;            //!< The height of the player area in tiles
-        ime::Timer* m_fleaSpawnTimer;      //!< Controls when a Flea is spawned in the game
+        struct SceneMetrics;
+
+#ifndef CENTIPEDE_HEADLESS
+        /**
+         * @brief A game object that displays an actor of the simulation
+         */
+        struct View {
+            Actor* actor;        //!< The game object
+            ActorKind kind;      //!< The kind of actor displayed by the game object
+            std::uint64_t frame; //!< The last sync the actor existed in
+        };
+#endif
+
+        std::unique_ptr<Grid> m_grid;                        //!< The gameplay grid
+        std::unique_ptr<World> m_world;                      //!< The gameplay simulation
+        bool m_fireRequested;                                //!< A flag indicating whether or not the player pressed the fire key since the last tick
+        Direction m_movePressed;                             //!< The last movement key pressed since the last tick, Direction::None if there was none
+        bool m_isConfigMismatchReported;                     //!< A flag indicating whether or not a peer with a different world was reported
+        bool m_isDesyncReported;                             //!< A flag indicating whether or not a desync of the network session was reported
+        SimulationClock m_clock;                             //!< Converts frame time into fixed simulation ticks
+        FrameAllocations& m_frameAllocations;                //!< Counts the heap allocations of each frame
+        std::string m_memoryReportFile;                      //!< The file memory reports are written to
+        std::unique_ptr<SceneMetrics> m_metrics;             //!< The exported metrics updated by the scene
+        std::unique_ptr<SettingsWatcher> m_settingsWatcher;  //!< Reloads the settings when the settings file changes
+        std::unique_ptr<RollbackSession> m_session;          //!< Exchanges inputs with the remote player in a network game
+        std::unique_ptr<SpectatorServer> m_spectatorServer;  //!< Streams the changes of each tick to spectators
+        std::unique_ptr<Autopilot> m_autopilot;              //!< Plays the local player instead of the keyboard when enabled
+        std::unique_ptr<InputLatency> m_inputLatency;        //!< Measures the time from key presses to their effect
+        std::ofstream m_stateHashFile;                       //!< Receives the state hash of each tick when STATE_HASH_FILE is set
+        std::unique_ptr<FrameCapture> m_frameCapture;        //!< Writes simulation frames to the disk when capturing is enabled
+#ifndef CENTIPEDE_HEADLESS
+        std::unordered_map<std::uint32_t, View> m_views;     //!< Game objects by the id of the actor they display
+        std::uint64_t m_viewFrame;                           //!< The number of times the views have been synced
+        ime::ui::Label* m_memoryOverlay;                     //!< Shows the memory report in debug builds
+#else
+        WorldRenderer m_worldRenderer;                       //!< Draws captured frames from the world
+#endif
     };
 }
 
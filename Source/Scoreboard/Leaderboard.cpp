@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Scoreboard/Leaderboard.h"
+#include <algorithm>
+#include <cassert>
+
+namespace centpd {
+    ///////////////////////////////////////////////////////////////
+    void Leaderboard::add(const Score &score) {
+        const auto row = static_cast<std::uint32_t>(m_values.size());
+        m_values.push_back(score.getValue());
+        m_levels.push_back(score.getLevel());
+        m_owners.push_back(intern(score.getOwner()));
+
+        if (score.getLevel() >= m_levelIndices.size())
+            m_levelIndices.resize(score.getLevel() + 1);
+
+        m_levelIndices[score.getLevel()].entries.push_back(IndexEntry{score.getValue(), row});
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void Leaderboard::reserve(std::size_t capacity) {
+        m_values.reserve(capacity);
+        m_levels.reserve(capacity);
+        m_owners.reserve(capacity);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t Leaderboard::getSize() const {
+        return m_values.size();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t Leaderboard::countAbove(int value) const {
+        // No branches and a narrow accumulator per block, so that the loop compiles to vector compares and adds
+        const std::int32_t* values = m_values.data();
+        const std::size_t size = m_values.size();
+        const std::size_t BLOCK_SIZE = 1u << 16;
+        std::size_t count = 0;
+
+        for (std::size_t block = 0; block < size; block += BLOCK_SIZE) {
+            const std::size_t end = std::min(size, block + BLOCK_SIZE);
+            std::uint32_t blockCount = 0;
+            for (std::size_t i = block; i < end; i++)
+                blockCount += static_cast<std::uint32_t>(values[i] > value);
+
+            count += blockCount;
+        }
+
+        return count;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t Leaderboard::getRank(int value) const {
+        return countAbove(value) + 1;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t Leaderboard::countAbove(unsigned int level, int value) const {
+        const LevelIndex* index = getIndex(level);
+        if (!index)
+            return 0;
+
+        auto end = std::partition_point(index->entries.begin(), index->entries.end(),
+            [value](const IndexEntry& entry) { return entry.value > value; });
+
+        return static_cast<std::size_t>(end - index->entries.begin());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t Leaderboard::getRank(unsigned int level, int value) const {
+        return countAbove(level, value) + 1;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::vector<Score> Leaderboard::getTop(unsigned int level, std::size_t count) const {
+        std::vector<Score> scores;
+        const LevelIndex* index = getIndex(level);
+        if (!index)
+            return scores;
+
+        scores.reserve(std::min(count, index->entries.size()));
+        for (std::size_t i = 0; i < index->entries.size() && i < count; i++) {
+            const std::uint32_t row = index->entries[i].row;
+            Score score;
+            score.setValue(m_values[row]);
+            score.setLevel(m_levels[row]);
+            score.setOwner(m_ownerNames[m_owners[row]]);
+            scores.push_back(score);
+        }
+
+        return scores;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::string &Leaderboard::getOwnerName(OwnerId owner) const {
+        assert(owner < m_ownerNames.size() && "Unknown owner");
+        return m_ownerNames[owner];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const Leaderboard::LevelIndex* Leaderboard::getIndex(unsigned int level) const {
+        if (level >= m_levelIndices.size() || m_levelIndices[level].entries.empty())
+            return nullptr;
+
+        // New entries are sorted on their own and merged into the sorted entries
+        LevelIndex& index = m_levelIndices[level];
+        if (index.sortedCount != index.entries.size()) {
+            auto sortedEnd = index.entries.begin() + static_cast<std::ptrdiff_t>(index.sortedCount);
+            std::sort(sortedEnd, index.entries.end(), isHigher);
+            std::inplace_merge(index.entries.begin(), sortedEnd, index.entries.end(), isHigher);
+            index.sortedCount = index.entries.size();
+        }
+
+        return &index;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool Leaderboard::isHigher(const IndexEntry &lhs, const IndexEntry &rhs) {
+        return lhs.value > rhs.value || (lhs.value == rhs.value && lhs.row < rhs.row);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Leaderboard::OwnerId Leaderboard::intern(const std::string &name) {
+        auto found = m_ownerIds.find(name);
+        if (found != m_ownerIds.end())
+            return found->second;
+
+        const auto owner = static_cast<OwnerId>(m_ownerNames.size());
+        m_ownerNames.push_back(name);
+        m_ownerIds.emplace(name, owner);
+        return owner;
+    }
+}
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_LEADERBOARD_H
+#define CENTIPEDE_LEADERBOARD_H
+
+#include "Source/Scoreboard/Score.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Stores scores by column for fast rank and per level queries
+     *
+     * The value, the level and the owner of the scores are kept in three
+     * separate arrays, with the owner interned to a small id. Ranking a
+     * value over all scores is a branch free count over the value array
+     * alone, which release builds vectorize. Each level also has an index
+     * of its scores sorted from highest to lowest, so that rank and top
+     * queries for a level are a binary search or a copy of the front of
+     * the index, independent of the number of scores on other levels
+     *
+     * Scores added to a level are merged into its index by the next query
+     * of that level, so adding many scores costs a single sort. A
+     * leaderboard must not be used from several threads at once, not even
+     * for queries
+     */
+    class Leaderboard {
+    public:
+        using OwnerId = std::uint32_t; //!< Interned owner name
+
+        /**
+         * @brief Add a score
+         * @param score The score to add
+         */
+        void add(const Score& score);
+
+        /**
+         * @brief Reserve space for a number of scores
+         * @param capacity The number of scores to reserve space for
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Get the number of scores
+         * @return The number of scores on all levels
+         */
+        std::size_t getSize() const;
+
+        /**
+         * @brief Count the scores that are higher than a value
+         * @param value The value to compare with
+         * @return The number of scores on all levels whose value is greater than @a value
+         */
+        std::size_t countAbove(int value) const;
+
+        /**
+         * @brief Get the rank a value has among all scores
+         * @param value The value to rank
+         * @return The rank, 1 if no score is higher than @a value
+         */
+        std::size_t getRank(int value) const;
+
+        /**
+         * @brief Count the scores of a level that are higher than a value
+         * @param level The level of the scores
+         * @param value The value to compare with
+         * @return The number of scores on @a level whose value is greater than @a value
+         */
+        std::size_t countAbove(unsigned int level, int value) const;
+
+        /**
+         * @brief Get the rank a value has among the scores of a level
+         * @param level The level of the scores
+         * @param value The value to rank
+         * @return The rank, 1 if no score on @a level is higher than @a value
+         */
+        std::size_t getRank(unsigned int level, int value) const;
+
+        /**
+         * @brief Get the highest scores of a level
+         * @param level The level of the scores
+         * @param count The maximum number of scores to get
+         * @return The highest scores of @a level, highest first. Scores
+         *         with the same value are in the order they were added
+         */
+        std::vector<Score> getTop(unsigned int level, std::size_t count) const;
+
+        /**
+         * @brief Get the name of an interned owner
+         * @param owner The id of the owner
+         * @return The name of the owner
+         */
+        const std::string& getOwnerName(OwnerId owner) const;
+
+    private:
+        /**
+         * @brief An entry of the index of a level
+         */
+        struct IndexEntry {
+            std::int32_t value; //!< The value of the score
+            std::uint32_t row;  //!< The index of the score in the columns
+        };
+
+        /**
+         * @brief The scores of one level, sorted from highest to lowest
+         */
+        struct LevelIndex {
+            std::vector<IndexEntry> entries; //!< Sorted entries followed by entries that are not merged yet
+            std::size_t sortedCount = 0;     //!< The number of sorted entries
+        };
+
+        /**
+         * @brief Check if an index entry ranks before another
+         * @param lhs The first entry
+         * @param rhs The second entry
+         * @return True if @a lhs has the higher value, or the same value and was added first
+         */
+        static bool isHigher(const IndexEntry& lhs, const IndexEntry& rhs);
+
+        /**
+         * @brief Get the sorted index of a level
+         * @param level The level
+         * @return The index of @a level, or nullptr if the level has no scores
+         *
+         * Entries added since the last query of the level are merged first
+         */
+        const LevelIndex* getIndex(unsigned int level) const;
+
+        /**
+         * @brief Get the id of an owner, interning the name if it is new
+         * @param name The name of the owner
+         * @return The id of the owner
+         */
+        OwnerId intern(const std::string& name);
+
+    private:
+        std::vector<std::int32_t> m_values;                  //!< The value of each score
+        std::vector<std::uint32_t> m_levels;                 //!< The level of each score
+        std::vector<OwnerId> m_owners;                       //!< The owner of each score
+        std::vector<std::string> m_ownerNames;               //!< The name of each owner id
+        std::unordered_map<std::string, OwnerId> m_ownerIds; //!< The id of each owner name
+        mutable std::vector<LevelIndex> m_levelIndices;      //!< The index of each level, merged lazily by queries
+    };
+}
+
+#endif //CENTIPEDE_LEADERBOARD_H
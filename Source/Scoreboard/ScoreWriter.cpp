@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Scoreboard/ScoreWriter.h"
+#include "Source/Diagnostics/AllocationCounter.h"
+#include "Source/Diagnostics/Metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace centpd {
+    namespace {
+        // How long the writer sleeps before checking the queue without being woken up
+        const auto WAKE_INTERVAL = std::chrono::milliseconds(50);
+
+        // How long the writer waits before retrying a failed write
+        const auto RETRY_INTERVAL = std::chrono::seconds(1);
+
+        ///////////////////////////////////////////////////////////////
+        void writeDurably(const std::string& filename, const std::string& contents) {
+            const std::string tempFilename = filename + ".tmp";
+            std::FILE* file = std::fopen(tempFilename.c_str(), "wb");
+            if (!file)
+                throw std::runtime_error("Cannot open " + tempFilename);
+
+            bool isWritten = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size() && std::fflush(file) == 0;
+#ifdef _WIN32
+            isWritten = isWritten && ::_commit(::_fileno(file)) == 0;
+#else
+            isWritten = isWritten && ::fsync(::fileno(file)) == 0;
+#endif
+            isWritten = std::fclose(file) == 0 && isWritten;
+            if (!isWritten)
+                throw std::runtime_error("Cannot write " + tempFilename);
+
+            // The rename replaces the old file in one step, a crash leaves either the old or the new scores
+            std::filesystem::rename(tempFilename, filename);
+
+#ifndef _WIN32
+            // The rename itself is only durable once the directory is synced
+            std::string directory = std::filesystem::path(filename).parent_path().string();
+            int dir = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+            if (dir >= 0) {
+                ::fsync(dir);
+                ::close(dir);
+            }
+#endif
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    ScoreWriter::ScoreWriter(std::string filename, std::vector<Score> scores) :
+        m_filename{std::move(filename)},
+        m_scores{std::move(scores)},
+        m_pushedCount{0},
+        m_writtenCount{0},
+        m_writeCount{0},
+        m_isStopped{false}
+    {
+        std::sort(m_scores.begin(), m_scores.end(), std::greater<>());
+        m_writer = std::thread(&ScoreWriter::run, this);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool ScoreWriter::push(const Score &score) {
+        if (!m_queue.push(score))
+            return false;
+
+        // The writer is woken up without taking the lock, a missed notification delays it by at most WAKE_INTERVAL
+        m_pushedCount.fetch_add(1, std::memory_order_release);
+        m_wakeUp.notify_one();
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool ScoreWriter::waitUntilWritten(std::chrono::milliseconds timeout) {
+        const std::uint64_t pushedCount = m_pushedCount.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeUp.notify_one();
+        return m_written.wait_for(lock, timeout, [this, pushedCount] { return m_writtenCount >= pushedCount; });
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t ScoreWriter::getWriteCount() const {
+        return m_writeCount.load();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::string ScoreWriter::serialize(const std::vector<Score> &scores) {
+        std::string contents;
+        for (const auto& score : scores) {
+            if (!contents.empty())
+                contents += "\n";
+
+            contents += score.getOwner() + ":" + std::to_string(score.getValue()) + " " + std::to_string(score.getLevel());
+        }
+
+        return contents;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void ScoreWriter::run() {
+        // Writes happen whenever a score is pushed, they must not show up in the allocation counts of the frames
+        AllocationCounter::setThreadExcluded(true);
+
+        std::uint64_t unwrittenCount = 0;
+        bool isStopped = false;
+
+        while (!isStopped) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wakeUp.wait_for(lock, unwrittenCount > 0 ? RETRY_INTERVAL : WAKE_INTERVAL,
+                    [this] { return m_isStopped || !m_queue.isEmpty(); });
+                isStopped = m_isStopped;
+            }
+
+            // Everything that is waiting goes into one write, the scores are kept highest first
+            Score score;
+            while (m_queue.pop(score)) {
+                m_scores.insert(std::upper_bound(m_scores.begin(), m_scores.end(), score, std::greater<>()), score);
+                unwrittenCount++;
+            }
+
+            if (unwrittenCount > 0 && write()) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_writtenCount += unwrittenCount;
+                unwrittenCount = 0;
+                m_written.notify_all();
+            }
+        }
+
+        if (unwrittenCount > 0)
+            std::cerr << unwrittenCount << " high scores were not written to " << m_filename << std::endl;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool ScoreWriter::write() {
+        try {
+            writeDurably(m_filename, serialize(m_scores));
+        } catch (const std::exception& e) {
+            std::cerr << "High scores not written: " << e.what() << std::endl;
+            return false;
+        }
+
+        static Metric& writes = MetricRegistry::getGlobal().add("centipede_leaderboard_writes_total",
+            "Number of times the high scores file was written", MetricType::Counter);
+        writes.increment();
+        m_writeCount++;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    ScoreWriter::~ScoreWriter() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopped = true;
+            m_wakeUp.notify_all();
+        }
+
+        m_writer.join();
+    }
+}
@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SCOREWRITER_H
+#define CENTIPEDE_SCOREWRITER_H
+
+#include "Source/Scoreboard/Score.h"
+#include "Source/Scoreboard/SpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Writes high scores to the disk on a background thread
+     *
+     * The game thread pushes finished scores into a lock-free queue and
+     * carries on. The writer thread takes every score that is waiting,
+     * merges them into the high scores and writes the whole list with a
+     * single durable write: the list goes to a temporary file which is
+     * synced to the disk and then renamed over the high scores file, so
+     * the file is never left half written. Scores that arrive during a
+     * write are written together in the next one
+     *
+     * A failed write is reported and retried later. Destroying the writer
+     * writes the scores that are still waiting before it returns
+     */
+    class ScoreWriter {
+    public:
+        static constexpr std::size_t QUEUE_CAPACITY = 64; //!< The maximum number of scores waiting to be written
+
+        /**
+         * @brief Constructor
+         * @param filename The high scores file, including the path
+         * @param scores The high scores already in the file
+         */
+        ScoreWriter(std::string filename, std::vector<Score> scores);
+
+        /**
+         * @brief Queue a score for writing
+         * @param score The score to write
+         * @return True if the score was queued, or false if the queue is full
+         *
+         * This function never blocks and must only be called by one thread
+         */
+        bool push(const Score& score);
+
+        /**
+         * @brief Wait until the queued scores are on the disk
+         * @param timeout The maximum time to wait
+         * @return True if every score pushed before the call was written, or false on timeout
+         */
+        bool waitUntilWritten(std::chrono::milliseconds timeout);
+
+        /**
+         * @brief Get the number of times the file was written
+         * @return The number of successful writes
+         */
+        std::uint64_t getWriteCount() const;
+
+        /**
+         * @brief Serialize high scores in the format of the high scores file
+         * @param scores The scores to serialize, highest first
+         * @return One "owner:value level" line per score
+         */
+        static std::string serialize(const std::vector<Score>& scores);
+
+        /**
+         * @brief Destructor
+         *
+         * Writes the queued scores and stops the writer thread
+         */
+        ~ScoreWriter();
+
+    private:
+        /**
+         * @brief Write batches of scores until stopped
+         */
+        void run();
+
+        /**
+         * @brief Write the high scores to the disk
+         * @return True if the file was written, otherwise false
+         */
+        bool write();
+
+    private:
+        std::string m_filename;                   //!< The high scores file
+        std::vector<Score> m_scores;              //!< The high scores, only used by the writer thread
+        SpscQueue<Score, QUEUE_CAPACITY> m_queue; //!< Scores waiting to be written
+        std::atomic<std::uint64_t> m_pushedCount; //!< The number of scores pushed
+        std::uint64_t m_writtenCount;             //!< The number of pushed scores that are on the disk
+        std::atomic<std::uint64_t> m_writeCount;  //!< The number of successful writes
+        std::mutex m_mutex;                       //!< Guards the written count and the stop flag
+        std::condition_variable m_wakeUp;         //!< Signalled when a score is pushed or the writer should stop
+        std::condition_variable m_written;        //!< Signalled when scores were written
+        bool m_isStopped;                         //!< A flag indicating whether or not the writer should exit
+        std::thread m_writer;                     //!< Writes the scores
+    };
+}
+
+#endif //CENTIPEDE_SCOREWRITER_H
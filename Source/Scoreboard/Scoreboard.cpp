@@ -23,6 +23,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Source/Scoreboard/Scoreboard.h"
+#include "Source/Diagnostics/Metrics.h"
 #include <IME/utility/DiskFileReader.h>
 #include <algorithm>
 
@@ -46,13 +47,31 @@ namespace centpd {
             score.setValue(std::stoi(line.substr(posOfSpaceBetweenNameAndScore + 1, posOfSpaceBetweenScoreAndLevel)));
             score.setLevel(std::stoi(scoreAndLevel.substr(posOfSpaceBetweenScoreAndLevel + 1)));
             highScores_.push_back(score);
+            leaderboard_.add(score);
         }
     }
 
+    ///////////////////////////////////////////////////////////////
+    void Scoreboard::startBackgroundWrites() {
+        if (!writer_)
+            writer_ = std::make_unique<ScoreWriter>(highScoresFile_, highScores_);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool Scoreboard::waitUntilWritten(std::chrono::milliseconds timeout) {
+        return !writer_ || writer_->waitUntilWritten(timeout);
+    }
+
     ///////////////////////////////////////////////////////////////
     void Scoreboard::addScore(const Score &score) {
         highScores_.push_back(score);
         std::sort(std::begin(highScores_), std::end(highScores_),std::greater<>());
+        leaderboard_.add(score);
+
+        if (writer_) {
+            while (!writer_->push(score))
+                writer_->waitUntilWritten(std::chrono::milliseconds(100));
+        }
     }
 
     ///////////////////////////////////////////////////////////////
@@ -67,6 +86,9 @@ namespace centpd {
 
     ///////////////////////////////////////////////////////////////
     void Scoreboard::updateHighScoreFile() {
+        if (writer_)
+            return;
+
         auto newHighscoreList = std::stringstream();
         newHighscoreList << highScores_.front().getOwner() + ":" + std::to_string(highScores_.front().getValue()) + " " + std::to_string(highScores_.front().getLevel());
         std::for_each(++highScores_.begin(), highScores_.end(),[&](auto& score) {
@@ -74,6 +96,15 @@ namespace centpd {
         });
 
         ime::utility::DiskFileReader().writeToFile(newHighscoreList, highScoresFile_);
+
+        static Metric& writes = MetricRegistry::getGlobal().add("centipede_leaderboard_writes_total",
+            "Number of times the high scores file was written", MetricType::Counter);
+        writes.increment();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const Leaderboard &Scoreboard::getLeaderboard() const {
+        return leaderboard_;
     }
 
     ///////////////////////////////////////////////////////////////
@@ -26,6 +26,9 @@
 #define CENTIPEDE_SCOREBOARD_H
 
 #include "Source/Scoreboard/Score.h"
+#include "Source/Scoreboard/Leaderboard.h"
+#include "Source/Scoreboard/ScoreWriter.h"
+#include <memory>
 #include <vector>
 #include <string>
 #include <functional>
@@ -53,12 +56,34 @@ namespace centpd {
          */
         void load();
 
+        /**
+         * @brief Write added scores to the disk on a background thread
+         *
+         * From now on every added score is queued for a ScoreWriter and
+         * updateHighScoreFile no longer writes on the calling thread. The
+         * queued scores are written at the latest when the Scoreboard is
+         * destroyed. This function should be called after load
+         */
+        void startBackgroundWrites();
+
+        /**
+         * @brief Wait until the added scores are on the disk
+         * @param timeout The maximum time to wait
+         * @return True if every added score was written, or false on timeout
+         *
+         * This function returns true immediately if background writes are
+         * not enabled
+         */
+        bool waitUntilWritten(std::chrono::milliseconds timeout);
+
         /**
          * @brief Add a score to the Scoreboard
          * @param score Scoreboard to be added
          *
          * The Scoreboard is updated after the score is added. In addition,
-         * note that the Scoreboard sorts entries in descending order
+         * note that the Scoreboard sorts entries in descending order. With
+         * background writes the score is also queued for writing, this
+         * only blocks if ScoreWriter::QUEUE_CAPACITY scores are still waiting
          */
         void addScore(const Score &score);
 
@@ -82,10 +107,17 @@ namespace centpd {
          * This function will write the current top scores to the file
          * provided during instantiation. The file is updated only if
          * the current score is greater than the lowest high score from
-         * the last file read
+         * the last file read. With background writes this function does
+         * nothing, the scores were queued when they were added
          */
         void updateHighScoreFile();
 
+        /**
+         * @brief Get the scores stored by column
+         * @return The loaded and added scores, for rank and per level queries
+         */
+        const Leaderboard& getLeaderboard() const;
+
         /**
          * @brief Execute a function for each score in the Scoreboard
          * @param callback Function to be executed
@@ -93,8 +125,10 @@ namespace centpd {
         void forEachScore(std::function<void(const Score&)> callback);
 
     private:
-        std::vector<Score> highScores_; //!< High scores read from dis
-        std::string highScoresFile_;    //!< High scores file to be read/written
+        std::vector<Score> highScores_;       //!< High scores read from dis
+        std::string highScoresFile_;          //!< High scores file to be read/written
+        std::unique_ptr<ScoreWriter> writer_; //!< Writes added scores in the background when enabled
+        Leaderboard leaderboard_;             //!< The scores by column
     };
 }
 
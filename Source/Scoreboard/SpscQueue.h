@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPSCQUEUE_H
+#define CENTIPEDE_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace centpd {
+    /**
+     * @brief A bounded lock-free queue for one producer and one consumer thread
+     * @tparam T The type of the queued values
+     * @tparam Capacity The maximum number of queued values, a power of two
+     *
+     * The values live in a ring buffer allocated with the queue. The
+     * producer only writes the tail and the consumer only writes the head,
+     * so neither ever waits for the other: push fails when the queue is
+     * full and pop fails when it is empty
+     */
+    template <typename T, std::size_t Capacity>
+    class SpscQueue {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of two");
+
+    public:
+        /**
+         * @brief Add a value to the back of the queue
+         * @param value The value to add
+         * @return True if the value was added, or false if the queue is full
+         *
+         * This function must only be called by the producer thread
+         */
+        bool push(const T& value) {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+                return false;
+
+            m_values[tail & (Capacity - 1)] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Take the value at the front of the queue
+         * @param value Receives the value
+         * @return True if a value was taken, or false if the queue is empty
+         *
+         * This function must only be called by the consumer thread
+         */
+        bool pop(T& value) {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            value = std::move(m_values[head & (Capacity - 1)]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Check if the queue is empty
+         * @return True if the queue has no values, otherwise false
+         *
+         * The result may be out of date as soon as it is returned
+         */
+        bool isEmpty() const {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::array<T, Capacity> m_values{};             //!< The ring buffer
+        alignas(64) std::atomic<std::size_t> m_head{0}; //!< The number of values taken, written by the consumer
+        alignas(64) std::atomic<std::size_t> m_tail{0}; //!< The number of values added, written by the producer
+    };
+}
+
+#endif //CENTIPEDE_SPSCQUEUE_H
@@ -0,0 +1,234 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Simulation/ActorStore.h"
+#include <cassert>
+#include <iterator>
+
+namespace centpd {
+    namespace {
+        /**
+         * @brief The collision layer and default collision mask of a kind
+         */
+        struct KindLayers {
+            std::uint32_t category; //!< The layer of the kind
+            std::uint32_t mask;     //!< The layers new actors of the kind interact with
+        };
+
+        // Indexed by ActorKind
+        const KindLayers KIND_LAYERS[] = {
+            {CollisionLayer::Player, CollisionLayer::Mushroom | CollisionLayer::PlayerWall},
+            {CollisionLayer::Bullet, CollisionLayer::Mushroom | CollisionLayer::CentipedeSegment | CollisionLayer::Scorpion | CollisionLayer::Flea},
+            {CollisionLayer::CentipedeSegment, CollisionLayer::Mushroom | CollisionLayer::Bullet},
+            {CollisionLayer::Scorpion, CollisionLayer::Mushroom | CollisionLayer::Bullet},
+            {CollisionLayer::Flea, CollisionLayer::Bullet}
+        };
+
+        static_assert(std::size(KIND_LAYERS) == static_cast<std::size_t>(ActorKind::Count), "Every kind needs collision layers");
+
+        ///////////////////////////////////////////////////////////////
+        template <typename T>
+        void compactArray(std::vector<T>& array, const std::vector<std::int32_t>& remap, std::size_t newSize) {
+            for (std::size_t i = 0; i < remap.size(); i++) {
+                if (remap[i] != ActorArrays::NO_LINK)
+                    array[static_cast<std::size_t>(remap[i])] = array[i];
+            }
+
+            array.resize(newSize);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t ActorArrays::add(std::uint32_t actorId, int tileRow, int tileCol, Direction direction, std::uint8_t actorType) {
+        id.push_back(actorId);
+        row.push_back(static_cast<std::int16_t>(tileRow));
+        col.push_back(static_cast<std::int16_t>(tileCol));
+        remaining.push_back(0);
+        prevX.push_back(0);
+        prevY.push_back(0);
+        dir.push_back(direction);
+        nextDir.push_back(Direction::None);
+        type.push_back(actorType);
+        hits.push_back(0);
+        flags.push_back(0);
+        active.push_back(1);
+        link.push_back(NO_LINK);
+        turnCol.push_back(NO_TURN);
+        mask.push_back(defaultMask);
+        return id.size() - 1;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool ActorArrays::compact(std::vector<std::int32_t>& remap) {
+        remap.resize(size());
+
+        std::int32_t newSize = 0;
+        for (std::size_t i = 0; i < active.size(); i++)
+            remap[i] = active[i] ? newSize++ : NO_LINK;
+
+        if (static_cast<std::size_t>(newSize) == size()) {
+            remap.clear();
+            return false;
+        }
+
+        const auto count = static_cast<std::size_t>(newSize);
+        compactArray(id, remap, count);
+        compactArray(row, remap, count);
+        compactArray(col, remap, count);
+        compactArray(remaining, remap, count);
+        compactArray(prevX, remap, count);
+        compactArray(prevY, remap, count);
+        compactArray(dir, remap, count);
+        compactArray(nextDir, remap, count);
+        compactArray(type, remap, count);
+        compactArray(hits, remap, count);
+        compactArray(flags, remap, count);
+        compactArray(active, remap, count);
+        compactArray(link, remap, count);
+        compactArray(turnCol, remap, count);
+        compactArray(mask, remap, count);
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void ActorArrays::clear() {
+        id.clear();
+        row.clear();
+        col.clear();
+        remaining.clear();
+        prevX.clear();
+        prevY.clear();
+        dir.clear();
+        nextDir.clear();
+        type.clear();
+        hits.clear();
+        flags.clear();
+        active.clear();
+        link.clear();
+        turnCol.clear();
+        mask.clear();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t ActorArrays::size() const {
+        return id.size();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void ActorArrays::reserve(std::size_t capacity) {
+        id.reserve(capacity);
+        row.reserve(capacity);
+        col.reserve(capacity);
+        remaining.reserve(capacity);
+        prevX.reserve(capacity);
+        prevY.reserve(capacity);
+        dir.reserve(capacity);
+        nextDir.reserve(capacity);
+        type.reserve(capacity);
+        hits.reserve(capacity);
+        flags.reserve(capacity);
+        active.reserve(capacity);
+        link.reserve(capacity);
+        turnCol.reserve(capacity);
+        mask.reserve(capacity);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t ActorArrays::capacity() const {
+        return id.capacity();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t ActorArrays::getMemoryUsage() const {
+        return id.capacity() * sizeof(std::uint32_t) + row.capacity() * sizeof(std::int16_t)
+            + col.capacity() * sizeof(std::int16_t) + remaining.capacity() * sizeof(std::uint16_t)
+            + prevX.capacity() * sizeof(std::int32_t) + prevY.capacity() * sizeof(std::int32_t)
+            + dir.capacity() * sizeof(Direction) + nextDir.capacity() * sizeof(Direction)
+            + type.capacity() + hits.capacity() + flags.capacity() + active.capacity()
+            + link.capacity() * sizeof(std::int32_t) + turnCol.capacity() * sizeof(std::int16_t)
+            + mask.capacity() * sizeof(std::uint32_t);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    ActorStore::ActorStore() {
+        for (std::size_t kind = 0; kind < NUM_KINDS; kind++) {
+            m_actors[kind].category = KIND_LAYERS[kind].category;
+            m_actors[kind].defaultMask = KIND_LAYERS[kind].mask;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    ActorArrays &ActorStore::get(ActorKind kind) {
+        assert(kind != ActorKind::Count && "Invalid actor kind");
+        return m_actors[static_cast<std::size_t>(kind)];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const ActorArrays &ActorStore::get(ActorKind kind) const {
+        assert(kind != ActorKind::Count && "Invalid actor kind");
+        return m_actors[static_cast<std::size_t>(kind)];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void ActorStore::compact() {
+        for (std::size_t kind = 0; kind < NUM_KINDS; kind++) {
+            ActorArrays& actors = m_actors[kind];
+            std::vector<std::int32_t>& remap = m_remaps[kind];
+            if (!actors.compact(remap))
+                continue;
+
+            // Links between actors of the same kind (e.g. centipede segments)
+            if (static_cast<ActorKind>(kind) != ActorKind::Bullet) {
+                for (auto& link : actors.link) {
+                    if (link != ActorArrays::NO_LINK)
+                        link = remap[static_cast<std::size_t>(link)];
+                }
+            }
+        }
+
+        // Bullets link to the player that fired them
+        const std::vector<std::int32_t>& playerRemap = getRemap(ActorKind::Player);
+        if (!playerRemap.empty()) {
+            for (auto& owner : get(ActorKind::Bullet).link) {
+                if (owner != ActorArrays::NO_LINK)
+                    owner = playerRemap[static_cast<std::size_t>(owner)];
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<std::int32_t> &ActorStore::getRemap(ActorKind kind) const {
+        return m_remaps[static_cast<std::size_t>(kind)];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void ActorStore::clear() {
+        for (auto& actors : m_actors)
+            actors.clear();
+
+        for (auto& remap : m_remaps)
+            remap.clear();
+    }
+}
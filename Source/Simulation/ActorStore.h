@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_ACTORSTORE_H
+#define CENTIPEDE_ACTORSTORE_H
+
+#include "Source/Simulation/Direction.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief The kinds of actors in the simulation
+     */
+    enum class ActorKind : std::uint8_t {
+        Player,
+        Bullet,
+        CentipedeSegment,
+        Scorpion,
+        Flea,
+        Count
+    };
+
+    /**
+     * @brief Kind specific values of ActorArrays::type
+     */
+    struct ActorType {
+        static constexpr std::uint8_t CentipedeHead = 0; //!< Segment at the front of a centipede
+        static constexpr std::uint8_t CentipedeBody = 1; //!< Segment following another segment
+    };
+
+    /**
+     * @brief Kind specific bits of ActorArrays::flags
+     */
+    struct ActorFlag {
+        static constexpr std::uint8_t ShouldFire = 1;    //!< Player fires as soon as it is in a tile and has no bullet in flight
+        static constexpr std::uint8_t SwitchingRows = 1; //!< Centipede segment is moving diagonally to another row
+        static constexpr std::uint8_t Descending = 2;    //!< Centipede segment moves down when it switches rows
+    };
+
+    /**
+     * @brief Collision layer bits of ActorArrays::category and ActorArrays::mask
+     *
+     * Every kind is in one layer, its category. An actor interacts with the
+     * layers in its mask, two actors collide when each is in the mask of
+     * the other. Mushrooms and the wall of the player area are tiles rather
+     * than actors, an actor is blocked by them when their layer is in its mask
+     */
+    struct CollisionLayer {
+        static constexpr std::uint32_t None = 0;                   //!< No layer
+        static constexpr std::uint32_t Player = 1u << 0;           //!< Players
+        static constexpr std::uint32_t Bullet = 1u << 1;           //!< Bullets
+        static constexpr std::uint32_t CentipedeSegment = 1u << 2; //!< Centipede segments
+        static constexpr std::uint32_t Scorpion = 1u << 3;         //!< Scorpions
+        static constexpr std::uint32_t Flea = 1u << 4;             //!< Fleas
+        static constexpr std::uint32_t Mushroom = 1u << 5;         //!< Tiles with a mushroom
+        static constexpr std::uint32_t PlayerWall = 1u << 6;       //!< Tiles above the player area
+    };
+
+    /**
+     * @brief Simulation data of all the actors of one kind
+     *
+     * The data is stored as a structure of arrays: element i of every
+     * array belongs to the same actor. Passes over the actors touch only
+     * the arrays they need and walk them front to back. An actor costs
+     * 34 bytes (the sum of the element sizes of the arrays below), so a
+     * full grid of actors fits comfortably in the L2 cache
+     *
+     * An actor is moving when @a remaining is not zero. It is then on its
+     * way from the tile behind it (opposite to @a dir) to @a row, @a col.
+     * The tile an actor is moving to is considered occupied by the actor
+     *
+     * @a prevX and @a prevY only serve rendering, they are not part of
+     * the state hash of the world
+     */
+    struct ActorArrays {
+        static constexpr std::int32_t NO_LINK = -1;
+        static constexpr std::int16_t NO_TURN = -1;
+
+        std::uint32_t category = CollisionLayer::None;    //!< Collision layer of the kind
+        std::uint32_t defaultMask = CollisionLayer::None; //!< Collision mask of new actors
+
+        std::vector<std::uint32_t> id;        //!< Unique id of the actor, never reused
+        std::vector<std::int16_t> row;        //!< Row of the tile occupied by the actor
+        std::vector<std::int16_t> col;        //!< Column of the tile occupied by the actor
+        std::vector<std::uint16_t> remaining; //!< Distance left to the occupied tile in World::TILE_UNITS
+        std::vector<std::int32_t> prevX;      //!< Horizontal position at the start of the tick in World::TILE_UNITS
+        std::vector<std::int32_t> prevY;      //!< Vertical position at the start of the tick in World::TILE_UNITS
+        std::vector<Direction> dir;           //!< Current movement direction
+        std::vector<Direction> nextDir;       //!< Direction to take after the current move, e.g. a buffered turn of a player (kind specific)
+        std::vector<std::uint8_t> type;       //!< Kind specific type, e.g. head or body for a centipede segment
+        std::vector<std::uint8_t> hits;       //!< Number of times the actor was hit by a bullet
+        std::vector<std::uint8_t> flags;      //!< Kind specific state flags
+        std::vector<std::uint8_t> active;     //!< 1 if the actor is alive, inactive actors are removed by compact()
+        std::vector<std::int32_t> link;       //!< Index of a related actor (kind specific) or NO_LINK
+        std::vector<std::int16_t> turnCol;    //!< Column a centipede segment turns in next, or NO_TURN if not known yet (kind specific)
+        std::vector<std::uint32_t> mask;      //!< Collision layers the actor interacts with, see CollisionLayer
+
+        /**
+         * @brief Add an actor
+         * @param actorId The unique id of the actor
+         * @param tileRow The row of the tile the actor starts in
+         * @param tileCol The column of the tile the actor starts in
+         * @param direction The initial movement direction
+         * @param actorType The kind specific type of the actor
+         * @return The index of the added actor
+         */
+        std::size_t add(std::uint32_t actorId, int tileRow, int tileCol, Direction direction, std::uint8_t actorType = 0);
+
+        /**
+         * @brief Remove the inactive actors
+         * @param remap Receives the new index of each old index, or NO_LINK if it was removed
+         * @return True if at least one actor was removed, otherwise false
+         *
+         * The relative order of the remaining actors is preserved and links
+         * between actors of this kind are updated. Links to actors of other
+         * kinds must be updated by the caller using @a remap
+         */
+        bool compact(std::vector<std::int32_t>& remap);
+
+        /**
+         * @brief Remove all actors
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of actors
+         * @return The number of actors, including inactive ones
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Reserve space for a number of actors
+         * @param capacity The number of actors to reserve space for
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Get the number of actors the arrays can hold without growing
+         * @return The capacity of the arrays
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @brief Get the memory used by the arrays
+         * @return The size of the allocated storage of all the arrays in bytes
+         */
+        std::size_t getMemoryUsage() const;
+    };
+
+    /**
+     * @brief Owns the arrays of every actor kind
+     */
+    class ActorStore {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Sets the collision layer and the default collision mask of each kind
+         */
+        ActorStore();
+
+        /**
+         * @brief Get the actors of a kind
+         * @param kind The kind of actors to get
+         * @return The actors of the given kind
+         */
+        ActorArrays& get(ActorKind kind);
+        const ActorArrays& get(ActorKind kind) const;
+
+        /**
+         * @brief Remove the inactive actors of every kind
+         *
+         * Bullet links (which refer to their owning player) are remapped
+         * when players are removed
+         */
+        void compact();
+
+        /**
+         * @brief Get the index remap produced by the last compact() of a kind
+         * @param kind The kind to get the remap of
+         * @return The remap, empty if nothing of this kind was removed
+         */
+        const std::vector<std::int32_t>& getRemap(ActorKind kind) const;
+
+        /**
+         * @brief Remove all actors
+         */
+        void clear();
+
+    private:
+        static constexpr std::size_t NUM_KINDS = static_cast<std::size_t>(ActorKind::Count);
+        std::array<ActorArrays, NUM_KINDS> m_actors;                //!< Arrays of each kind
+        std::array<std::vector<std::int32_t>, NUM_KINDS> m_remaps;  //!< Scratch index remaps, reused between passes
+    };
+}
+
+#endif //CENTIPEDE_ACTORSTORE_H
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Simulation/Autopilot.h"
+#include <cstdlib>
+#include <limits>
+
+namespace centpd {
+    namespace {
+        const Direction MOVES[] = {Direction::None, Direction::Left, Direction::Right, Direction::Up, Direction::Down};
+        const int FLEA_LOOKAHEAD = 3; // Number of tiles below a flea that are dangerous
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Autopilot::Autopilot(std::size_t player, Clock::duration budget) :
+        m_player{player},
+        m_budget{budget},
+        m_lastDecision{Clock::duration::zero()},
+        m_overBudgetCount{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    PlayerInput Autopilot::decide(const World& world) {
+        const auto start = Clock::now();
+        const ActorArrays& players = world.getActors(ActorKind::Player);
+        PlayerInput input;
+
+        if (m_player >= players.size() || !players.active[m_player])
+            return input;
+
+        const WorldSettings& settings = world.getSettings();
+        const int wallRow = world.getWallRow();
+        const int row = players.row[m_player];
+        const int col = players.col[m_player];
+        m_danger.assign((settings.rows - wallRow) * settings.cols, 0);
+
+        // Line up under the nearest threat above the player. A moving segment is aimed at where it will be when the bullet arrives
+        int aimCol = col;
+        int nearest = std::numeric_limits<int>::max();
+        bool isOverBudget = false;
+
+        for (ActorKind kind : {ActorKind::CentipedeSegment, ActorKind::Flea, ActorKind::Scorpion}) {
+            const ActorArrays& threats = world.getActors(kind);
+            for (std::size_t i = 0; i < threats.size(); i++) {
+                if (!threats.active[i])
+                    continue;
+
+                markDanger(world, kind, i);
+                if (threats.row[i] >= row)
+                    continue;
+
+                const int distance = (row - threats.row[i]) + std::abs(col - threats.col[i]);
+                if (distance < nearest) {
+                    nearest = distance;
+                    aimCol = threats.col[i];
+
+                    if (kind == ActorKind::CentipedeSegment && world.getStep(ActorKind::Bullet) > 0) {
+                        const int lead = (row - threats.row[i]) * world.getStep(kind) / world.getStep(ActorKind::Bullet);
+                        aimCol += getColOffset(threats.dir[i]) * lead;
+                    }
+                }
+            }
+
+            if (Clock::now() - start > m_budget) {
+                isOverBudget = true;
+                break;
+            }
+        }
+
+        // Take the safe move that gets closest to the aim, staying low to keep away from the centipede
+        int bestCost = std::numeric_limits<int>::max();
+        for (Direction move : MOVES) {
+            const int targetRow = row + getRowOffset(move);
+            const int targetCol = col + getColOffset(move);
+
+            if (move != Direction::None && (targetRow <= wallRow || targetRow >= static_cast<int>(settings.rows)
+                || targetCol < 0 || targetCol >= static_cast<int>(settings.cols) || world.isMushroomAt(targetRow, targetCol)))
+            {
+                continue;
+            }
+
+            const int cost = (isDangerous(world, targetRow, targetCol) ? 1000 : 0)
+                + 10 * std::abs(aimCol - targetCol)
+                + (static_cast<int>(settings.rows) - 1 - targetRow);
+
+            if (cost < bestCost) {
+                bestCost = cost;
+                input.move = move;
+            }
+        }
+
+        input.fire = nearest != std::numeric_limits<int>::max() && world.canShoot(m_player);
+
+        m_lastDecision = Clock::now() - start;
+        if (isOverBudget || m_lastDecision > m_budget)
+            m_overBudgetCount++;
+
+        return input;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Autopilot::Clock::duration Autopilot::getLastDecisionTime() const {
+        return m_lastDecision;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t Autopilot::getOverBudgetCount() const {
+        return m_overBudgetCount;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void Autopilot::markDanger(const World& world, ActorKind kind, std::size_t index) {
+        const ActorArrays& threats = world.getActors(kind);
+        const int wallRow = world.getWallRow();
+        const int cols = static_cast<int>(world.getSettings().cols);
+        const int row = threats.row[index];
+        const int col = threats.col[index];
+
+        auto mark = [&](int r, int c) {
+            if (r >= wallRow && r < static_cast<int>(world.getSettings().rows) && c >= 0 && c < cols)
+                m_danger[(r - wallRow) * cols + c] = 1;
+        };
+
+        mark(row, col);
+        mark(row + getRowOffset(threats.dir[index]), col + getColOffset(threats.dir[index]));
+
+        // A segment may turn down at any tile and a flea drops straight down
+        if (kind == ActorKind::CentipedeSegment)
+            mark(row + 1, col);
+        else if (kind == ActorKind::Flea) {
+            for (int r = row + 1; r <= row + FLEA_LOOKAHEAD; r++)
+                mark(r, col);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool Autopilot::isDangerous(const World& world, int row, int col) const {
+        const int wallRow = world.getWallRow();
+        return m_danger[(row - wallRow) * static_cast<int>(world.getSettings().cols) + col] != 0;
+    }
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_AUTOPILOT_H
+#define CENTIPEDE_AUTOPILOT_H
+
+#include "Source/Simulation/World.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Plays a player without anyone at the keyboard
+     *
+     * The autopilot reads the world before each tick and produces the
+     * input a human would: it keeps out of the way of the centipede
+     * segments and fleas in the player area, lines up under the nearest
+     * threat, leading moving segments, and fires whenever a threat is
+     * above it, which also clears mushrooms out of its way
+     *
+     * A decision walks the actors a bounded number of times and should
+     * take a few microseconds. If a decision takes longer than the budget
+     * anyway, the remaining kinds of threats are ignored and the overrun
+     * is counted. Apart from such overruns the same world always produces
+     * the same decision
+     */
+    class Autopilot {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Constructor
+         * @param player The index of the player to control
+         * @param budget The time a decision may take
+         */
+        explicit Autopilot(std::size_t player = 0, Clock::duration budget = std::chrono::microseconds(50));
+
+        /**
+         * @brief Decide the input of the player for the next tick
+         * @param world The world before the tick
+         * @return The input of the player
+         */
+        PlayerInput decide(const World& world);
+
+        /**
+         * @brief Get the time the last decision took
+         * @return The duration of the last decision
+         */
+        Clock::duration getLastDecisionTime() const;
+
+        /**
+         * @brief Get the number of decisions that exceeded the budget
+         * @return The number of decisions that took longer than the budget
+         */
+        std::uint64_t getOverBudgetCount() const;
+
+    private:
+        /**
+         * @brief Mark the tiles a threat occupies or is about to enter
+         * @param world The world
+         * @param kind The kind of the threat
+         * @param index The index of the threat
+         */
+        void markDanger(const World& world, ActorKind kind, std::size_t index);
+
+        /**
+         * @brief Check if a tile is about to be occupied by a threat
+         * @param world The world
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if the tile is dangerous, otherwise false
+         */
+        bool isDangerous(const World& world, int row, int col) const;
+
+    private:
+        std::size_t m_player;               //!< The index of the controlled player
+        Clock::duration m_budget;           //!< The time a decision may take
+        Clock::duration m_lastDecision;     //!< The time the last decision took
+        std::uint64_t m_overBudgetCount;    //!< The number of decisions that exceeded the budget
+        std::vector<std::uint8_t> m_danger; //!< Dangerous tiles of the player area and the row above it, row by row
+    };
+}
+
+#endif //CENTIPEDE_AUTOPILOT_H
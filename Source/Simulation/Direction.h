@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_DIRECTION_H
+#define CENTIPEDE_DIRECTION_H
+
+#include <cstdint>
+
+namespace centpd {
+    /**
+     * @brief Movement direction of an actor in the grid
+     *
+     * Rows grow downwards and columns grow to the right
+     */
+    enum class Direction : std::uint8_t {
+        None,
+        Left,
+        Right,
+        Up,
+        Down,
+        UpLeft,
+        UpRight,
+        DownLeft,
+        DownRight
+    };
+
+    /**
+     * @brief Get the column offset of a direction
+     * @param dir The direction
+     * @return -1, 0 or 1
+     */
+    constexpr int getColOffset(Direction dir) {
+        switch (dir) {
+            case Direction::Left:
+            case Direction::UpLeft:
+            case Direction::DownLeft:
+                return -1;
+            case Direction::Right:
+            case Direction::UpRight:
+            case Direction::DownRight:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * @brief Get the row offset of a direction
+     * @param dir The direction
+     * @return -1, 0 or 1
+     */
+    constexpr int getRowOffset(Direction dir) {
+        switch (dir) {
+            case Direction::Up:
+            case Direction::UpLeft:
+            case Direction::UpRight:
+                return -1;
+            case Direction::Down:
+            case Direction::DownLeft:
+            case Direction::DownRight:
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * @brief Get the opposite of a direction
+     * @param dir The direction
+     * @return The opposite direction
+     */
+    constexpr Direction getOpposite(Direction dir) {
+        switch (dir) {
+            case Direction::Left:      return Direction::Right;
+            case Direction::Right:     return Direction::Left;
+            case Direction::Up:        return Direction::Down;
+            case Direction::Down:      return Direction::Up;
+            case Direction::UpLeft:    return Direction::DownRight;
+            case Direction::UpRight:   return Direction::DownLeft;
+            case Direction::DownLeft:  return Direction::UpRight;
+            case Direction::DownRight: return Direction::UpLeft;
+            default:                   return Direction::None;
+        }
+    }
+
+    /**
+     * @brief Mirror a direction horizontally
+     * @param dir The direction
+     * @return The direction with its column offset negated
+     */
+    constexpr Direction getHorizontalMirror(Direction dir) {
+        switch (dir) {
+            case Direction::Left:      return Direction::Right;
+            case Direction::Right:     return Direction::Left;
+            case Direction::UpLeft:    return Direction::UpRight;
+            case Direction::UpRight:   return Direction::UpLeft;
+            case Direction::DownLeft:  return Direction::DownRight;
+            case Direction::DownRight: return Direction::DownLeft;
+            default:                   return dir;
+        }
+    }
+}
+
+#endif //CENTIPEDE_DIRECTION_H
@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Simulation/MushroomField.h"
+#include "Source/Simulation/Random.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace centpd {
+    namespace {
+        const unsigned int WORD_BITS = 64;
+        const std::uint64_t DE_BRUIJN = 0x03F79D71B4CB0A89u;
+        const std::uint64_t HASH_SALT = 0x6D757368726F6F6Du;
+
+        ///////////////////////////////////////////////////////////////
+        constexpr std::array<std::uint8_t, WORD_BITS> makeBitIndices() {
+            std::array<std::uint8_t, WORD_BITS> indices{};
+            for (unsigned int i = 0; i < WORD_BITS; i++)
+                indices[(DE_BRUIJN << i) >> 58] = static_cast<std::uint8_t>(i);
+
+            return indices;
+        }
+
+        constexpr std::array<std::uint8_t, WORD_BITS> BIT_INDICES = makeBitIndices();
+
+        ///////////////////////////////////////////////////////////////
+        unsigned int getLowestBit(std::uint64_t word) {
+            return BIT_INDICES[((word & (~word + 1)) * DE_BRUIJN) >> 58];
+        }
+
+        ///////////////////////////////////////////////////////////////
+        unsigned int getHighestBit(std::uint64_t word) {
+            for (unsigned int shift = 1; shift < WORD_BITS; shift *= 2)
+                word |= word >> shift;
+
+            return BIT_INDICES[((word - (word >> 1)) * DE_BRUIJN) >> 58];
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MushroomField::MushroomField(unsigned int rows, unsigned int cols) :
+        m_rows{rows},
+        m_cols{cols},
+        m_chunkRows{(rows + CHUNK_SIZE - 1) / CHUNK_SIZE},
+        m_chunkCols{(cols + CHUNK_SIZE - 1) / CHUNK_SIZE},
+        m_count{0},
+        m_hash{0},
+        m_version{0},
+        m_chunkIndex(m_chunkRows * m_chunkCols, NO_CHUNK)
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomField::add(int row, int col) {
+        assert(!isPresent(row, col) && "A tile can only contain one mushroom");
+        setTile(row, col, PRESENT);
+        getChunk(row, col).rowBits[row % CHUNK_SIZE] |= std::uint64_t{1} << (col % CHUNK_SIZE);
+        m_count++;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool MushroomField::hit(int row, int col) {
+        assert(isPresent(row, col) && "The tile has no mushroom");
+        const std::uint8_t tile = getTile(row, col);
+        if ((tile & HITS) + 1u == MAX_HITS) {
+            setTile(row, col, 0);
+            getChunk(row, col).rowBits[row % CHUNK_SIZE] &= ~(std::uint64_t{1} << (col % CHUNK_SIZE));
+            m_count--;
+            return true;
+        }
+
+        setTile(row, col, static_cast<std::uint8_t>(tile + 1));
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomField::poison(int row, int col) {
+        const std::uint8_t tile = getTile(row, col);
+        if (tile & PRESENT)
+            setTile(row, col, static_cast<std::uint8_t>(tile | POISONED));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint8_t MushroomField::getTile(int row, int col) const {
+        const Chunk* chunk = findChunk(row, col);
+        return chunk ? chunk->tiles[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE] : 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool MushroomField::isPresent(int row, int col) const {
+        return getTile(row, col) & PRESENT;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int MushroomField::getHits(int row, int col) const {
+        return getTile(row, col) & HITS;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool MushroomField::isPoisoned(int row, int col) const {
+        return getTile(row, col) & POISONED;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    int MushroomField::findNext(int row, int col, int step) const {
+        assert(row >= 0 && static_cast<unsigned int>(row) < m_rows && (step == 1 || step == -1) && "Invalid search");
+        const std::int32_t* chunks = &m_chunkIndex[(row / CHUNK_SIZE) * m_chunkCols];
+        const unsigned int chunkRow = row % CHUNK_SIZE;
+        const int cols = static_cast<int>(m_cols);
+
+        // Unallocated chunks have no mushrooms, they are skipped whole
+        auto getBits = [&](unsigned int chunkCol) -> std::uint64_t {
+            return chunks[chunkCol] == NO_CHUNK ? 0 : m_chunks[chunks[chunkCol]].rowBits[chunkRow];
+        };
+
+        if (step > 0) {
+            if (col >= cols)
+                return cols;
+
+            col = std::max(col, 0);
+            unsigned int chunkCol = col / CHUNK_SIZE;
+            std::uint64_t mask = getBits(chunkCol) & (~std::uint64_t{0} << (col % CHUNK_SIZE));
+            while (mask == 0) {
+                if (++chunkCol == m_chunkCols)
+                    return cols;
+
+                mask = getBits(chunkCol);
+            }
+
+            return static_cast<int>(chunkCol * CHUNK_SIZE + getLowestBit(mask));
+        }
+
+        if (col < 0)
+            return -1;
+
+        col = std::min(col, cols - 1);
+        unsigned int chunkCol = col / CHUNK_SIZE;
+        std::uint64_t mask = getBits(chunkCol) & (~std::uint64_t{0} >> (WORD_BITS - 1 - col % CHUNK_SIZE));
+        while (mask == 0) {
+            if (chunkCol-- == 0)
+                return -1;
+
+            mask = getBits(chunkCol);
+        }
+
+        return static_cast<int>(chunkCol * CHUNK_SIZE + getHighestBit(mask));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t MushroomField::getCount() const {
+        return m_count;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t MushroomField::getHash() const {
+        return m_hash;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t MushroomField::computeHash() const {
+        std::uint64_t hash = 0;
+        for (unsigned int chunkRow = 0; chunkRow < m_chunkRows; chunkRow++) {
+            for (unsigned int chunkCol = 0; chunkCol < m_chunkCols; chunkCol++) {
+                const std::int32_t index = m_chunkIndex[chunkRow * m_chunkCols + chunkCol];
+                if (index == NO_CHUNK)
+                    continue;
+
+                const Chunk& chunk = m_chunks[index];
+                for (unsigned int i = 0; i < CHUNK_SIZE * CHUNK_SIZE; i++) {
+                    const int row = static_cast<int>(chunkRow * CHUNK_SIZE + i / CHUNK_SIZE);
+                    const int col = static_cast<int>(chunkCol * CHUNK_SIZE + i % CHUNK_SIZE);
+                    hash ^= getKey(row, col, chunk.tiles[i]);
+                }
+            }
+        }
+
+        return hash;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int MushroomField::getRows() const {
+        return m_rows;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int MushroomField::getCols() const {
+        return m_cols;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomField::copyTiles(std::vector<std::uint8_t> &tiles) const {
+        tiles.assign(static_cast<std::size_t>(m_rows) * m_cols, 0);
+        for (unsigned int chunkRow = 0; chunkRow < m_chunkRows; chunkRow++) {
+            for (unsigned int chunkCol = 0; chunkCol < m_chunkCols; chunkCol++) {
+                const std::int32_t index = m_chunkIndex[chunkRow * m_chunkCols + chunkCol];
+                if (index == NO_CHUNK)
+                    continue;
+
+                const Chunk& chunk = m_chunks[index];
+                const unsigned int firstCol = chunkCol * CHUNK_SIZE;
+                const unsigned int width = std::min(CHUNK_SIZE, m_cols - firstCol);
+                const unsigned int height = std::min(CHUNK_SIZE, m_rows - chunkRow * CHUNK_SIZE);
+                for (unsigned int i = 0; i < height; i++) {
+                    const auto source = chunk.tiles.begin() + i * CHUNK_SIZE;
+                    std::copy(source, source + width, tiles.begin() + (chunkRow * CHUNK_SIZE + i) * m_cols + firstCol);
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int MushroomField::getChunkRows() const {
+        return m_chunkRows;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int MushroomField::getChunkCols() const {
+        return m_chunkCols;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t MushroomField::getChunkVersion(unsigned int chunkRow, unsigned int chunkCol) const {
+        assert(chunkRow < m_chunkRows && chunkCol < m_chunkCols && "Chunk out of range");
+        const std::int32_t index = m_chunkIndex[chunkRow * m_chunkCols + chunkCol];
+        return index == NO_CHUNK ? 0 : m_chunks[index].version;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t MushroomField::getVersion() const {
+        return m_version;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t MushroomField::getChunkCount() const {
+        return m_chunks.size();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t MushroomField::getMemoryUsage() const {
+        return m_chunks.capacity() * sizeof(Chunk) + m_chunkIndex.capacity() * sizeof(std::int32_t);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomField::clear() {
+        m_chunks.clear();
+        std::fill(m_chunkIndex.begin(), m_chunkIndex.end(), NO_CHUNK);
+        m_count = 0;
+        m_hash = 0;
+        m_version++;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const MushroomField::Chunk* MushroomField::findChunk(int row, int col) const {
+        assert(row >= 0 && col >= 0 && static_cast<unsigned int>(row) < m_rows && static_cast<unsigned int>(col) < m_cols && "Tile out of range");
+        const std::int32_t index = m_chunkIndex[(row / CHUNK_SIZE) * m_chunkCols + col / CHUNK_SIZE];
+        return index == NO_CHUNK ? nullptr : &m_chunks[index];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    MushroomField::Chunk& MushroomField::getChunk(int row, int col) {
+        assert(row >= 0 && col >= 0 && static_cast<unsigned int>(row) < m_rows && static_cast<unsigned int>(col) < m_cols && "Tile out of range");
+        std::int32_t& index = m_chunkIndex[(row / CHUNK_SIZE) * m_chunkCols + col / CHUNK_SIZE];
+        if (index == NO_CHUNK) {
+            index = static_cast<std::int32_t>(m_chunks.size());
+            m_chunks.emplace_back();
+        }
+
+        return m_chunks[index];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void MushroomField::setTile(int row, int col, std::uint8_t tile) {
+        Chunk& chunk = getChunk(row, col);
+        std::uint8_t& current = chunk.tiles[(row % CHUNK_SIZE) * CHUNK_SIZE + col % CHUNK_SIZE];
+        m_hash ^= getKey(row, col, current) ^ getKey(row, col, tile);
+        current = tile;
+        chunk.version = ++m_version;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t MushroomField::getKey(int row, int col, std::uint8_t tile) const {
+        if (!(tile & PRESENT))
+            return 0;
+
+        return Random::mix(HASH_SALT ^ ((static_cast<std::uint64_t>(row) * m_cols + col) << 8 | tile));
+    }
+}
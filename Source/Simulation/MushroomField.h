@@ -0,0 +1,298 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_MUSHROOMFIELD_H
+#define CENTIPEDE_MUSHROOMFIELD_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief The mushrooms of the simulation, stored as one byte per tile
+     *
+     * Mushrooms never move, so instead of being actors they are a layer
+     * of tile data. The byte of a tile is zero if the tile has no mushroom,
+     * otherwise it has the PRESENT bit set, the number of bullet hits the
+     * mushroom has taken (0-3) in the HITS bits and the POISONED bit set
+     * if a Scorpion walked over the mushroom. Actors interact with the
+     * field by looking up the tile they occupy
+     *
+     * The grid is divided into square chunks of CHUNK_SIZE tiles. A chunk
+     * is only allocated when the first mushroom is placed in it, the tiles
+     * of the other chunks read as empty. Memory therefore grows with the
+     * area that has mushrooms, not with the size of the grid, and copying
+     * the field (e.g. for a snapshot of the World) only copies that area.
+     * Allocated chunks are kept when their mushrooms are destroyed
+     *
+     * Every change of a tile gives its chunk a new version. Views of the
+     * field (e.g. the renderer) remember the versions they have seen and
+     * only visit the chunks that changed since, which are the chunks
+     * actors were active in
+     *
+     * Each row of a chunk also has a bitset of the columns that have a
+     * mushroom, kept up to date as mushrooms are added and destroyed. It
+     * finds the next mushroom along a row a chunk width at a time, so that
+     * an actor can tell how far it can go before it is blocked
+     *
+     * The field keeps a hash of its contents (Zobrist hashing): every
+     * mushroom contributes a key derived from its tile and its byte, and a
+     * change XORs the key of the old byte out and the key of the new byte
+     * in, so the hash is updated in constant time
+     */
+    class MushroomField {
+    public:
+        static constexpr std::uint8_t HITS = 0x03;     //!< Bits of the number of hits taken
+        static constexpr std::uint8_t POISONED = 0x04; //!< Bit set if the mushroom is poisoned
+        static constexpr std::uint8_t PRESENT = 0x80;  //!< Bit set if the tile has a mushroom
+        static constexpr unsigned int MAX_HITS = 4;    //!< The number of hits that destroy a mushroom
+        static constexpr unsigned int CHUNK_SIZE = 64; //!< The width and height of a chunk in tiles
+
+        /**
+         * @brief Constructor
+         * @param rows The number of rows in the grid
+         * @param cols The number of columns in the grid
+         */
+        MushroomField(unsigned int rows, unsigned int cols);
+
+        /**
+         * @brief Place a healthy mushroom in a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         *
+         * The tile must not already have a mushroom
+         */
+        void add(int row, int col);
+
+        /**
+         * @brief Hit the mushroom in a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if the hit destroyed the mushroom, otherwise false
+         *
+         * The tile must have a mushroom
+         */
+        bool hit(int row, int col);
+
+        /**
+         * @brief Poison the mushroom in a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         *
+         * This function has no effect if the tile has no mushroom
+         */
+        void poison(int row, int col);
+
+        /**
+         * @brief Get the byte of a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return The byte of the tile, zero if it has no mushroom
+         */
+        std::uint8_t getTile(int row, int col) const;
+
+        /**
+         * @brief Check if a tile has a mushroom
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if the tile has a mushroom, otherwise false
+         */
+        bool isPresent(int row, int col) const;
+
+        /**
+         * @brief Get the number of hits the mushroom in a tile has taken
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return The number of hits, in the range [0, MAX_HITS)
+         */
+        unsigned int getHits(int row, int col) const;
+
+        /**
+         * @brief Check if the mushroom in a tile is poisoned
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if the mushroom is poisoned, otherwise false
+         */
+        bool isPoisoned(int row, int col) const;
+
+        /**
+         * @brief Find the nearest mushroom along a row
+         * @param row The row to search
+         * @param col The column to start at, it is included in the search
+         * @param step 1 to search to the right or -1 to search to the left
+         * @return The column of the nearest mushroom, or the column just
+         *         outside the grid (-1 or getCols()) if there is none
+         *
+         * Only the columns of the grid are searched, the start column may be outside of it
+         */
+        int findNext(int row, int col, int step) const;
+
+        /**
+         * @brief Get the number of mushrooms in the field
+         * @return The number of mushrooms in the field
+         */
+        std::size_t getCount() const;
+
+        /**
+         * @brief Get the hash of the mushrooms
+         * @return The hash of the tile, hits and poison of every mushroom
+         *
+         * Two fields with the same mushrooms have the same hash
+         */
+        std::uint64_t getHash() const;
+
+        /**
+         * @brief Compute the hash of the mushrooms from scratch
+         * @return The same value as getHash
+         */
+        std::uint64_t computeHash() const;
+
+        /**
+         * @brief Get the number of rows in the field
+         * @return The number of rows
+         */
+        unsigned int getRows() const;
+
+        /**
+         * @brief Get the number of columns in the field
+         * @return The number of columns
+         */
+        unsigned int getCols() const;
+
+        /**
+         * @brief Copy the tile data of the whole grid
+         * @param tiles Receives the byte of each tile, row by row
+         *
+         * The vector is resized to the number of tiles, its capacity is reused
+         */
+        void copyTiles(std::vector<std::uint8_t>& tiles) const;
+
+        /**
+         * @brief Get the number of chunk rows
+         * @return The number of rows of chunks that cover the grid
+         */
+        unsigned int getChunkRows() const;
+
+        /**
+         * @brief Get the number of chunk columns
+         * @return The number of columns of chunks that cover the grid
+         */
+        unsigned int getChunkCols() const;
+
+        /**
+         * @brief Get the version of a chunk
+         * @param chunkRow The row of the chunk
+         * @param chunkCol The column of the chunk
+         * @return The version of the chunk, zero if it was never allocated
+         *
+         * The version changes whenever a tile of the chunk changes
+         */
+        std::uint64_t getChunkVersion(unsigned int chunkRow, unsigned int chunkCol) const;
+
+        /**
+         * @brief Get the version of the field
+         * @return The latest version of any chunk, zero if nothing was ever added
+         */
+        std::uint64_t getVersion() const;
+
+        /**
+         * @brief Get the number of allocated chunks
+         * @return The number of chunks that hold tile data
+         */
+        std::size_t getChunkCount() const;
+
+        /**
+         * @brief Get the memory used by the field
+         * @return The size of the allocated chunks and the chunk index in bytes
+         */
+        std::size_t getMemoryUsage() const;
+
+        /**
+         * @brief Remove all the mushrooms
+         */
+        void clear();
+
+    private:
+        static constexpr std::int32_t NO_CHUNK = -1;
+
+        /**
+         * @brief A square of CHUNK_SIZE by CHUNK_SIZE tiles
+         */
+        struct Chunk {
+            std::array<std::uint8_t, CHUNK_SIZE * CHUNK_SIZE> tiles{}; //!< The byte of each tile, row by row
+            std::array<std::uint64_t, CHUNK_SIZE> rowBits{};           //!< The columns with a mushroom, one word per row
+            std::uint64_t version = 0;                                 //!< The version of the last change
+        };
+
+        static_assert(CHUNK_SIZE == 64, "A row of a chunk must fit in one word of its bitset");
+
+        /**
+         * @brief Get the chunk that holds a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return The chunk, or nullptr if it is not allocated
+         */
+        const Chunk* findChunk(int row, int col) const;
+
+        /**
+         * @brief Get the chunk that holds a tile, allocating it if needed
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return The chunk
+         */
+        Chunk& getChunk(int row, int col);
+
+        /**
+         * @brief Change the byte of a tile and update the hash
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @param tile The new byte of the tile
+         */
+        void setTile(int row, int col, std::uint8_t tile);
+
+        /**
+         * @brief Get the hash key of a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @param tile The byte of the tile
+         * @return The key of the tile, zero if it has no mushroom
+         */
+        std::uint64_t getKey(int row, int col, std::uint8_t tile) const;
+
+    private:
+        unsigned int m_rows;                    //!< The number of rows in the grid
+        unsigned int m_cols;                    //!< The number of columns in the grid
+        unsigned int m_chunkRows;               //!< The number of rows of chunks
+        unsigned int m_chunkCols;               //!< The number of columns of chunks
+        std::size_t m_count;                    //!< The number of mushrooms in the field
+        std::uint64_t m_hash;                   //!< The XOR of the keys of all mushrooms
+        std::uint64_t m_version;                //!< The latest version given to a chunk
+        std::vector<std::int32_t> m_chunkIndex; //!< The index of each chunk in m_chunks or NO_CHUNK, row by row
+        std::vector<Chunk> m_chunks;            //!< The allocated chunks
+    };
+}
+
+#endif //CENTIPEDE_MUSHROOMFIELD_H
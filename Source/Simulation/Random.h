@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_RANDOM_H
+#define CENTIPEDE_RANDOM_H
+
+#include <cstdint>
+
+namespace centpd {
+    /**
+     * @brief Small deterministic random number generator (SplitMix64)
+     *
+     * Unlike the standard distributions, the sequence produced for a given
+     * seed is the same on every platform and standard library, which keeps
+     * simulations reproducible
+     */
+    class Random {
+    public:
+        /**
+         * @brief Constructor
+         * @param seed The initial state of the generator
+         */
+        explicit Random(std::uint64_t seed = 0) :
+            m_state{seed}
+        {}
+
+        /**
+         * @brief Generate the next 64-bit number
+         * @return A uniformly distributed 64-bit number
+         */
+        std::uint64_t next() {
+            return mix(m_state += 0x9E3779B97F4A7C15ull);
+        }
+
+        /**
+         * @brief Scramble a number
+         * @param value The number to scramble
+         * @return A number that looks random but is always the same for the same value
+         *
+         * This is the output function of the generator, it turns keys
+         * such as a tile and its contents into hash values without a table
+         */
+        static std::uint64_t mix(std::uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        /**
+         * @brief Generate a number in a range
+         * @param min The smallest number that can be generated
+         * @param max The largest number that can be generated
+         * @return A number in the range [min, max]
+         */
+        int range(int min, int max) {
+            auto span = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min + 1);
+            return min + static_cast<int>(next() % span);
+        }
+
+        /**
+         * @brief Get the state of the generator
+         * @return The state of the generator
+         */
+        std::uint64_t getState() const {
+            return m_state;
+        }
+
+        /**
+         * @brief Restore a previous state of the generator
+         * @param state The state to restore
+         */
+        void setState(std::uint64_t state) {
+            m_state = state;
+        }
+
+    private:
+        std::uint64_t m_state; //!< Generator state
+    };
+}
+
+#endif //CENTIPEDE_RANDOM_H
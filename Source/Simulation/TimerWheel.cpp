@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Simulation/TimerWheel.h"
+#include <cassert>
+
+namespace centpd {
+    namespace {
+        const std::uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+        ///////////////////////////////////////////////////////////////
+        TimerWheel::TimerId makeId(std::int32_t index, std::uint32_t generation) {
+            return (static_cast<TimerWheel::TimerId>(generation) << 32) | static_cast<std::uint32_t>(index + 1);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    TimerWheel::TimerWheel(std::uint64_t tick) :
+        m_tick{tick},
+        m_free{NONE},
+        m_count{0}
+    {
+        m_slots.fill(Slot{NONE, NONE});
+    }
+
+    ///////////////////////////////////////////////////////////////
+    TimerWheel::TimerId TimerWheel::schedule(std::uint64_t delay, std::uint32_t event) {
+        assert(delay > 0 && "A timer cannot expire in the current tick");
+
+        std::int32_t index = m_free;
+        if (index != NONE)
+            m_free = m_timers[index].next;
+        else {
+            index = static_cast<std::int32_t>(m_timers.size());
+            m_timers.push_back(Timer{0, 0, 0, NONE, NONE, NONE});
+        }
+
+        Timer& timer = m_timers[index];
+        timer.deadline = m_tick + delay;
+        timer.event = event;
+        link(index);
+        m_count++;
+
+        return makeId(index, timer.generation);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool TimerWheel::cancel(TimerId id) {
+        std::int32_t index = find(id);
+        if (index == NONE)
+            return false;
+
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool TimerWheel::reschedule(TimerId id, std::uint64_t delay) {
+        assert(delay > 0 && "A timer cannot expire in the current tick");
+
+        std::int32_t index = find(id);
+        if (index == NONE)
+            return false;
+
+        unlink(index);
+        m_timers[index].deadline = m_tick + delay;
+        link(index);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool TimerWheel::isScheduled(TimerId id) const {
+        return find(id) != NONE;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t TimerWheel::getRemaining(TimerId id) const {
+        std::int32_t index = find(id);
+        return index != NONE ? m_timers[index].deadline - m_tick : 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<TimerWheel::Expiry>& TimerWheel::advance() {
+        m_expired.clear();
+        m_tick++;
+
+        // Entering the range of a slot of a higher level moves its timers down, higher levels first
+        for (unsigned int level = LEVELS - 1; level > 0; level--) {
+            const unsigned int shift = level * SLOT_BITS;
+            if ((m_tick & ((std::uint64_t{1} << shift) - 1)) == 0)
+                cascade(level * SLOTS + ((m_tick >> shift) & SLOT_MASK));
+        }
+
+        // Every timer in the current slot of the lowest level expires now
+        Slot& slot = m_slots[m_tick & SLOT_MASK];
+        for (std::int32_t index = slot.head; index != NONE;) {
+            Timer& timer = m_timers[index];
+            const std::int32_t next = timer.next;
+            assert(timer.deadline == m_tick && "Timer in the wrong slot");
+
+            m_expired.push_back(Expiry{makeId(index, timer.generation), timer.event});
+            timer.slot = NONE;
+            release(index);
+            index = next;
+        }
+
+        slot = Slot{NONE, NONE};
+        return m_expired;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t TimerWheel::getTick() const {
+        return m_tick;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t TimerWheel::size() const {
+        return m_count;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::int32_t TimerWheel::find(TimerId id) const {
+        const auto index = static_cast<std::int64_t>(id & 0xFFFFFFFFu) - 1;
+        if (index < 0 || index >= static_cast<std::int64_t>(m_timers.size()))
+            return NONE;
+
+        const Timer& timer = m_timers[static_cast<std::size_t>(index)];
+        return timer.slot != NONE && timer.generation == (id >> 32) ? static_cast<std::int32_t>(index) : NONE;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void TimerWheel::link(std::int32_t index) {
+        Timer& timer = m_timers[index];
+
+        // The level is the highest group of bits in which the deadline differs from the current tick
+        const std::uint64_t diff = timer.deadline ^ m_tick;
+        unsigned int level = 0;
+        while (level < LEVELS - 1 && (diff >> ((level + 1) * SLOT_BITS)) != 0)
+            level++;
+
+        // The top level wraps around, a deadline a full turn or more ahead waits in the slot that is reached last
+        const unsigned int shift = level * SLOT_BITS;
+        std::size_t slot = level * SLOTS + ((timer.deadline >> shift) & SLOT_MASK);
+        if (level == LEVELS - 1 && (timer.deadline >> shift) - (m_tick >> shift) >= SLOTS)
+            slot = level * SLOTS + (((m_tick >> shift) - 1) & SLOT_MASK);
+
+        Slot& list = m_slots[slot];
+        timer.slot = static_cast<std::int32_t>(slot);
+        timer.prev = list.tail;
+        timer.next = NONE;
+
+        if (list.tail != NONE)
+            m_timers[list.tail].next = index;
+        else
+            list.head = index;
+
+        list.tail = index;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void TimerWheel::unlink(std::int32_t index) {
+        Timer& timer = m_timers[index];
+        Slot& list = m_slots[static_cast<std::size_t>(timer.slot)];
+
+        if (timer.prev != NONE)
+            m_timers[timer.prev].next = timer.next;
+        else
+            list.head = timer.next;
+
+        if (timer.next != NONE)
+            m_timers[timer.next].prev = timer.prev;
+        else
+            list.tail = timer.prev;
+
+        timer.slot = NONE;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void TimerWheel::release(std::int32_t index) {
+        Timer& timer = m_timers[index];
+        timer.generation++;
+        timer.prev = NONE;
+        timer.next = m_free;
+        m_free = index;
+        m_count--;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void TimerWheel::cascade(std::size_t slot) {
+        std::int32_t index = m_slots[slot].head;
+        m_slots[slot] = Slot{NONE, NONE};
+
+        while (index != NONE) {
+            const std::int32_t next = m_timers[index].next;
+            link(index);
+            index = next;
+        }
+    }
+}
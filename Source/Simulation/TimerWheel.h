@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_TIMERWHEEL_H
+#define CENTIPEDE_TIMERWHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Schedules events a number of simulation ticks ahead
+     *
+     * Timers are kept in a hierarchical timing wheel: LEVELS wheels of
+     * SLOTS slots each, where a slot of level L covers SLOTS^L ticks. A
+     * timer goes into the slot of the lowest level that can tell its
+     * deadline apart from the current tick, and moves down a level each
+     * time the wheel reaches the range of its slot. Scheduling, cancelling
+     * and rescheduling a timer only link or unlink it, and advancing a
+     * tick touches one slot per level at most, independent of the number
+     * of timers. Timers further ahead than the wheel spans wait in the
+     * top level until they are in range
+     *
+     * A timer carries an event number instead of a callback, so that a
+     * wheel is a value like the World that owns it: copying it copies
+     * every pending timer. Timers that expire in the same tick are
+     * reported in a deterministic order, the same operations always
+     * expire the same timers in the same ticks and order
+     */
+    class TimerWheel {
+    public:
+        using TimerId = std::uint64_t;                         //!< Identifies a scheduled timer
+        static constexpr TimerId NO_TIMER = 0;                 //!< An id that never identifies a timer
+        static constexpr unsigned int LEVELS = 4;              //!< The number of wheels
+        static constexpr unsigned int SLOT_BITS = 6;           //!< The number of bits of the tick indexed by each wheel
+        static constexpr unsigned int SLOTS = 1u << SLOT_BITS; //!< The number of slots of each wheel
+
+        /**
+         * @brief A timer that expired
+         */
+        struct Expiry {
+            TimerId id;          //!< The id the timer had, it no longer identifies a timer
+            std::uint32_t event; //!< The event the timer was scheduled with
+        };
+
+        /**
+         * @brief Constructor
+         * @param tick The current tick
+         */
+        explicit TimerWheel(std::uint64_t tick = 0);
+
+        /**
+         * @brief Schedule a timer
+         * @param delay The number of ticks until the timer expires, at least one
+         * @param event The event reported when the timer expires
+         * @return The id of the timer
+         */
+        TimerId schedule(std::uint64_t delay, std::uint32_t event);
+
+        /**
+         * @brief Cancel a timer
+         * @param id The id of the timer
+         * @return True if the timer was cancelled, or false if it is not scheduled
+         */
+        bool cancel(TimerId id);
+
+        /**
+         * @brief Change when a timer expires
+         * @param id The id of the timer
+         * @param delay The number of ticks from now until the timer expires, at least one
+         * @return True if the timer was rescheduled, or false if it is not scheduled
+         */
+        bool reschedule(TimerId id, std::uint64_t delay);
+
+        /**
+         * @brief Check if a timer is scheduled
+         * @param id The id of the timer
+         * @return True if the timer has not expired or been cancelled, otherwise false
+         */
+        bool isScheduled(TimerId id) const;
+
+        /**
+         * @brief Get the number of ticks until a timer expires
+         * @param id The id of the timer
+         * @return The number of ticks until the timer expires, or 0 if it is not scheduled
+         */
+        std::uint64_t getRemaining(TimerId id) const;
+
+        /**
+         * @brief Advance the wheel by one tick
+         * @return The timers that expired in the new tick
+         *
+         * The returned timers are valid until the next call. Timers
+         * scheduled while handling them expire in a later tick
+         */
+        const std::vector<Expiry>& advance();
+
+        /**
+         * @brief Get the current tick
+         * @return The number of the current tick
+         */
+        std::uint64_t getTick() const;
+
+        /**
+         * @brief Get the number of scheduled timers
+         * @return The number of timers that have neither expired nor been cancelled
+         */
+        std::size_t size() const;
+
+    private:
+        static constexpr std::int32_t NONE = -1;
+
+        /**
+         * @brief A scheduled or free timer
+         */
+        struct Timer {
+            std::uint64_t deadline;   //!< The tick the timer expires in
+            std::uint32_t event;      //!< The event reported when the timer expires
+            std::uint32_t generation; //!< Incremented each time the timer is freed, invalidates old ids
+            std::int32_t prev;        //!< The previous timer in the slot, or NONE
+            std::int32_t next;        //!< The next timer in the slot or free list, or NONE
+            std::int32_t slot;        //!< The slot of the timer, or NONE if the timer is free
+        };
+
+        /**
+         * @brief A list of timers
+         */
+        struct Slot {
+            std::int32_t head; //!< The first timer, or NONE
+            std::int32_t tail; //!< The last timer, or NONE
+        };
+
+        /**
+         * @brief Get the index of a scheduled timer
+         * @param id The id of the timer
+         * @return The index of the timer, or NONE if it is not scheduled
+         */
+        std::int32_t find(TimerId id) const;
+
+        /**
+         * @brief Append a timer to the slot its deadline belongs to
+         * @param index The index of the timer
+         */
+        void link(std::int32_t index);
+
+        /**
+         * @brief Remove a timer from its slot
+         * @param index The index of the timer
+         */
+        void unlink(std::int32_t index);
+
+        /**
+         * @brief Return a timer to the free list
+         * @param index The index of the timer, it must not be in a slot
+         */
+        void release(std::int32_t index);
+
+        /**
+         * @brief Move the timers of a slot to the slots their deadlines now belong to
+         * @param slot The index of the slot
+         */
+        void cascade(std::size_t slot);
+
+    private:
+        std::uint64_t m_tick;                     //!< The current tick
+        std::vector<Timer> m_timers;              //!< Scheduled and free timers
+        std::array<Slot, LEVELS * SLOTS> m_slots; //!< The slots of each level, level by level
+        std::int32_t m_free;                      //!< The first free timer, or NONE
+        std::size_t m_count;                      //!< The number of scheduled timers
+        std::vector<Expiry> m_expired;            //!< The timers that expired in the current tick
+    };
+}
+
+#endif //CENTIPEDE_TIMERWHEEL_H
@@ -0,0 +1,790 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Simulation/World.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace centpd {
+    namespace {
+        const std::uint8_t FLEA_MAX_HITS = 2;
+        const std::uint64_t ACTOR_SALT = 0x6163746F72736B65u;
+        const std::uint64_t LIVES_SALT = 0x706C617965726C76u;
+
+        /**
+         * @brief The events of the timers of the world
+         */
+        enum class TimerEvent : std::uint32_t {
+            SpawnScorpion,
+            SpawnFlea
+        };
+
+        ///////////////////////////////////////////////////////////////
+        std::uint16_t toStep(float speed, const WorldSettings& settings) {
+            double step = std::round(speed / settings.tileSize * World::TILE_UNITS / settings.tickRate);
+            return static_cast<std::uint16_t>(std::clamp(step, 1.0, World::TILE_UNITS - 1.0));
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::int32_t getUnitX(const ActorArrays& actors, std::size_t index) {
+            return actors.col[index] * World::TILE_UNITS - getColOffset(actors.dir[index]) * actors.remaining[index];
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::int32_t getUnitY(const ActorArrays& actors, std::size_t index) {
+            return actors.row[index] * World::TILE_UNITS - getRowOffset(actors.dir[index]) * actors.remaining[index];
+        }
+
+        ///////////////////////////////////////////////////////////////
+        std::uint64_t getLivesKey(std::size_t player, int lives) {
+            return Random::mix(LIVES_SALT ^ (static_cast<std::uint64_t>(player) << 32 | static_cast<std::uint32_t>(lives)));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    World::World(const WorldSettings& settings, std::uint64_t seed) :
+        m_settings{settings},
+        m_random{seed},
+        m_steps{},
+        m_mushrooms{settings.rows, settings.cols},
+        m_nextId{0},
+        m_tickCount{0},
+        m_bulletsFired{0},
+        m_level{1},
+        m_scorpionTimer{TimerWheel::NO_TIMER},
+        m_fleaTimer{TimerWheel::NO_TIMER},
+        m_hash{0}
+    {
+        assert(settings.rows > settings.playerAreaHeight + 1 && settings.cols > 0 && "Invalid grid size");
+        assert(settings.tickRate > 0 && settings.tileSize > 0 && "Invalid tick rate or tile size");
+        assert(settings.numPlayers <= MAX_PLAYERS && "Too many players");
+
+        updateSteps();
+
+        // Later levels have longer centipedes, reserve for the longest so that a new level does not allocate
+        m_actors.get(ActorKind::CentipedeSegment).reserve(getMaxCentipedeLength());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::start() {
+        if (m_settings.enableMushrooms)
+            createMushroomField();
+
+        if (m_settings.enablePlayer) {
+            for (auto player = 0u; player < m_settings.numPlayers; player++)
+                createPlayer(player);
+        }
+
+        if (m_settings.enableCentipedes)
+            createCentipede();
+
+        startSpawnTimers();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::tick(const PlayerInputs& inputs) {
+        m_tickCount++;
+
+        savePositions();
+        movePlayers(inputs);
+        moveBullets();
+        moveCentipedes();
+        moveScorpions();
+        moveFleas();
+        resolveCollisions();
+        updateTimers();
+        cleanup();
+
+        if (m_settings.enableCentipedes && m_actors.get(ActorKind::CentipedeSegment).size() == 0)
+            startNextLevel();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::tick(const PlayerInput& input) {
+        tick(PlayerInputs{input});
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int World::getLevel() const {
+        return m_level;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::applySettings(const WorldSettings& settings) {
+        assert(settings.tickRate > 0 && "Invalid tick rate");
+
+        const bool isTickRateChanged = settings.tickRate != m_settings.tickRate;
+        const bool isScorpionIntervalChanged = isTickRateChanged || settings.scorpionSpawnInterval != m_settings.scorpionSpawnInterval;
+        const bool isFleaIntervalChanged = isTickRateChanged || settings.fleaSpawnInterval != m_settings.fleaSpawnInterval;
+
+        // The layout of the grid and the initial actors cannot change during a game
+        m_settings.tickRate = settings.tickRate;
+        m_settings.playerSpeed = settings.playerSpeed;
+        m_settings.bulletSpeed = settings.bulletSpeed;
+        m_settings.centipedeSpeed = settings.centipedeSpeed;
+        m_settings.scorpionSpeed = settings.scorpionSpeed;
+        m_settings.fleaSpeed = settings.fleaSpeed;
+        m_settings.centipedeSpeedPerLevel = settings.centipedeSpeedPerLevel;
+        m_settings.centipedeLengthPerLevel = settings.centipedeLengthPerLevel;
+        m_settings.scorpionSpawnInterval = settings.scorpionSpawnInterval;
+        m_settings.fleaSpawnInterval = settings.fleaSpawnInterval;
+        m_settings.enableMushrooms = settings.enableMushrooms;
+        m_settings.enableScorpions = settings.enableScorpions;
+        m_settings.enableFleas = settings.enableFleas;
+        updateSteps();
+
+        // A changed interval restarts the countdown, the cancelled flea timer restarts when the flea leaves
+        if (isScorpionIntervalChanged)
+            m_timers.reschedule(m_scorpionTimer, toTicks(m_settings.scorpionSpawnInterval));
+
+        if (isFleaIntervalChanged)
+            m_timers.reschedule(m_fleaTimer, toTicks(m_settings.fleaSpawnInterval));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const WorldSettings &World::getSettings() const {
+        return m_settings;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const ActorArrays &World::getActors(ActorKind kind) const {
+        return m_actors.get(kind);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint16_t World::getStep(ActorKind kind) const {
+        return m_steps[static_cast<std::size_t>(kind)];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Position World::getPosition(ActorKind kind, std::size_t index, float alpha) const {
+        const ActorArrays& actors = m_actors.get(kind);
+        const float scale = static_cast<float>(m_settings.tileSize) / TILE_UNITS;
+        const float halfTile = static_cast<float>(m_settings.tileSize) / 2.0f;
+
+        const auto prevX = static_cast<float>(actors.prevX[index]);
+        const auto prevY = static_cast<float>(actors.prevY[index]);
+        return Position{
+            (prevX + (static_cast<float>(getUnitX(actors, index)) - prevX) * alpha) * scale + halfTile,
+            (prevY + (static_cast<float>(getUnitY(actors, index)) - prevY) * alpha) * scale + halfTile
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool World::canShoot(std::size_t player) const {
+        const ActorArrays& players = m_actors.get(ActorKind::Player);
+        if (player >= players.size() || !players.active[player])
+            return false;
+
+        const ActorArrays& bullets = m_actors.get(ActorKind::Bullet);
+        for (std::size_t i = 0; i < bullets.size(); i++) {
+            if (bullets.active[i] && bullets.link[i] == static_cast<std::int32_t>(player))
+                return false;
+        }
+
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    int World::getLives(std::size_t player) const {
+        return player < m_lives.size() ? m_lives[player] : 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool World::isMushroomAt(int row, int col) const {
+        return isInGrid(row, col) && m_mushrooms.isPresent(row, col);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const MushroomField &World::getMushrooms() const {
+        return m_mushrooms;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    int World::getWallRow() const {
+        return static_cast<int>(m_settings.rows - 1 - m_settings.playerAreaHeight);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t World::getTickCount() const {
+        return m_tickCount;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t World::getBulletsFired() const {
+        return m_bulletsFired;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t World::getStateHash() const {
+        return m_hash ^ m_mushrooms.getHash();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t World::computeStateHash() const {
+        std::uint64_t hash = 0;
+        for (std::size_t k = 0; k < NUM_KINDS; k++) {
+            const ActorArrays& actors = m_actors.get(static_cast<ActorKind>(k));
+            for (std::size_t i = 0; i < actors.size(); i++) {
+                if (actors.active[i])
+                    hash ^= getActorKey(actors, i);
+            }
+        }
+
+        for (std::size_t player = 0; player < m_lives.size(); player++)
+            hash ^= getLivesKey(player, m_lives[player]);
+
+        return hash ^ m_mushrooms.computeHash();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool World::advance(ActorArrays& actors, std::size_t index, std::uint32_t& budget) {
+        if (actors.remaining[index] == 0)
+            return false;
+
+        auto distance = std::min<std::uint32_t>(budget, actors.remaining[index]);
+        actors.remaining[index] = static_cast<std::uint16_t>(actors.remaining[index] - distance);
+        budget -= distance;
+        return actors.remaining[index] == 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::beginMove(ActorArrays& actors, std::size_t index, Direction dir, std::uint32_t& budget) {
+        m_hash ^= getActorKey(actors, index);
+        actors.dir[index] = dir;
+        actors.row[index] = static_cast<std::int16_t>(actors.row[index] + getRowOffset(dir));
+        actors.col[index] = static_cast<std::int16_t>(actors.col[index] + getColOffset(dir));
+        m_hash ^= getActorKey(actors, index);
+
+        // The distance left over from the previous move carries over, but an
+        // actor never reaches more than one tile per tick
+        auto distance = std::min<std::uint32_t>(budget, TILE_UNITS - 1u);
+        actors.remaining[index] = static_cast<std::uint16_t>(TILE_UNITS - distance);
+        budget = 0;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::setDirection(ActorArrays& actors, std::size_t index, Direction dir) {
+        m_hash ^= getActorKey(actors, index);
+        actors.dir[index] = dir;
+        m_hash ^= getActorKey(actors, index);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t World::addActor(ActorKind kind, int row, int col, Direction dir, std::uint8_t type) {
+        ActorArrays& actors = m_actors.get(kind);
+        std::size_t index = actors.add(m_nextId++, row, col, dir, type);
+        actors.prevX[index] = getUnitX(actors, index);
+        actors.prevY[index] = getUnitY(actors, index);
+        m_hash ^= getActorKey(actors, index);
+        return index;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::removeActor(ActorArrays& actors, std::size_t index) {
+        assert(actors.active[index] && "The actor was already removed");
+        actors.active[index] = 0;
+        m_hash ^= getActorKey(actors, index);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t World::getActorKey(const ActorArrays& actors, std::size_t index) {
+        // The id keeps identical actors in the same tile from cancelling each other out
+        const std::uint64_t tile = static_cast<std::uint64_t>(actors.id[index]) << 32
+            | static_cast<std::uint64_t>(static_cast<std::uint16_t>(actors.row[index])) << 16
+            | static_cast<std::uint16_t>(actors.col[index]);
+        const std::uint64_t contents = static_cast<std::uint64_t>(actors.category) << 16
+            | static_cast<std::uint64_t>(actors.type[index]) << 8
+            | static_cast<std::uint8_t>(actors.dir[index]);
+
+        return Random::mix(ACTOR_SALT ^ tile ^ Random::mix(contents));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool World::canCollide(const ActorArrays& first, std::size_t firstIndex, const ActorArrays& second, std::size_t secondIndex) {
+        return (first.mask[firstIndex] & second.category) && (second.mask[secondIndex] & first.category);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool World::isBlocked(const ActorArrays& actors, std::size_t index, int row, int col) const {
+        const std::uint32_t mask = actors.mask[index];
+        return ((mask & CollisionLayer::PlayerWall) && row <= getWallRow()) || ((mask & CollisionLayer::Mushroom) && isMushroomAt(row, col));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool World::isInGrid(int row, int col) const {
+        return row >= 0 && col >= 0 && row < static_cast<int>(m_settings.rows) && col < static_cast<int>(m_settings.cols);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::savePositions() {
+        for (std::size_t k = 0; k < NUM_KINDS; k++) {
+            ActorArrays& actors = m_actors.get(static_cast<ActorKind>(k));
+            for (std::size_t i = 0; i < actors.size(); i++) {
+                actors.prevX[i] = getUnitX(actors, i);
+                actors.prevY[i] = getUnitY(actors, i);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::movePlayers(const PlayerInputs& inputs) {
+        ActorArrays& players = m_actors.get(ActorKind::Player);
+        for (std::size_t i = 0; i < players.size(); i++) {
+            if (!players.active[i])
+                continue;
+
+            const PlayerInput& input = inputs[i];
+
+            // Intents that cannot be carried out yet are buffered until the earliest tick they can:
+            // the fire intent until the player is in a tile and has no bullet in flight, and a turn
+            // pressed between tiles until the player reaches the tile, even if the key is released
+            if (input.fire)
+                players.flags[i] |= ActorFlag::ShouldFire;
+
+            if (players.remaining[i] != 0 && input.move != Direction::None && input.move != players.dir[i])
+                players.nextDir[i] = input.move;
+
+            std::uint32_t budget = getStep(ActorKind::Player);
+            advance(players, i, budget);
+            if (players.remaining[i] != 0)
+                continue;
+
+            // The bullet can only come out of the player when it is exactly in a tile
+            if (players.flags[i] & ActorFlag::ShouldFire)
+                fireBullet(i);
+
+            const Direction move = input.move != Direction::None ? input.move : players.nextDir[i];
+            players.nextDir[i] = Direction::None;
+            if (move != Direction::None) {
+                int row = players.row[i] + getRowOffset(move);
+                int col = players.col[i] + getColOffset(move);
+                if (isInGrid(row, col) && !isBlocked(players, i, row, col))
+                    beginMove(players, i, move, budget);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::moveBullets() {
+        ActorArrays& bullets = m_actors.get(ActorKind::Bullet);
+        for (std::size_t i = 0; i < bullets.size(); i++) {
+            if (!bullets.active[i])
+                continue;
+
+            std::uint32_t budget = getStep(ActorKind::Bullet);
+            advance(bullets, i, budget);
+            if (bullets.remaining[i] != 0)
+                continue;
+
+            if (isInGrid(bullets.row[i] + getRowOffset(bullets.dir[i]), bullets.col[i]))
+                beginMove(bullets, i, bullets.dir[i], budget);
+            else
+                removeActor(bullets, i);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::moveCentipedes() {
+        ActorArrays& segments = m_actors.get(ActorKind::CentipedeSegment);
+        for (std::size_t i = 0; i < segments.size(); i++) {
+            if (!segments.active[i])
+                continue;
+
+            std::uint32_t budget = getStep(ActorKind::CentipedeSegment);
+            if (advance(segments, i, budget) && (segments.flags[i] & ActorFlag::SwitchingRows)) {
+                // Resume horizontal movement in the opposite direction after reaching the row
+                segments.flags[i] &= ~ActorFlag::SwitchingRows;
+                segments.mask[i] |= CollisionLayer::Mushroom;
+                setDirection(segments, i, segments.nextDir[i]);
+            }
+
+            if (segments.remaining[i] != 0)
+                continue;
+
+            // Along a row a segment only needs to look for obstacles in the tile it turns in, which is
+            // found with the mushroom index and forgotten when it turns or a mushroom of the row changes
+            const int row = segments.row[i];
+            const int col = segments.col[i];
+            const int step = getColOffset(segments.dir[i]);
+            if (getRowOffset(segments.dir[i]) == 0 && step != 0 && isInGrid(row, col)) {
+                if (segments.turnCol[i] == ActorArrays::NO_TURN)
+                    segments.turnCol[i] = static_cast<std::int16_t>(m_mushrooms.findNext(row, col + step, step) - step);
+
+                if (col != segments.turnCol[i]) {
+                    beginMove(segments, i, segments.dir[i], budget);
+                    continue;
+                }
+            }
+
+            // A blocked segment switches rows. At the side of the grid the diagonal
+            // move itself can be blocked, the segment then switches rows the other way
+            for (int attempt = 0; attempt < 3; attempt++) {
+                int row = segments.row[i] + getRowOffset(segments.dir[i]);
+                int col = segments.col[i] + getColOffset(segments.dir[i]);
+                bool isSwitchingRows = segments.flags[i] & ActorFlag::SwitchingRows;
+
+                if (isInGrid(row, col) && !isBlocked(segments, i, row, col)) {
+                    beginMove(segments, i, segments.dir[i], budget);
+                    break;
+                }
+
+                if (!isSwitchingRows)
+                    changeRow(i);
+                else {
+                    setDirection(segments, i, getHorizontalMirror(segments.dir[i]));
+                    segments.nextDir[i] = getHorizontalMirror(segments.nextDir[i]);
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::moveScorpions() {
+        ActorArrays& scorpions = m_actors.get(ActorKind::Scorpion);
+        for (std::size_t i = 0; i < scorpions.size(); i++) {
+            if (!scorpions.active[i])
+                continue;
+
+            std::uint32_t budget = getStep(ActorKind::Scorpion);
+            advance(scorpions, i, budget);
+            if (scorpions.remaining[i] != 0)
+                continue;
+
+            // Scorpions leave the game when they reach the other side of the grid
+            if (isInGrid(scorpions.row[i], scorpions.col[i] + getColOffset(scorpions.dir[i])))
+                beginMove(scorpions, i, scorpions.dir[i], budget);
+            else
+                removeActor(scorpions, i);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::moveFleas() {
+        ActorArrays& fleas = m_actors.get(ActorKind::Flea);
+        for (std::size_t i = 0; i < fleas.size(); i++) {
+            if (!fleas.active[i])
+                continue;
+
+            std::uint32_t budget = getStep(ActorKind::Flea);
+            if (advance(fleas, i, budget) && m_settings.enableMushrooms) {
+                // Fleas randomly drop mushrooms as they descend, but never in the last row
+                int row = fleas.row[i];
+                int col = fleas.col[i];
+                if (row != static_cast<int>(m_settings.rows) - 1) {
+                    if (m_random.range(0, 100) >= 75 && !isMushroomAt(row, col))
+                        addMushroom(row, col);
+                }
+            }
+
+            if (fleas.remaining[i] != 0)
+                continue;
+
+            if (isInGrid(fleas.row[i] + getRowOffset(fleas.dir[i]), fleas.col[i]))
+                beginMove(fleas, i, fleas.dir[i], budget);
+            else
+                removeFlea(i, false);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::resolveCollisions() {
+        ActorArrays& bullets = m_actors.get(ActorKind::Bullet);
+        ActorArrays& segments = m_actors.get(ActorKind::CentipedeSegment);
+        ActorArrays& scorpions = m_actors.get(ActorKind::Scorpion);
+        ActorArrays& fleas = m_actors.get(ActorKind::Flea);
+
+        // A bullet is destroyed by the first actor it hits
+        for (std::size_t b = 0; b < bullets.size(); b++) {
+            if (!bullets.active[b])
+                continue;
+
+            const int row = bullets.row[b];
+            const int col = bullets.col[b];
+            if ((bullets.mask[b] & CollisionLayer::Mushroom) && isMushroomAt(row, col)) {
+                removeActor(bullets, b);
+                if (m_mushrooms.hit(row, col))
+                    forgetTurns(row);
+
+                continue;
+            }
+
+            for (std::size_t i = 0; i < segments.size() && bullets.active[b]; i++) {
+                if (segments.active[i] && segments.row[i] == row && segments.col[i] == col && canCollide(bullets, b, segments, i)) {
+                    removeActor(bullets, b);
+                    killSegment(i);
+                }
+            }
+
+            for (std::size_t i = 0; i < scorpions.size() && bullets.active[b]; i++) {
+                if (scorpions.active[i] && scorpions.row[i] == row && scorpions.col[i] == col && canCollide(bullets, b, scorpions, i)) {
+                    removeActor(bullets, b);
+                    removeActor(scorpions, i);
+                }
+            }
+
+            for (std::size_t i = 0; i < fleas.size() && bullets.active[b]; i++) {
+                if (fleas.active[i] && fleas.row[i] == row && fleas.col[i] == col && canCollide(bullets, b, fleas, i)) {
+                    removeActor(bullets, b);
+                    if (++fleas.hits[i] == FLEA_MAX_HITS)
+                        removeFlea(i, true);
+                }
+            }
+        }
+
+        // Scorpions poison the mushrooms they walk over
+        for (std::size_t i = 0; i < scorpions.size(); i++) {
+            if (scorpions.active[i] && (scorpions.mask[i] & CollisionLayer::Mushroom))
+                m_mushrooms.poison(scorpions.row[i], scorpions.col[i]);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::updateTimers() {
+        // A disabled kind skips its spawn, its timer keeps running
+        for (const TimerWheel::Expiry& expiry : m_timers.advance()) {
+            switch (static_cast<TimerEvent>(expiry.event)) {
+                case TimerEvent::SpawnScorpion:
+                    m_scorpionTimer = m_timers.schedule(toTicks(m_settings.scorpionSpawnInterval), expiry.event);
+                    if (m_settings.enableScorpions)
+                        spawnScorpion();
+                    break;
+                case TimerEvent::SpawnFlea:
+                    if (m_settings.enableFleas)
+                        spawnFlea();
+                    else
+                        m_fleaTimer = m_timers.schedule(toTicks(m_settings.fleaSpawnInterval), expiry.event);
+                    break;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::cleanup() {
+        m_actors.compact();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::changeRow(std::size_t index) {
+        ActorArrays& segments = m_actors.get(ActorKind::CentipedeSegment);
+
+        // Descend until the bottom row, then ascend to the top of the player area and descend again
+        const int rows = static_cast<int>(m_settings.rows);
+        if (segments.row[index] == rows - 1)
+            segments.flags[index] &= ~ActorFlag::Descending;
+        else if (segments.row[index] == rows - static_cast<int>(m_settings.playerAreaHeight))
+            segments.flags[index] |= ActorFlag::Descending;
+
+        const bool isDescending = segments.flags[index] & ActorFlag::Descending;
+        segments.flags[index] |= ActorFlag::SwitchingRows;
+        segments.turnCol[index] = ActorArrays::NO_TURN;
+
+        // The diagonal move to the next row goes through mushrooms
+        segments.mask[index] &= ~CollisionLayer::Mushroom;
+        segments.nextDir[index] = getOpposite(segments.dir[index]);
+
+        if (segments.dir[index] == Direction::Right)
+            setDirection(segments, index, isDescending ? Direction::DownLeft : Direction::UpLeft);
+        else
+            setDirection(segments, index, isDescending ? Direction::DownRight : Direction::UpRight);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::addMushroom(int row, int col) {
+        m_mushrooms.add(row, col);
+        forgetTurns(row);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::forgetTurns(int row) {
+        ActorArrays& segments = m_actors.get(ActorKind::CentipedeSegment);
+        for (std::size_t i = 0; i < segments.size(); i++) {
+            if (segments.row[i] == row)
+                segments.turnCol[i] = ActorArrays::NO_TURN;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::createMushroomField() {
+        // A cell can only be occupied by one mushroom, the first and last rows and the wall row are kept free
+        const unsigned int freeRows = m_settings.rows - 3;
+        assert(m_settings.numMushrooms <= freeRows * m_settings.cols && "Too many mushrooms for the grid");
+
+        unsigned int count = std::min(m_settings.numMushrooms, freeRows * m_settings.cols);
+        while (count > 0) {
+            int row = m_random.range(1, static_cast<int>(m_settings.rows) - 2);
+            int col = m_random.range(0, static_cast<int>(m_settings.cols) - 1);
+            if (row == getWallRow() || isMushroomAt(row, col))
+                continue;
+
+            m_mushrooms.add(row, col);
+            count--;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::createPlayer(unsigned int player) {
+        // Players are spread evenly over the bottom row, a single player starts in the middle
+        const int row = static_cast<int>(m_settings.rows) - 1;
+        const int col = static_cast<int>((m_settings.cols - 1) * (2 * player + 1) / (2 * m_settings.numPlayers));
+        addActor(ActorKind::Player, row, col, Direction::Up);
+        m_lives.push_back(m_settings.playerLives);
+        m_hash ^= getLivesKey(player, m_settings.playerLives);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::createCentipede() {
+        ActorArrays& segments = m_actors.get(ActorKind::CentipedeSegment);
+        const int headCol = (static_cast<int>(m_settings.cols) - 1) / 2;
+
+        // The head leads, the body segments trail behind it to the left
+        std::int32_t prevSegment = ActorArrays::NO_LINK;
+        for (int i = 0; i < static_cast<int>(getCentipedeLength()); i++) {
+            auto type = (i == 0) ? ActorType::CentipedeHead : ActorType::CentipedeBody;
+            auto index = static_cast<std::int32_t>(addActor(ActorKind::CentipedeSegment, 0, headCol - i, Direction::Right, type));
+            segments.flags[index] = ActorFlag::Descending;
+
+            if (prevSegment != ActorArrays::NO_LINK)
+                segments.link[prevSegment] = index;
+
+            prevSegment = index;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::startNextLevel() {
+        m_level++;
+
+        // Actors of the cleared level are removed in place, the arrays keep their capacity
+        for (ActorKind kind : {ActorKind::Bullet, ActorKind::Scorpion, ActorKind::Flea}) {
+            ActorArrays& actors = m_actors.get(kind);
+            for (std::size_t i = 0; i < actors.size(); i++) {
+                if (actors.active[i])
+                    removeActor(actors, i);
+            }
+        }
+
+        m_actors.compact();
+        startSpawnTimers();
+
+        updateSteps();
+        createCentipede();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::startSpawnTimers() {
+        m_timers.cancel(m_scorpionTimer);
+        m_timers.cancel(m_fleaTimer);
+        m_scorpionTimer = m_timers.schedule(toTicks(m_settings.scorpionSpawnInterval), static_cast<std::uint32_t>(TimerEvent::SpawnScorpion));
+        m_fleaTimer = m_timers.schedule(toTicks(m_settings.fleaSpawnInterval), static_cast<std::uint32_t>(TimerEvent::SpawnFlea));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::spawnScorpion() {
+        // The scorpion and the player do not interact directly, i.e. it must not enter the player area
+        int row = m_random.range(0, getWallRow());
+
+        if (m_random.range(0, 1) == 0) // Spawn from the left of the grid
+            addActor(ActorKind::Scorpion, row, 0, Direction::Right);
+        else
+            addActor(ActorKind::Scorpion, row, static_cast<int>(m_settings.cols) - 1, Direction::Left);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::spawnFlea() {
+        int col = m_random.range(0, static_cast<int>(m_settings.cols) - 1);
+        addActor(ActorKind::Flea, 0, col, Direction::Down);
+
+        // There can only be one flea at a time
+        m_timers.cancel(m_fleaTimer);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::fireBullet(std::size_t player) {
+        // The intent is kept while the previous bullet is in flight
+        if (canShoot(player)) {
+            ActorArrays& players = m_actors.get(ActorKind::Player);
+            players.flags[player] &= ~ActorFlag::ShouldFire;
+            std::size_t bullet = addActor(ActorKind::Bullet, players.row[player], players.col[player], Direction::Up);
+            m_actors.get(ActorKind::Bullet).link[bullet] = static_cast<std::int32_t>(player);
+            m_bulletsFired++;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::killSegment(std::size_t index) {
+        ActorArrays& segments = m_actors.get(ActorKind::CentipedeSegment);
+        removeActor(segments, index);
+
+        // The segment behind the killed one leads the rest of the chain
+        std::int32_t link = segments.link[index];
+        if (link != ActorArrays::NO_LINK && segments.active[link]) {
+            m_hash ^= getActorKey(segments, link);
+            segments.type[link] = ActorType::CentipedeHead;
+            m_hash ^= getActorKey(segments, link);
+        }
+
+        // A shot segment turns into a mushroom
+        if (m_settings.enableMushrooms && !isMushroomAt(segments.row[index], segments.col[index]))
+            addMushroom(segments.row[index], segments.col[index]);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::removeFlea(std::size_t index, bool isKilled) {
+        removeActor(m_actors.get(ActorKind::Flea), index);
+
+        // A flea killed by the player is immediately replaced, otherwise the spawn timer starts over
+        if (isKilled)
+            spawnFlea();
+        else
+            m_fleaTimer = m_timers.schedule(toTicks(m_settings.fleaSpawnInterval), static_cast<std::uint32_t>(TimerEvent::SpawnFlea));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void World::updateSteps() {
+        m_steps[static_cast<std::size_t>(ActorKind::Player)] = toStep(m_settings.playerSpeed, m_settings);
+        m_steps[static_cast<std::size_t>(ActorKind::Bullet)] = toStep(m_settings.bulletSpeed, m_settings);
+        const float levelSpeed = m_settings.centipedeSpeed * (1.0f + m_settings.centipedeSpeedPerLevel * static_cast<float>(m_level - 1));
+        m_steps[static_cast<std::size_t>(ActorKind::CentipedeSegment)] = toStep(levelSpeed, m_settings);
+        m_steps[static_cast<std::size_t>(ActorKind::Scorpion)] = toStep(m_settings.scorpionSpeed, m_settings);
+        m_steps[static_cast<std::size_t>(ActorKind::Flea)] = toStep(m_settings.fleaSpeed, m_settings);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int World::getCentipedeLength() const {
+        unsigned int length = m_settings.centipedeLength + m_settings.centipedeLengthPerLevel * (m_level - 1);
+        return std::min(length, getMaxCentipedeLength());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int World::getMaxCentipedeLength() const {
+        return (m_settings.cols + 1) / 2;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint32_t World::toTicks(float seconds) const {
+        return std::max(1u, static_cast<std::uint32_t>(std::lround(seconds * static_cast<float>(m_settings.tickRate))));
+    }
+}
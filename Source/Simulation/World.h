@@ -0,0 +1,522 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_WORLD_H
+#define CENTIPEDE_WORLD_H
+
+#include "Source/Simulation/ActorStore.h"
+#include "Source/Simulation/MushroomField.h"
+#include "Source/Simulation/Random.h"
+#include "Source/Simulation/TimerWheel.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Parameters of a simulation
+     *
+     * Speeds are in pixels per second and intervals are in seconds
+     */
+    struct WorldSettings {
+        unsigned int rows = 0;                    //!< The number of rows in the grid
+        unsigned int cols = 0;                    //!< The number of columns in the grid
+        unsigned int tileSize = 16;               //!< The size of a tile in pixels
+        unsigned int tickRate = 120;              //!< The number of ticks per second
+        unsigned int playerAreaHeight = 6;        //!< The height of the players movement area in tiles
+        unsigned int numPlayers = 1;              //!< The number of players, at most World::MAX_PLAYERS
+        unsigned int numMushrooms = 50;           //!< The initial number of mushrooms
+        unsigned int centipedeLength = 18;        //!< The initial number of centipede segments
+        unsigned int centipedeLengthPerLevel = 1; //!< The number of segments added to the centipede each level
+        int playerLives = 3;                      //!< The initial number of player lives
+        float playerSpeed = 120.0f;               //!< The speed of the player
+        float bulletSpeed = 120.0f;               //!< The speed of bullets
+        float centipedeSpeed = 120.0f;            //!< The speed of centipede segments
+        float scorpionSpeed = 120.0f;             //!< The speed of scorpions
+        float fleaSpeed = 120.0f;                 //!< The speed of fleas
+        float centipedeSpeedPerLevel = 0.1f;      //!< The fraction of the centipede speed added each level
+        float scorpionSpawnInterval = 150.0f;     //!< The time between scorpion spawns
+        float fleaSpawnInterval = 30.0f;          //!< The time between flea spawns
+        bool enablePlayer = true;                 //!< Whether or not the player appears in the game
+        bool enableMushrooms = true;              //!< Whether or not mushrooms appear in the game
+        bool enableCentipedes = true;             //!< Whether or not centipedes appear in the game
+        bool enableScorpions = true;              //!< Whether or not scorpions appear in the game
+        bool enableFleas = true;                  //!< Whether or not fleas appear in the game
+    };
+
+    /**
+     * @brief The input of a player for one tick
+     *
+     * A fire press, and a move in a new direction made while the player
+     * is between tiles, are buffered by the world and carried out at the
+     * earliest tick the rules allow
+     */
+    struct PlayerInput {
+        Direction move = Direction::None; //!< The direction the player wants to move in
+        bool fire = false;                //!< True if the fire key was pressed since the last tick
+    };
+
+    /**
+     * @brief A position in pixels
+     */
+    struct Position {
+        float x; //!< Horizontal position of the centre of the actor
+        float y; //!< Vertical position of the centre of the actor
+    };
+
+    /**
+     * @brief The gameplay simulation
+     *
+     * The world owns the simulation data of every actor in an ActorStore
+     * and advances it one fixed tick at a time. Each tick runs a movement
+     * pass per actor kind, a collision pass and a cleanup pass, each of
+     * which walks the actor arrays linearly. Mushrooms do not move and are
+     * kept as tile data in a MushroomField instead. The world has no dependency
+     * on the engine, game objects only mirror its state for rendering
+     *
+     * Actors move from tile to tile. A move may start when an actor is not
+     * moving and the target tile is not blocked. Collisions happen between
+     * actors that occupy the same tile and whose collision layers match,
+     * see ActorArrays and CollisionLayer
+     *
+     * A world is a value: copying it takes a snapshot of the whole
+     * simulation, and assigning a snapshot back restores it. Assigning
+     * between worlds of the same grid reuses their storage
+     *
+     * The world keeps a hash of its state (Zobrist hashing) that is updated
+     * in constant time whenever an actor is added, moves, turns, changes
+     * type or is removed, see getStateHash. Simulations that diverge are
+     * found by comparing the hashes of each tick
+     */
+    class World {
+    public:
+        static constexpr std::uint16_t TILE_UNITS = 1u << 14;      //!< The length of a tile in movement units
+        static constexpr std::size_t MAX_PLAYERS = 2;              //!< The maximum number of players
+        using PlayerInputs = std::array<PlayerInput, MAX_PLAYERS>; //!< The input of each player for one tick
+
+        /**
+         * @brief Constructor
+         * @param settings The parameters of the simulation
+         * @param seed The seed of the random number generator
+         *
+         * The same settings, seed and inputs always produce the same simulation
+         */
+        explicit World(const WorldSettings& settings, std::uint64_t seed = 0);
+
+        /**
+         * @brief Create the initial actors
+         */
+        void start();
+
+        /**
+         * @brief Advance the simulation by one tick
+         * @param inputs The input of each player for this tick
+         *
+         * The tick that kills the last centipede segment also starts the
+         * next level, see getLevel
+         */
+        void tick(const PlayerInputs& inputs);
+
+        /**
+         * @brief Advance a single player simulation by one tick
+         * @param input The input of the first player for this tick
+         */
+        void tick(const PlayerInput& input);
+
+        /**
+         * @brief Get the current level
+         * @return The current level, starting at 1
+         *
+         * A level ends when every segment of its centipede is killed. The
+         * next level starts in the same tick: the bullets, scorpions and
+         * fleas of the cleared level are removed, the spawn timers start
+         * over and a longer and faster centipede enters the grid. The player
+         * and the mushrooms are kept and the actor arrays keep their capacity
+         */
+        unsigned int getLevel() const;
+
+        /**
+         * @brief Change the settings of a running simulation
+         * @param settings The new settings
+         *
+         * Only the tick rate, speeds, spawn intervals and the enabled
+         * mushrooms, scorpions and fleas are changed, the size of the grid
+         * and the initial actors are kept. Actors that are moving keep
+         * their progress and continue at the new speed. A spawn timer
+         * whose interval changed starts counting down again. This function
+         * must only be called between ticks
+         */
+        void applySettings(const WorldSettings& settings);
+
+        /**
+         * @brief Get the parameters of the simulation
+         * @return The parameters of the simulation
+         */
+        const WorldSettings& getSettings() const;
+
+        /**
+         * @brief Get the actors of a kind
+         * @param kind The kind of actors to get
+         * @return The actors of the given kind
+         */
+        const ActorArrays& getActors(ActorKind kind) const;
+
+        /**
+         * @brief Get the distance the actors of a kind move per tick
+         * @param kind The kind of actor
+         * @return The distance moved per tick in TILE_UNITS
+         */
+        std::uint16_t getStep(ActorKind kind) const;
+
+        /**
+         * @brief Get the position of an actor
+         * @param kind The kind of the actor
+         * @param index The index of the actor in its arrays
+         * @param alpha How far to blend from the position before the last tick to the current one, in the range [0, 1]
+         * @return The position of the centre of the actor in pixels
+         *
+         * Rendering lags one tick behind the simulation: an @a alpha of 0
+         * gives the position at the start of the last tick and an @a alpha
+         * of 1 the current position, which is the default. An actor added
+         * during the last tick starts from its spawn tile
+         */
+        Position getPosition(ActorKind kind, std::size_t index, float alpha = 1.0f) const;
+
+        /**
+         * @brief Check if a player can fire a bullet
+         * @param player The index of the player
+         * @return True if the player has no bullet in flight, otherwise false
+         */
+        bool canShoot(std::size_t player) const;
+
+        /**
+         * @brief Get the number of lives of a player
+         * @param player The index of the player
+         * @return The number of lives of the player
+         */
+        int getLives(std::size_t player) const;
+
+        /**
+         * @brief Check if there is a mushroom in a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if there is a mushroom in the tile, otherwise false
+         */
+        bool isMushroomAt(int row, int col) const;
+
+        /**
+         * @brief Get the mushrooms
+         * @return The mushroom of each tile
+         */
+        const MushroomField& getMushrooms() const;
+
+        /**
+         * @brief Get the row that separates the player area from the rest of the grid
+         * @return The row the player cannot enter
+         */
+        int getWallRow() const;
+
+        /**
+         * @brief Get the number of ticks simulated so far
+         * @return The number of ticks simulated so far
+         */
+        std::uint64_t getTickCount() const;
+
+        /**
+         * @brief Get the number of bullets fired so far
+         * @return The number of bullets fired by all players
+         */
+        std::uint64_t getBulletsFired() const;
+
+        /**
+         * @brief Get the hash of the state of the simulation
+         * @return The hash of the state
+         *
+         * The hash covers the tile, type and direction of every actor, the
+         * hits and poison of every mushroom and the lives of the players.
+         * Simulations in the same state have the same hash, different states
+         * almost certainly have different hashes. The hash is maintained as
+         * the world changes, getting it is free
+         */
+        std::uint64_t getStateHash() const;
+
+        /**
+         * @brief Compute the hash of the state from scratch
+         * @return The hash of the state
+         *
+         * This function visits every actor and mushroom and always returns
+         * the same value as getStateHash, it exists to check that the hash
+         * is maintained correctly
+         */
+        std::uint64_t computeStateHash() const;
+
+    private:
+        /**
+         * @brief Move the actor towards its tile
+         * @param actors The arrays of the actor
+         * @param index The index of the actor
+         * @param budget The distance the actor can still move this tick
+         * @return True if the actor reached its tile, otherwise false
+         */
+        static bool advance(ActorArrays& actors, std::size_t index, std::uint32_t& budget);
+
+        /**
+         * @brief Start moving the actor to an adjacent tile
+         * @param actors The arrays of the actor
+         * @param index The index of the actor
+         * @param dir The direction of the adjacent tile
+         * @param budget The distance the actor can still move this tick
+         */
+        void beginMove(ActorArrays& actors, std::size_t index, Direction dir, std::uint32_t& budget);
+
+        /**
+         * @brief Change the direction of an actor
+         * @param actors The arrays of the actor
+         * @param index The index of the actor
+         * @param dir The new direction
+         */
+        void setDirection(ActorArrays& actors, std::size_t index, Direction dir);
+
+        /**
+         * @brief Add an actor
+         * @param kind The kind of the actor
+         * @param row The row of the tile the actor starts in
+         * @param col The column of the tile the actor starts in
+         * @param dir The initial movement direction
+         * @param type The kind specific type of the actor
+         * @return The index of the actor in the arrays of its kind
+         */
+        std::size_t addActor(ActorKind kind, int row, int col, Direction dir, std::uint8_t type = 0);
+
+        /**
+         * @brief Deactivate an actor, it is removed at the end of the tick
+         * @param actors The arrays of the actor
+         * @param index The index of the actor
+         */
+        void removeActor(ActorArrays& actors, std::size_t index);
+
+        /**
+         * @brief Get the hash key of an actor
+         * @param actors The arrays of the actor
+         * @param index The index of the actor
+         * @return The key of the actor in its current tile, type and direction
+         */
+        static std::uint64_t getActorKey(const ActorArrays& actors, std::size_t index);
+
+        /**
+         * @brief Check if two actors collide when they occupy the same tile
+         * @param first The arrays of the first actor
+         * @param firstIndex The index of the first actor
+         * @param second The arrays of the second actor
+         * @param secondIndex The index of the second actor
+         * @return True if each actor is in the collision mask of the other, otherwise false
+         */
+        static bool canCollide(const ActorArrays& first, std::size_t firstIndex, const ActorArrays& second, std::size_t secondIndex);
+
+        /**
+         * @brief Check if an actor is blocked from entering a tile
+         * @param actors The arrays of the actor
+         * @param index The index of the actor
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if the tile has a mushroom or wall that is in the collision mask of the actor, otherwise false
+         */
+        bool isBlocked(const ActorArrays& actors, std::size_t index, int row, int col) const;
+
+        /**
+         * @brief Check if a tile is inside the grid
+         * @param row The row of the tile
+         * @param col The column of the tile
+         * @return True if the tile is inside the grid, otherwise false
+         */
+        bool isInGrid(int row, int col) const;
+
+        /**
+         * @brief Remember the position of every actor before it moves
+         */
+        void savePositions();
+
+        /**
+         * @brief Move the players and carry out their buffered intents
+         * @param inputs The input of each player for the tick
+         */
+        void movePlayers(const PlayerInputs& inputs);
+
+        /**
+         * @brief Move the bullets up, removing those that leave the grid
+         */
+        void moveBullets();
+
+        /**
+         * @brief Move the centipede segments, switching rows when they are blocked
+         */
+        void moveCentipedes();
+
+        /**
+         * @brief Move the scorpions across the grid, removing those that reach the other side
+         */
+        void moveScorpions();
+
+        /**
+         * @brief Move the fleas down, dropping mushrooms on the way
+         */
+        void moveFleas();
+
+        /**
+         * @brief Apply the hits of bullets and the poison of scorpions
+         *
+         * A bullet is destroyed by the first mushroom or actor in its tile
+         */
+        void resolveCollisions();
+
+        /**
+         * @brief Advance the timer wheel and spawn the actors whose timer expired
+         */
+        void updateTimers();
+
+        /**
+         * @brief Remove the actors that were killed or left the grid during the tick
+         */
+        void cleanup();
+
+        /**
+         * @brief Make a centipede segment move diagonally to the next row
+         * @param index The index of the segment
+         */
+        void changeRow(std::size_t index);
+
+        /**
+         * @brief Place a mushroom in a tile
+         * @param row The row of the tile
+         * @param col The column of the tile
+         */
+        void addMushroom(int row, int col);
+
+        /**
+         * @brief Make the centipede segments in a row look for their next turn again
+         * @param row The row whose mushrooms changed
+         */
+        void forgetTurns(int row);
+
+        /**
+         * @brief Place the initial mushrooms in random free tiles
+         */
+        void createMushroomField();
+
+        /**
+         * @brief Add a player to the bottom row of the grid
+         * @param player The index of the player
+         */
+        void createPlayer(unsigned int player);
+
+        /**
+         * @brief Add the centipede of the current level to the top row
+         */
+        void createCentipede();
+
+        /**
+         * @brief Clear the enemies of the finished level and start the next one
+         */
+        void startNextLevel();
+
+        /**
+         * @brief Schedule the scorpion and flea spawn timers from now
+         */
+        void startSpawnTimers();
+
+        /**
+         * @brief Add a scorpion to a random row above the player area
+         */
+        void spawnScorpion();
+
+        /**
+         * @brief Add a flea to a random column of the top row
+         */
+        void spawnFlea();
+
+        /**
+         * @brief Fire a bullet from a player if it can shoot
+         * @param player The index of the player
+         */
+        void fireBullet(std::size_t player);
+
+        /**
+         * @brief Kill a centipede segment
+         * @param index The index of the segment
+         *
+         * The segment behind it becomes a head and a mushroom is left in its tile
+         */
+        void killSegment(std::size_t index);
+
+        /**
+         * @brief Remove a flea
+         * @param index The index of the flea
+         * @param isKilled True if a player killed the flea, false if it left the grid
+         */
+        void removeFlea(std::size_t index, bool isKilled);
+
+        /**
+         * @brief Compute the distance each kind moves per tick from the settings
+         */
+        void updateSteps();
+
+        /**
+         * @brief Get the length of the centipede of the current level
+         * @return The number of segments the centipede starts with
+         */
+        unsigned int getCentipedeLength() const;
+
+        /**
+         * @brief Get the maximum length of a centipede
+         * @return The number of segments that fit between the centre and the left of the grid
+         */
+        unsigned int getMaxCentipedeLength() const;
+
+        /**
+         * @brief Convert a duration into ticks
+         * @param seconds The duration in seconds
+         * @return The number of ticks, at least one
+         */
+        std::uint32_t toTicks(float seconds) const;
+
+    private:
+        static constexpr std::size_t NUM_KINDS = static_cast<std::size_t>(ActorKind::Count);
+        WorldSettings m_settings;                     //!< Simulation parameters
+        ActorStore m_actors;                          //!< Simulation data of all actors
+        Random m_random;                              //!< Deterministic random number generator
+        std::array<std::uint16_t, NUM_KINDS> m_steps; //!< Distance moved per tick by each kind
+        MushroomField m_mushrooms;                    //!< Mushroom of each tile
+        std::vector<int> m_lives;                     //!< Lives of each player
+        std::uint32_t m_nextId;                       //!< Id of the next actor to be created
+        std::uint64_t m_tickCount;                    //!< Number of ticks simulated so far
+        std::uint64_t m_bulletsFired;                 //!< Number of bullets fired so far
+        unsigned int m_level;                         //!< The current level
+        TimerWheel m_timers;                          //!< Gameplay timers, driven by the ticks
+        TimerWheel::TimerId m_scorpionTimer;          //!< Spawns the next scorpion
+        TimerWheel::TimerId m_fleaTimer;              //!< Spawns the next flea, cancelled while a flea is in the grid
+        std::uint64_t m_hash;                         //!< Hash of the active actors and the lives, see getStateHash
+    };
+}
+
+#endif //CENTIPEDE_WORLD_H
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Spectator/SpectatorEncoder.h"
+#include "Source/Spectator/VarInt.h"
+#include <algorithm>
+
+namespace centpd {
+    namespace {
+        const std::size_t TILES_PER_CHUNK = MushroomField::CHUNK_SIZE * MushroomField::CHUNK_SIZE;
+        const std::size_t NO_TILES = ~std::size_t{0};
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SpectatorEncoder::SpectatorEncoder() :
+        m_messageTick{0},
+        m_hasPrevious{false},
+        m_rows{0},
+        m_cols{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorEncoder::encodeDelta(const World& world, std::vector<std::uint8_t>& message) {
+        capture(world, m_current);
+        captureMushrooms(world.getMushrooms());
+
+        bool isChanged;
+        if (!m_hasPrevious) {
+            isChanged = true;
+            m_hasPrevious = true;
+            encode(m_empty, m_current, MessageType::Keyframe, m_current.m_tick, message);
+        } else
+            isChanged = encode(m_previous, m_current, MessageType::Delta, m_current.m_tick - m_messageTick, message);
+
+        // Unchanged ticks are folded into the tick field of the next message
+        if (isChanged) {
+            m_messageTick = m_current.m_tick;
+            std::swap(m_previous, m_current);
+        } else
+            message.clear();
+
+        return isChanged;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorEncoder::encodeKeyframe(std::vector<std::uint8_t>& message) {
+        listMushrooms();
+        encode(m_empty, m_previous, MessageType::Keyframe, m_messageTick, message);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorEncoder::capture(const World& world, SpectatorState& state) {
+        const MushroomField& mushrooms = world.getMushrooms();
+        state.m_tick = world.getTickCount();
+        state.m_rows = mushrooms.getRows();
+        state.m_cols = mushrooms.getCols();
+        state.m_level = world.getLevel();
+
+        const ActorArrays& players = world.getActors(ActorKind::Player);
+        state.m_lives.resize(players.size());
+        for (std::size_t i = 0; i < players.size(); i++)
+            state.m_lives[i] = world.getLives(i);
+
+        // Actors are appended in the order of their ids and removed in place, so each kind is already sorted
+        for (std::size_t k = 0; k < SpectatorState::NUM_KINDS; k++) {
+            const ActorArrays& actors = world.getActors(static_cast<ActorKind>(k));
+            std::vector<SpectatorActor>& captured = state.m_actors[k];
+            captured.clear();
+
+            for (std::size_t i = 0; i < actors.size(); i++) {
+                if (actors.active[i])
+                    captured.push_back(SpectatorActor{actors.id[i], actors.row[i], actors.col[i], actors.dir[i], actors.type[i]});
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorEncoder::captureMushrooms(const MushroomField& field) {
+        if (field.getRows() != m_rows || field.getCols() != m_cols) {
+            m_rows = field.getRows();
+            m_cols = field.getCols();
+            m_chunkVersions.assign(field.getChunkRows() * field.getChunkCols(), 0);
+            m_chunkTiles.assign(m_chunkVersions.size(), NO_TILES);
+            m_tiles.clear();
+        }
+
+        // Chunks the field never allocated have version 0, they have no mushrooms to compare
+        m_tileChanges.clear();
+        const unsigned int chunkSize = MushroomField::CHUNK_SIZE;
+        for (unsigned int chunkRow = 0; chunkRow < field.getChunkRows(); chunkRow++) {
+            for (unsigned int chunkCol = 0; chunkCol < field.getChunkCols(); chunkCol++) {
+                const std::size_t chunk = chunkRow * field.getChunkCols() + chunkCol;
+                const std::uint64_t version = field.getChunkVersion(chunkRow, chunkCol);
+                if (version == m_chunkVersions[chunk])
+                    continue;
+
+                m_chunkVersions[chunk] = version;
+                if (m_chunkTiles[chunk] == NO_TILES) {
+                    m_chunkTiles[chunk] = m_tiles.size();
+                    m_tiles.resize(m_tiles.size() + TILES_PER_CHUNK, 0);
+                }
+
+                std::uint8_t* tiles = &m_tiles[m_chunkTiles[chunk]];
+                const unsigned int lastRow = std::min((chunkRow + 1) * chunkSize, m_rows);
+                const unsigned int lastCol = std::min((chunkCol + 1) * chunkSize, m_cols);
+                for (unsigned int row = chunkRow * chunkSize; row < lastRow; row++) {
+                    for (unsigned int col = chunkCol * chunkSize; col < lastCol; col++) {
+                        const std::uint8_t tile = field.getTile(static_cast<int>(row), static_cast<int>(col));
+                        std::uint8_t& known = tiles[(row % chunkSize) * chunkSize + col % chunkSize];
+                        if (tile != known) {
+                            known = tile;
+                            m_tileChanges.push_back(TileChange{row * m_cols + col, tile});
+                        }
+                    }
+                }
+            }
+        }
+
+        // Tiles are visited chunk by chunk, the stream lists them in the order of the grid
+        std::sort(m_tileChanges.begin(), m_tileChanges.end(), [](const TileChange& lhs, const TileChange& rhs) {
+            return lhs.tile < rhs.tile;
+        });
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorEncoder::listMushrooms() {
+        m_tileChanges.clear();
+        const unsigned int chunkSize = MushroomField::CHUNK_SIZE;
+        const unsigned int chunkCols = (m_cols + chunkSize - 1) / chunkSize;
+        for (std::size_t chunk = 0; chunk < m_chunkTiles.size(); chunk++) {
+            if (m_chunkTiles[chunk] == NO_TILES)
+                continue;
+
+            // Tiles outside the grid are never set, so only tiles of the grid have a value
+            const auto firstRow = static_cast<unsigned int>(chunk / chunkCols) * chunkSize;
+            const auto firstCol = static_cast<unsigned int>(chunk % chunkCols) * chunkSize;
+            for (std::size_t i = 0; i < TILES_PER_CHUNK; i++) {
+                const std::uint8_t tile = m_tiles[m_chunkTiles[chunk] + i];
+                const auto row = firstRow + static_cast<unsigned int>(i / chunkSize);
+                const auto col = firstCol + static_cast<unsigned int>(i % chunkSize);
+                if (tile != 0)
+                    m_tileChanges.push_back(TileChange{row * m_cols + col, tile});
+            }
+        }
+
+        std::sort(m_tileChanges.begin(), m_tileChanges.end(), [](const TileChange& lhs, const TileChange& rhs) {
+            return lhs.tile < rhs.tile;
+        });
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorEncoder::encode(const SpectatorState& from, const SpectatorState& to, MessageType type,
+        std::uint64_t tick, std::vector<std::uint8_t>& message)
+    {
+        bool isChanged = false;
+        m_payload.clear();
+        m_payload.push_back(static_cast<std::uint8_t>(type));
+        writeVarint(m_payload, tick);
+
+        if (type == MessageType::Keyframe) {
+            writeVarint(m_payload, to.m_rows);
+            writeVarint(m_payload, to.m_cols);
+        }
+
+        isChanged |= to.m_level != from.m_level;
+        writeVarint(m_payload, to.m_level != from.m_level ? to.m_level : 0);
+
+        m_section.clear();
+        std::size_t numChanges = 0;
+        for (std::size_t i = 0; i < to.m_lives.size(); i++) {
+            if (i >= from.m_lives.size() || to.m_lives[i] != from.m_lives[i]) {
+                writeVarint(m_section, i);
+                writeSignedVarint(m_section, to.m_lives[i]);
+                numChanges++;
+            }
+        }
+
+        isChanged |= numChanges > 0;
+        writeVarint(m_payload, numChanges);
+        m_payload.insert(m_payload.end(), m_section.begin(), m_section.end());
+
+        // The kind mask is filled in once it is known which kinds changed
+        const std::size_t maskPosition = m_payload.size();
+        m_payload.push_back(0);
+        for (std::size_t k = 0; k < SpectatorState::NUM_KINDS; k++) {
+            if (encodeActors(from.m_actors[k], to.m_actors[k])) {
+                m_payload[maskPosition] |= static_cast<std::uint8_t>(1u << k);
+                isChanged = true;
+            }
+        }
+
+        std::uint32_t prevTile = 0;
+        isChanged |= !m_tileChanges.empty();
+        writeVarint(m_payload, m_tileChanges.size());
+        for (const TileChange& change : m_tileChanges) {
+            writeVarint(m_payload, change.tile - prevTile);
+            m_payload.push_back(change.value);
+            prevTile = change.tile;
+        }
+
+        message.clear();
+        writeVarint(message, m_payload.size());
+        message.insert(message.end(), m_payload.begin(), m_payload.end());
+        return isChanged;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorEncoder::encodeActors(const std::vector<SpectatorActor>& from, const std::vector<SpectatorActor>& to) {
+        m_spawned.clear();
+        m_destroyed.clear();
+        m_changed.clear();
+
+        // Both lists are sorted by id, a single merge pass finds every difference
+        std::size_t i = 0, j = 0;
+        while (i < from.size() || j < to.size()) {
+            if (j == to.size() || (i < from.size() && from[i].id < to[j].id))
+                m_destroyed.push_back(from[i++].id);
+            else if (i == from.size() || to[j].id < from[i].id)
+                m_spawned.push_back(&to[j++]);
+            else {
+                const SpectatorActor& before = from[i++];
+                const SpectatorActor& after = to[j++];
+                if (before.row != after.row || before.col != after.col || before.dir != after.dir || before.type != after.type)
+                    m_changed.emplace_back(&before, &after);
+            }
+        }
+
+        if (m_spawned.empty() && m_destroyed.empty() && m_changed.empty())
+            return false;
+
+        std::uint32_t prevId = 0;
+        writeVarint(m_payload, m_spawned.size());
+        for (const SpectatorActor* actor : m_spawned) {
+            writeVarint(m_payload, actor->id - prevId);
+            writeVarint(m_payload, static_cast<std::uint16_t>(actor->row));
+            writeVarint(m_payload, static_cast<std::uint16_t>(actor->col));
+            m_payload.push_back(static_cast<std::uint8_t>(actor->dir));
+            m_payload.push_back(actor->type);
+            prevId = actor->id;
+        }
+
+        prevId = 0;
+        writeVarint(m_payload, m_destroyed.size());
+        for (std::uint32_t id : m_destroyed) {
+            writeVarint(m_payload, id - prevId);
+            prevId = id;
+        }
+
+        prevId = 0;
+        writeVarint(m_payload, m_changed.size());
+        for (const auto& [before, after] : m_changed) {
+            std::uint8_t mask = 0;
+            mask |= before->row != after->row ? RowChanged : 0;
+            mask |= before->col != after->col ? ColChanged : 0;
+            mask |= before->dir != after->dir ? DirChanged : 0;
+            mask |= before->type != after->type ? TypeChanged : 0;
+
+            writeVarint(m_payload, after->id - prevId);
+            m_payload.push_back(mask);
+            if (mask & RowChanged)
+                writeSignedVarint(m_payload, after->row - before->row);
+            if (mask & ColChanged)
+                writeSignedVarint(m_payload, after->col - before->col);
+            if (mask & DirChanged)
+                m_payload.push_back(static_cast<std::uint8_t>(after->dir));
+            if (mask & TypeChanged)
+                m_payload.push_back(after->type);
+
+            prevId = after->id;
+        }
+
+        return true;
+    }
+}
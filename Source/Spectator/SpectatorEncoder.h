@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPECTATORENCODER_H
+#define CENTIPEDE_SPECTATORENCODER_H
+
+#include "Source/Spectator/SpectatorState.h"
+#include "Source/Simulation/World.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Encodes the changes of a world into a spectator stream
+     *
+     * A stream is a sequence of messages, each prefixed with its length.
+     * A keyframe carries the whole state, every other message only carries
+     * what changed since the previous message, so the size of the stream
+     * depends on how much happens in the game rather than on the size of
+     * the grid. Ticks without changes produce no message at all
+     *
+     * Integers are LEB128 varints, signed ones are zigzag encoded (see
+     * VarInt.h). Lists of ids are sorted and each id is written as the
+     * difference to the previous one, starting from 0. A message is:
+     *
+     *  length    varint   The size of the rest of the message
+     *  type      1 byte   0 for a keyframe, 1 for a delta
+     *  tick      varint   The tick of a keyframe, or the ticks since the previous message
+     *  rows      varint   Keyframes only: the number of rows in the grid
+     *  cols      varint   Keyframes only: the number of columns in the grid
+     *  level     varint   The new level, 0 if it did not change
+     *  lives     varint   The number of players whose lives changed, then for each
+     *                     the player (varint) and the lives (signed varint)
+     *  kinds     1 byte   A bit per actor kind that changed, then for each of them:
+     *    spawned   varint The number of spawned actors, then for each the id, row
+     *                     and column (varints), the direction and the type (1 byte each)
+     *    destroyed varint The number of destroyed actors, then their ids
+     *    changed   varint The number of changed actors, then for each the id and a
+     *                     mask of what changed (1 byte): the row and column changes
+     *                     (signed varints), the direction and the type (1 byte each)
+     *  mushrooms varint   The number of tiles that changed, then for each the index
+     *                     of the tile (row * cols + col, as an id) and its new value (1 byte)
+     *
+     * The encoder keeps its own copy of the mushrooms known to the
+     * spectator, chunk by chunk like the MushroomField. Only the chunks
+     * whose version changed since the previous message are compared, so
+     * neither the memory of the encoder nor the time it takes per tick
+     * depend on the size of the grid
+     */
+    class SpectatorEncoder {
+    public:
+        /**
+         * @brief Message types
+         */
+        enum class MessageType : std::uint8_t {
+            Keyframe, //!< The whole state
+            Delta     //!< The changes since the previous message
+        };
+
+        /**
+         * @brief Bits of the mask of a changed actor
+         */
+        enum ChangeMask : std::uint8_t {
+            RowChanged = 1,
+            ColChanged = 2,
+            DirChanged = 4,
+            TypeChanged = 8
+        };
+
+        /**
+         * @brief Default constructor
+         */
+        SpectatorEncoder();
+
+        /**
+         * @brief Encode the changes of the world since the previous call
+         * @param world The world to encode
+         * @param message Receives the message, it is cleared first
+         * @return True if something changed, false if there is no message
+         *
+         * The first call produces a keyframe
+         */
+        bool encodeDelta(const World& world, std::vector<std::uint8_t>& message);
+
+        /**
+         * @brief Encode the state of the last encoded world as a keyframe
+         * @param message Receives the message, it is cleared first
+         *
+         * The deltas that follow the keyframe apply to it, which allows a
+         * spectator to join a running stream
+         */
+        void encodeKeyframe(std::vector<std::uint8_t>& message);
+
+    private:
+        /**
+         * @brief Capture the state of a world
+         * @param world The world to capture
+         * @param state Receives the state
+         */
+        static void capture(const World& world, SpectatorState& state);
+
+        /**
+         * @brief Find the tiles that changed since the previous message
+         * @param field The mushrooms of the world being encoded
+         *
+         * The changes are stored in the tile changes, sorted by tile, and
+         * applied to the copy of the mushrooms known to the spectator
+         */
+        void captureMushrooms(const MushroomField& field);
+
+        /**
+         * @brief Store every mushroom known to the spectator in the tile changes
+         *
+         * A keyframe is encoded against an empty field, so its changes are all the mushrooms
+         */
+        void listMushrooms();
+
+        /**
+         * @brief Encode the differences between two states
+         * @param from The state known to the spectator
+         * @param to The new state
+         * @param type The type of message to encode
+         * @param tick The tick field of the message
+         * @param message Receives the message
+         * @return True if the states differ, otherwise false
+         *
+         * The mushrooms are not part of the states, the tile changes are encoded instead
+         */
+        bool encode(const SpectatorState& from, const SpectatorState& to, MessageType type, std::uint64_t tick,
+            std::vector<std::uint8_t>& message);
+
+        /**
+         * @brief Encode the differences between the actors of one kind
+         * @param from The actors known to the spectator, sorted by id
+         * @param to The new actors, sorted by id
+         * @return True if the actors differ, otherwise false
+         */
+        bool encodeActors(const std::vector<SpectatorActor>& from, const std::vector<SpectatorActor>& to);
+
+    private:
+        using ActorChange = std::pair<const SpectatorActor*, const SpectatorActor*>;
+
+        /**
+         * @brief The new value of a tile
+         */
+        struct TileChange {
+            std::uint32_t tile; //!< The index of the tile, row * cols + col
+            std::uint8_t value; //!< The new value of the tile
+        };
+
+        SpectatorState m_previous;                    //!< The state of the last message
+        SpectatorState m_current;                     //!< The state being encoded
+        SpectatorState m_empty;                       //!< The state a keyframe is encoded against
+        std::uint64_t m_messageTick;                  //!< The tick of the last message
+        bool m_hasPrevious;                           //!< A flag indicating whether or not a world was encoded
+        std::vector<std::uint8_t> m_payload;          //!< Scratch buffer of the message without its length
+        std::vector<std::uint8_t> m_section;          //!< Scratch buffer of the list being encoded
+        std::vector<const SpectatorActor*> m_spawned; //!< Scratch list of spawned actors
+        std::vector<std::uint32_t> m_destroyed;       //!< Scratch list of destroyed actor ids
+        std::vector<ActorChange> m_changed;           //!< Scratch list of changed actors, before and after the change
+        unsigned int m_rows;                          //!< The number of rows of the field the mushrooms belong to
+        unsigned int m_cols;                          //!< The number of columns of the field the mushrooms belong to
+        std::vector<std::uint64_t> m_chunkVersions;   //!< The version of each chunk of the field as of the last message
+        std::vector<std::size_t> m_chunkTiles;        //!< The index of the first tile of each chunk in m_tiles, or NO_TILES
+        std::vector<std::uint8_t> m_tiles;            //!< The mushrooms known to the spectator, chunk by chunk
+        std::vector<TileChange> m_tileChanges;        //!< Scratch list of changed tiles, sorted by tile
+    };
+}
+
+#endif //CENTIPEDE_SPECTATORENCODER_H
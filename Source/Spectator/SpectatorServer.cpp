@@ -0,0 +1,250 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Spectator/SpectatorServer.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace centpd {
+    namespace {
+        const std::intptr_t NO_SOCKET = -1;
+
+        // A spectator that disconnects must not raise SIGPIPE
+#ifdef MSG_NOSIGNAL
+        const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+        const int SEND_FLAGS = 0;
+#endif
+
+        ///////////////////////////////////////////////////////////////
+        void closeSocket(std::intptr_t socket) {
+#ifdef _WIN32
+            ::closesocket(static_cast<SOCKET>(socket));
+#else
+            ::close(static_cast<int>(socket));
+#endif
+        }
+
+        ///////////////////////////////////////////////////////////////
+        void setNonBlocking(std::intptr_t socket) {
+#ifdef _WIN32
+            u_long isNonBlocking = 1;
+            ::ioctlsocket(static_cast<SOCKET>(socket), FIONBIO, &isNonBlocking);
+#else
+            ::fcntl(static_cast<int>(socket), F_SETFL, ::fcntl(static_cast<int>(socket), F_GETFL, 0) | O_NONBLOCK);
+#endif
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SpectatorServer::SpectatorServer() :
+        m_socket{NO_SOCKET},
+        m_streamSize{0}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorServer::openFile(const std::string& filename) {
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        return m_file.is_open();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorServer::listenTcp(std::uint16_t port) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (::WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+            return false;
+
+        auto socket = static_cast<std::intptr_t>(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+        if (socket == static_cast<std::intptr_t>(INVALID_SOCKET)) {
+            ::WSACleanup();
+            return false;
+        }
+#else
+        std::intptr_t socket = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (socket < 0)
+            return false;
+#endif
+
+        int reuse = 1;
+        ::setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(socket, 4) != 0) {
+            closeSocket(socket);
+#ifdef _WIN32
+            ::WSACleanup();
+#endif
+            return false;
+        }
+
+        return listen(socket);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorServer::listenUnix(const std::string& path) {
+#ifdef _WIN32
+        (void) path;
+        return false;
+#else
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path))
+            return false;
+
+        std::intptr_t socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (socket < 0)
+            return false;
+
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        ::unlink(path.c_str());
+
+        if (::bind(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(socket, 4) != 0) {
+            closeSocket(socket);
+            return false;
+        }
+
+        m_unixPath = path;
+        return listen(socket);
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorServer::isOpen() const {
+        return m_file.is_open() || m_socket != NO_SOCKET;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorServer::publish(const World& world) {
+        if (m_encoder.encodeDelta(world, m_message)) {
+            m_streamSize += m_message.size();
+
+            if (m_file.is_open()) {
+                m_file.write(reinterpret_cast<const char*>(m_message.data()), static_cast<std::streamsize>(m_message.size()));
+                m_file.flush();
+            }
+
+            // A spectator that misses a message can no longer follow the stream
+            m_spectators.erase(std::remove_if(m_spectators.begin(), m_spectators.end(), [this](std::intptr_t spectator) {
+                if (send(spectator, m_message))
+                    return false;
+
+                closeSocket(spectator);
+                return true;
+            }), m_spectators.end());
+        }
+
+        if (m_socket != NO_SOCKET)
+            acceptSpectators();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::size_t SpectatorServer::getSpectatorCount() const {
+        return m_spectators.size();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t SpectatorServer::getStreamSize() const {
+        return m_streamSize;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorServer::close() {
+        if (m_file.is_open())
+            m_file.close();
+
+        for (std::intptr_t spectator : m_spectators)
+            closeSocket(spectator);
+
+        m_spectators.clear();
+
+        if (m_socket != NO_SOCKET) {
+            closeSocket(m_socket);
+            m_socket = NO_SOCKET;
+
+#ifdef _WIN32
+            ::WSACleanup();
+#else
+            if (!m_unixPath.empty())
+                ::unlink(m_unixPath.c_str());
+#endif
+            m_unixPath.clear();
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorServer::listen(std::intptr_t socket) {
+        setNonBlocking(socket);
+        m_socket = socket;
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void SpectatorServer::acceptSpectators() {
+        while (true) {
+            auto spectator = static_cast<std::intptr_t>(::accept(m_socket, nullptr, nullptr));
+#ifdef _WIN32
+            if (spectator == static_cast<std::intptr_t>(INVALID_SOCKET))
+                return;
+#else
+            if (spectator < 0)
+                return;
+#endif
+
+            setNonBlocking(spectator);
+            m_encoder.encodeKeyframe(m_keyframe);
+            if (send(spectator, m_keyframe))
+                m_spectators.push_back(spectator);
+            else
+                closeSocket(spectator);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorServer::send(std::intptr_t spectator, const std::vector<std::uint8_t>& data) {
+        auto sent = ::send(spectator, reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()), SEND_FLAGS);
+        return sent == static_cast<decltype(sent)>(data.size());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SpectatorServer::~SpectatorServer() {
+        close();
+    }
+}
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPECTATORSERVER_H
+#define CENTIPEDE_SPECTATORSERVER_H
+
+#include "Source/Spectator/SpectatorEncoder.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Streams the changes of a game to spectators
+     *
+     * The stream can be written to a file, and served on a localhost TCP
+     * port or a Unix domain socket. A spectator that connects receives a
+     * keyframe followed by the changes of every tick, see SpectatorEncoder.
+     * The server runs on the game thread and never blocks: a spectator that
+     * cannot keep up with the stream is disconnected
+     */
+    class SpectatorServer {
+    public:
+        /**
+         * @brief Default constructor
+         */
+        SpectatorServer();
+
+        /**
+         * @brief Write the stream to a file
+         * @param filename The name of the file, an existing file is overwritten
+         * @return True if the file was opened, otherwise false
+         */
+        bool openFile(const std::string& filename);
+
+        /**
+         * @brief Serve the stream on a localhost TCP port
+         * @param port The port to listen on
+         * @return True if the server is listening, otherwise false
+         */
+        bool listenTcp(std::uint16_t port);
+
+        /**
+         * @brief Serve the stream on a Unix domain socket
+         * @param path The path of the socket file
+         * @return True if the server is listening, otherwise false
+         *
+         * Unix domain sockets are not supported on Windows
+         */
+        bool listenUnix(const std::string& path);
+
+        /**
+         * @brief Check if the stream goes anywhere
+         * @return True if a file is open or the server is listening, otherwise false
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Stream the changes of the world since the last call
+         * @param world The world to stream
+         *
+         * This function must be called after every tick
+         */
+        void publish(const World& world);
+
+        /**
+         * @brief Get the number of connected spectators
+         * @return The number of connected spectators
+         */
+        std::size_t getSpectatorCount() const;
+
+        /**
+         * @brief Get the size of the stream
+         * @return The number of bytes encoded so far, keyframes for joining spectators excluded
+         */
+        std::uint64_t getStreamSize() const;
+
+        /**
+         * @brief Close the file and disconnect every spectator
+         */
+        void close();
+
+        /**
+         * @brief Destructor
+         */
+        ~SpectatorServer();
+
+    private:
+        /**
+         * @brief Start serving on a listening socket
+         * @param socket The socket
+         * @return True
+         */
+        bool listen(std::intptr_t socket);
+
+        /**
+         * @brief Accept the spectators that are waiting to connect and send them a keyframe
+         */
+        void acceptSpectators();
+
+        /**
+         * @brief Send data to a spectator
+         * @param spectator The socket of the spectator
+         * @param data The data to send
+         * @return False if the data could not be sent without blocking, otherwise true
+         */
+        static bool send(std::intptr_t spectator, const std::vector<std::uint8_t>& data);
+
+    private:
+        SpectatorEncoder m_encoder;              //!< Encodes the changes of each tick
+        std::ofstream m_file;                    //!< The file the stream is written to
+        std::intptr_t m_socket;                  //!< The listening socket
+        std::string m_unixPath;                  //!< The path of the Unix socket file, empty for TCP
+        std::vector<std::intptr_t> m_spectators; //!< The sockets of the connected spectators
+        std::vector<std::uint8_t> m_message;     //!< The message of the current tick
+        std::vector<std::uint8_t> m_keyframe;    //!< The keyframe sent to joining spectators
+        std::uint64_t m_streamSize;              //!< The number of bytes encoded so far
+    };
+}
+
+#endif //CENTIPEDE_SPECTATORSERVER_H
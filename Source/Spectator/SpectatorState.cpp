@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Source/Spectator/SpectatorState.h"
+#include "Source/Spectator/SpectatorEncoder.h"
+#include "Source/Spectator/VarInt.h"
+#include <algorithm>
+#include <iterator>
+
+namespace centpd {
+    namespace {
+        // A grid larger than this is treated as a malformed keyframe
+        const std::uint64_t MAX_TILES = 1u << 20;
+
+        ///////////////////////////////////////////////////////////////
+        bool readDirection(const std::uint8_t*& data, const std::uint8_t* end, Direction& dir) {
+            if (data == end || *data > static_cast<std::uint8_t>(Direction::DownRight))
+                return false;
+
+            dir = static_cast<Direction>(*data++);
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////
+        bool readByte(const std::uint8_t*& data, const std::uint8_t* end, std::uint8_t& byte) {
+            if (data == end)
+                return false;
+
+            byte = *data++;
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    SpectatorState::SpectatorState() :
+        m_tick{0},
+        m_rows{0},
+        m_cols{0},
+        m_level{0},
+        m_isSynchronized{false}
+    {}
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorState::apply(const std::uint8_t* message, std::size_t size) {
+        using MessageType = SpectatorEncoder::MessageType;
+
+        const std::uint8_t* data = message;
+        const std::uint8_t* end = message + size;
+        std::uint8_t type;
+        std::uint64_t tick, value;
+        if (!readByte(data, end, type) || type > static_cast<std::uint8_t>(MessageType::Delta) || !readVarint(data, end, tick))
+            return false;
+
+        if (type == static_cast<std::uint8_t>(MessageType::Keyframe)) {
+            std::uint64_t rows, cols;
+            if (!readVarint(data, end, rows) || !readVarint(data, end, cols) || rows * cols > MAX_TILES)
+                return false;
+
+            m_tick = tick;
+            m_rows = static_cast<unsigned int>(rows);
+            m_cols = static_cast<unsigned int>(cols);
+            m_level = 0;
+            m_mushrooms.assign(rows * cols, 0);
+            m_lives.clear();
+            for (auto& actors : m_actors)
+                actors.clear();
+
+            m_isSynchronized = true;
+        } else if (m_isSynchronized)
+            m_tick += tick;
+        else
+            return false;
+
+        if (!readVarint(data, end, value))
+            return false;
+
+        if (value != 0)
+            m_level = static_cast<unsigned int>(value);
+
+        std::uint64_t numChanges;
+        if (!readVarint(data, end, numChanges))
+            return false;
+
+        for (std::uint64_t i = 0; i < numChanges; i++) {
+            std::uint64_t player;
+            std::int64_t lives;
+            if (!readVarint(data, end, player) || !readSignedVarint(data, end, lives) || player >= 64)
+                return false;
+
+            if (player >= m_lives.size())
+                m_lives.resize(player + 1, 0);
+
+            m_lives[player] = static_cast<int>(lives);
+        }
+
+        std::uint8_t kinds;
+        if (!readByte(data, end, kinds))
+            return false;
+
+        for (std::size_t k = 0; k < NUM_KINDS; k++) {
+            if ((kinds & (1u << k)) && !applyActorChanges(k, data, end))
+                return false;
+        }
+
+        if (!readVarint(data, end, numChanges))
+            return false;
+
+        std::uint64_t tile = 0;
+        for (std::uint64_t i = 0; i < numChanges; i++) {
+            std::uint8_t mushroom;
+            if (!readVarint(data, end, value) || !readByte(data, end, mushroom) || (tile += value) >= m_mushrooms.size())
+                return false;
+
+            m_mushrooms[tile] = mushroom;
+        }
+
+        return data == end;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorState::isSynchronized() const {
+        return m_isSynchronized;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::uint64_t SpectatorState::getTick() const {
+        return m_tick;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SpectatorState::getRows() const {
+        return m_rows;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SpectatorState::getCols() const {
+        return m_cols;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    unsigned int SpectatorState::getLevel() const {
+        return m_level;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<SpectatorActor> &SpectatorState::getActors(ActorKind kind) const {
+        return m_actors[static_cast<std::size_t>(kind)];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<std::uint8_t> &SpectatorState::getMushrooms() const {
+        return m_mushrooms;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    const std::vector<int> &SpectatorState::getLives() const {
+        return m_lives;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool SpectatorState::applyActorChanges(std::size_t kind, const std::uint8_t*& data, const std::uint8_t* end) {
+        using ChangeMask = SpectatorEncoder::ChangeMask;
+        std::vector<SpectatorActor>& actors = m_actors[kind];
+        std::uint64_t count, value;
+
+        // Spawned actors are merged in after the other changes
+        m_spawned.clear();
+        std::uint64_t id = 0;
+        if (!readVarint(data, end, count))
+            return false;
+
+        for (std::uint64_t i = 0; i < count; i++) {
+            std::uint64_t row, col;
+            SpectatorActor actor{};
+            if (!readVarint(data, end, value) || !readVarint(data, end, row) || !readVarint(data, end, col)
+                || !readDirection(data, end, actor.dir) || !readByte(data, end, actor.type))
+            {
+                return false;
+            }
+
+            id += value;
+            actor.id = static_cast<std::uint32_t>(id);
+            actor.row = static_cast<std::int16_t>(row);
+            actor.col = static_cast<std::int16_t>(col);
+            m_spawned.push_back(actor);
+        }
+
+        // Destroyed and changed ids are sorted, like the actors, so one pointer into the actors is enough
+        id = 0;
+        if (!readVarint(data, end, count))
+            return false;
+
+        std::size_t kept = 0;
+        std::size_t index = 0;
+        for (std::uint64_t i = 0; i < count; i++) {
+            if (!readVarint(data, end, value))
+                return false;
+
+            id += value;
+            while (index < actors.size() && actors[index].id < id)
+                actors[kept++] = actors[index++];
+
+            if (index == actors.size() || actors[index].id != id)
+                return false;
+
+            index++;
+        }
+
+        while (index < actors.size())
+            actors[kept++] = actors[index++];
+
+        actors.resize(kept);
+
+        id = 0;
+        index = 0;
+        if (!readVarint(data, end, count))
+            return false;
+
+        for (std::uint64_t i = 0; i < count; i++) {
+            std::uint8_t mask;
+            if (!readVarint(data, end, value) || !readByte(data, end, mask))
+                return false;
+
+            id += value;
+            while (index < actors.size() && actors[index].id < id)
+                index++;
+
+            if (index == actors.size() || actors[index].id != id)
+                return false;
+
+            SpectatorActor& actor = actors[index];
+            std::int64_t offset;
+            if (mask & ChangeMask::RowChanged) {
+                if (!readSignedVarint(data, end, offset))
+                    return false;
+
+                actor.row = static_cast<std::int16_t>(actor.row + offset);
+            }
+
+            if (mask & ChangeMask::ColChanged) {
+                if (!readSignedVarint(data, end, offset))
+                    return false;
+
+                actor.col = static_cast<std::int16_t>(actor.col + offset);
+            }
+
+            if ((mask & ChangeMask::DirChanged) && !readDirection(data, end, actor.dir))
+                return false;
+
+            if ((mask & ChangeMask::TypeChanged) && !readByte(data, end, actor.type))
+                return false;
+        }
+
+        if (!m_spawned.empty()) {
+            auto byId = [](const SpectatorActor& lhs, const SpectatorActor& rhs) { return lhs.id < rhs.id; };
+            m_merged.clear();
+            std::merge(actors.begin(), actors.end(), m_spawned.begin(), m_spawned.end(), std::back_inserter(m_merged), byId);
+            actors.swap(m_merged);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_SPECTATORSTATE_H
+#define CENTIPEDE_SPECTATORSTATE_H
+
+#include "Source/Simulation/ActorStore.h"
+#include "Source/Simulation/Direction.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief The state of an actor as seen by a spectator
+     */
+    struct SpectatorActor {
+        std::uint32_t id;  //!< The unique id of the actor
+        std::int16_t row;  //!< The row of the tile occupied by the actor
+        std::int16_t col;  //!< The column of the tile occupied by the actor
+        Direction dir;     //!< The movement direction of the actor
+        std::uint8_t type; //!< The kind specific type of the actor
+    };
+
+    /**
+     * @brief The game state reconstructed from a spectator stream
+     *
+     * The state starts out empty and follows the game as the messages of
+     * a stream are applied in order, see SpectatorEncoder for the format.
+     * Actors are only known to the tile, not the position within the tile
+     */
+    class SpectatorState {
+    public:
+        static constexpr std::size_t NUM_KINDS = static_cast<std::size_t>(ActorKind::Count); //!< The number of actor kinds
+
+        /**
+         * @brief Default constructor
+         */
+        SpectatorState();
+
+        /**
+         * @brief Apply a message of the stream
+         * @param message The message, without its length prefix
+         * @param size The size of the message in bytes
+         * @return False if the message is malformed or a delta arrived before the first keyframe, otherwise true
+         *
+         * A keyframe replaces the whole state, a delta changes it. The state
+         * is unspecified after a malformed message until the next keyframe
+         */
+        bool apply(const std::uint8_t* message, std::size_t size);
+
+        /**
+         * @brief Check if a keyframe was applied
+         * @return True if the state follows a game, otherwise false
+         */
+        bool isSynchronized() const;
+
+        /**
+         * @brief Get the tick of the state
+         * @return The number of ticks the game has simulated
+         */
+        std::uint64_t getTick() const;
+
+        /**
+         * @brief Get the number of rows in the grid
+         * @return The number of rows in the grid
+         */
+        unsigned int getRows() const;
+
+        /**
+         * @brief Get the number of columns in the grid
+         * @return The number of columns in the grid
+         */
+        unsigned int getCols() const;
+
+        /**
+         * @brief Get the current level
+         * @return The current level
+         */
+        unsigned int getLevel() const;
+
+        /**
+         * @brief Get the actors of a kind
+         * @param kind The kind of actors to get
+         * @return The actors of the given kind, sorted by id
+         */
+        const std::vector<SpectatorActor>& getActors(ActorKind kind) const;
+
+        /**
+         * @brief Get the mushroom of each tile
+         * @return The tiles of the grid row by row, in the format of MushroomField
+         */
+        const std::vector<std::uint8_t>& getMushrooms() const;
+
+        /**
+         * @brief Get the lives of each player
+         * @return The number of lives of each player
+         */
+        const std::vector<int>& getLives() const;
+
+    private:
+        /**
+         * @brief Apply the changes of one actor kind
+         * @param kind The kind of the actors
+         * @param data The position of the changes, advanced past them
+         * @param end The end of the message
+         * @return False if the changes are malformed, otherwise true
+         */
+        bool applyActorChanges(std::size_t kind, const std::uint8_t*& data, const std::uint8_t* end);
+
+    private:
+        friend class SpectatorEncoder;
+
+        std::uint64_t m_tick;                                        //!< The number of ticks the game has simulated
+        unsigned int m_rows;                                         //!< The number of rows in the grid
+        unsigned int m_cols;                                         //!< The number of columns in the grid
+        unsigned int m_level;                                        //!< The current level
+        bool m_isSynchronized;                                       //!< A flag indicating whether or not a keyframe was applied
+        std::array<std::vector<SpectatorActor>, NUM_KINDS> m_actors; //!< The actors of each kind, sorted by id
+        std::vector<std::uint8_t> m_mushrooms;                       //!< The mushroom of each tile
+        std::vector<int> m_lives;                                    //!< The lives of each player
+        std::vector<SpectatorActor> m_spawned;                       //!< Scratch list of the actors spawned by a message
+        std::vector<SpectatorActor> m_merged;                        //!< Scratch list the actors of a kind are merged into
+    };
+}
+
+#endif //CENTIPEDE_SPECTATORSTATE_H
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// A terminal viewer for the spectator stream of a game, see SpectatorServer
+//
+// Usage: CentipedeSpectator <stream file>
+//        CentipedeSpectator --port <port>
+//        CentipedeSpectator --socket <path>
+//
+// A live stream is drawn as it arrives, a stream file is replayed and its
+// final state is drawn together with the size of the stream
+
+#include "Source/Spectator/SpectatorState.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    using namespace centpd;
+    using Reader = std::function<bool(std::uint8_t*, std::size_t)>;
+
+    // A live stream is drawn at most once per this number of ticks
+    const std::uint64_t DRAW_INTERVAL = 8;
+
+    // Messages larger than this are treated as a corrupt stream
+    const std::uint64_t MAX_MESSAGE_SIZE = 1u << 24;
+
+    ///////////////////////////////////////////////////////////////
+    bool readMessage(const Reader& read, std::vector<std::uint8_t>& message) {
+        std::uint64_t size = 0;
+        for (unsigned int shift = 0; ; shift += 7) {
+            std::uint8_t byte;
+            if (shift >= 64 || !read(&byte, 1))
+                return false;
+
+            size |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+
+        if (size > MAX_MESSAGE_SIZE)
+            return false;
+
+        message.resize(size);
+        return read(message.data(), message.size());
+    }
+
+    ///////////////////////////////////////////////////////////////
+    char getSymbol(ActorKind kind, const SpectatorActor& actor) {
+        switch (kind) {
+            case ActorKind::Player:           return 'A';
+            case ActorKind::Bullet:           return '|';
+            case ActorKind::CentipedeSegment: return actor.type == ActorType::CentipedeHead ? '@' : 'o';
+            case ActorKind::Scorpion:         return 'S';
+            default:                          return 'F';
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void draw(const SpectatorState& state, bool isLive) {
+        const unsigned int rows = state.getRows();
+        const unsigned int cols = state.getCols();
+        std::string frame(rows * (cols + 1), ' ');
+        for (unsigned int row = 0; row < rows; row++) {
+            frame[row * (cols + 1) + cols] = '\n';
+            for (unsigned int col = 0; col < cols; col++) {
+                // Same bits as MushroomField: present, poisoned
+                const std::uint8_t tile = state.getMushrooms()[row * cols + col];
+                if (tile & 0x80)
+                    frame[row * (cols + 1) + col] = (tile & 0x04) ? '%' : '#';
+            }
+        }
+
+        for (std::size_t k = 0; k < SpectatorState::NUM_KINDS; k++) {
+            for (const SpectatorActor& actor : state.getActors(static_cast<ActorKind>(k))) {
+                if (actor.row >= 0 && actor.col >= 0 && actor.row < static_cast<int>(rows) && actor.col < static_cast<int>(cols))
+                    frame[actor.row * (cols + 1) + actor.col] = getSymbol(static_cast<ActorKind>(k), actor);
+            }
+        }
+
+        std::string status = "Tick " + std::to_string(state.getTick()) + "  Level " + std::to_string(state.getLevel());
+        for (std::size_t player = 0; player < state.getLives().size(); player++)
+            status += "  P" + std::to_string(player + 1) + " lives " + std::to_string(state.getLives()[player]);
+
+        // Live frames are drawn over the previous one
+        std::cout << (isLive ? "\x1b[H\x1b[2J" : "") << frame << status << std::endl;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    std::intptr_t connectTo(const std::string& option, const std::string& target) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        if (option != "--port" || ::WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+            return -1;
+
+        auto socket = static_cast<std::intptr_t>(::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+#else
+        std::intptr_t socket = ::socket(option == "--port" ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+#endif
+        if (socket < 0)
+            return -1;
+
+        int result = -1;
+        if (option == "--port") {
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(static_cast<std::uint16_t>(std::atoi(target.c_str())));
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            result = ::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+#ifndef _WIN32
+        else {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, target.c_str(), sizeof(address.sun_path) - 1);
+            result = ::connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+#endif
+
+        return result == 0 ? socket : -1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const bool isLive = argc == 3 && (std::strcmp(argv[1], "--port") == 0 || std::strcmp(argv[1], "--socket") == 0);
+    if (argc != 2 && !isLive) {
+        std::cerr << "Usage: " << argv[0] << " <stream file> | --port <port> | --socket <path>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::FILE* file = nullptr;
+    std::intptr_t socket = -1;
+    Reader read;
+    if (isLive) {
+        socket = connectTo(argv[1], argv[2]);
+        read = [socket](std::uint8_t* data, std::size_t size) {
+            while (size > 0) {
+                auto received = ::recv(socket, reinterpret_cast<char*>(data), static_cast<int>(size), 0);
+                if (received <= 0)
+                    return false;
+
+                data += received;
+                size -= static_cast<std::size_t>(received);
+            }
+
+            return true;
+        };
+    } else {
+        file = std::fopen(argv[1], "rb");
+        read = [file](std::uint8_t* data, std::size_t size) {
+            return std::fread(data, 1, size, file) == size;
+        };
+    }
+
+    if (socket < 0 && !file) {
+        std::cerr << "Failed to open the stream " << argv[argc - 1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SpectatorState state;
+    std::vector<std::uint8_t> message;
+    std::uint64_t numMessages = 0, numBytes = 0, drawnTick = 0;
+    while (readMessage(read, message)) {
+        if (!state.apply(message.data(), message.size())) {
+            std::cerr << "Corrupt message " << numMessages << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        numMessages++;
+        numBytes += message.size();
+        if (isLive && (drawnTick == 0 || state.getTick() >= drawnTick + DRAW_INTERVAL)) {
+            drawnTick = state.getTick();
+            draw(state, true);
+        }
+    }
+
+    if (state.isSynchronized())
+        draw(state, false);
+
+    std::cout << numMessages << " messages, " << numBytes << " bytes over " << state.getTick() << " ticks" << std::endl;
+
+    if (file)
+        std::fclose(file);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CENTIPEDE_VARINT_H
+#define CENTIPEDE_VARINT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace centpd {
+    /**
+     * @brief Append an unsigned integer in LEB128 form
+     * @param out The buffer to append to
+     * @param value The value to append
+     *
+     * Seven bits are written per byte, starting with the least significant
+     * bits. The high bit of a byte is set if more bytes follow, so values
+     * below 128 take a single byte
+     */
+    inline void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    /**
+     * @brief Append a signed integer in zigzag LEB128 form
+     * @param out The buffer to append to
+     * @param value The value to append
+     *
+     * Small negative values take as few bytes as small positive ones
+     */
+    inline void writeSignedVarint(std::vector<std::uint8_t>& out, std::int64_t value) {
+        writeVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+
+    /**
+     * @brief Read an unsigned integer in LEB128 form
+     * @param data The position to read from, advanced past the integer
+     * @param end The end of the buffer
+     * @param value Receives the value
+     * @return False if the buffer ends before the integer or the integer is too long, otherwise true
+     */
+    inline bool readVarint(const std::uint8_t*& data, const std::uint8_t* end, std::uint64_t& value) {
+        value = 0;
+        for (unsigned int shift = 0; shift < 64 && data != end; shift += 7) {
+            const std::uint8_t byte = *data++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Read a signed integer in zigzag LEB128 form
+     * @param data The position to read from, advanced past the integer
+     * @param end The end of the buffer
+     * @param value Receives the value
+     * @return False if the buffer ends before the integer or the integer is too long, otherwise true
+     */
+    inline bool readSignedVarint(const std::uint8_t*& data, const std::uint8_t* end, std::int64_t& value) {
+        std::uint64_t zigzag;
+        if (!readVarint(data, end, zigzag))
+            return false;
+
+        value = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+        return true;
+    }
+}
+
+#endif //CENTIPEDE_VARINT_H
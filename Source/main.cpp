@@ -14,7 +14,5 @@ int main() {
 
     centpd::Game centipedeGame{};
     centipedeGame.initialize();
-    centipedeGame.start();
-
-    return 0;
+    return centipedeGame.start();
 }
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Background threads must not show up in the allocation counts of the
+// frames: each test keeps a worker busy during a frame in which the game
+// thread itself does not allocate, and expects an empty frame
+
+#include "Tests/Check.h"
+#include "Source/Diagnostics/FrameAllocations.h"
+#include "Source/GameLoop/SettingsWatcher.h"
+#include "Source/Graphics/FrameCapture.h"
+#include "Source/Scoreboard/ScoreWriter.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace centpd;
+
+namespace {
+    const auto TIMEOUT = std::chrono::seconds(5);
+
+    ///////////////////////////////////////////////////////////////
+    void testCountedThread() {
+        // Without excluding itself a thread is counted, otherwise the other tests prove nothing
+        FrameAllocations frames;
+        std::thread worker([] {
+            for (int i = 0; i < 1000; i++)
+                delete new int(i);
+        });
+
+        worker.join();
+        frames.endFrame();
+        CHECK(frames.getLastFrame().count >= 1000);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testExcludedThread() {
+        std::atomic<bool> isStarted{false};
+        std::atomic<bool> isStopped{false};
+        std::atomic<std::uint64_t> allocations{0};
+        std::thread worker([&] {
+            AllocationCounter::setThreadExcluded(true);
+            isStarted = true;
+            while (!isStopped) {
+                std::vector<int> values(100);
+                allocations++;
+            }
+        });
+
+        while (!isStarted)
+            std::this_thread::yield();
+
+        FrameAllocations frames;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        frames.endFrame();
+        isStopped = true;
+        worker.join();
+
+        CHECK(allocations > 0);
+        CHECK(frames.getLastFrame().count == 0);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testScoreWriter(const std::filesystem::path& directory) {
+        ScoreWriter writer((directory / "HighScores.txt").string(), {});
+        Score score;
+        score.setOwner("AAA");
+
+        FrameAllocations frames;
+        for (int i = 0; i < 20; i++) {
+            score.setValue(i);
+            CHECK(writer.push(score));
+            CHECK(writer.waitUntilWritten(TIMEOUT));
+        }
+
+        frames.endFrame();
+        CHECK(writer.getWriteCount() == 20);
+        CHECK(frames.getLastFrame().count == 0);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testFrameCapture(const std::filesystem::path& directory) {
+        FrameCapture capture(Image{1, 1}, 320, 240, (directory / "Frames").string());
+        for (std::uint64_t tick = 0; tick < 8; tick++) {
+            capture.beginFrame();
+            capture.endFrame(tick);
+        }
+
+        FrameAllocations frames;
+        capture.flush();
+        frames.endFrame();
+        CHECK(std::filesystem::exists(directory / "Frames" / "frame_00000007.png"));
+        CHECK(frames.getLastFrame().count == 0);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testSettingsWatcher(const std::filesystem::path& directory) {
+        const std::string filename = (directory / "GameSettings.txt").string();
+        auto writeSettings = [&filename](unsigned int tickRate) {
+            std::ofstream file(filename);
+            file << "SIMULATION_TICK_RATE:UINT=" << tickRate << "\n"
+                 << "PLAYER_SPEED:FLOAT=120\nBULLET_SPEED:FLOAT=120\nCENTIPEDE_SPEED:FLOAT=120\n"
+                 << "SCORPION_SPEED:FLOAT=120\nFLEA_SPEED:FLOAT=120\nCENTIPEDE_SPEED_PER_LEVEL:FLOAT=0.1\n"
+                 << "CENTIPEDE_LENGTH_PER_LEVEL:UINT=1\nSCORPION_SPAWN_INTERVAL:FLOAT=150\nFLEA_SPAWN_INTERVAL:FLOAT=30\n"
+                 << "ENABLE_MUSHROOMS:BOOL=1\nENABLE_SCORPIONS:BOOL=1\nENABLE_FLEAS:BOOL=1\n";
+        };
+
+        writeSettings(120);
+        SettingsWatcher watcher(filename, WorldSettings{});
+        watcher.start();
+
+        // Give the watcher time to start watching, then change the file
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        writeSettings(60);
+
+        FrameAllocations frames;
+        WorldSettings settings;
+        const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        bool isReloaded = false;
+        while (!(isReloaded = watcher.poll(settings)) && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        frames.endFrame();
+        CHECK(isReloaded);
+        CHECK(settings.tickRate == 60);
+        CHECK(frames.getLastFrame().count == 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "CentipedeAllocationCounterTest";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    testCountedThread();
+    testExcludedThread();
+    testScoreWriter(directory);
+    testFrameCapture(directory);
+    testSettingsWatcher(directory);
+
+    std::filesystem::remove_all(directory);
+    return test::report();
+}
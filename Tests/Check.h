@@ -22,27 +22,45 @@
 // SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////
 
-#include "Source/Actors/MushroomField.h"
-#include "Source/Actors/Mushroom.h"
-#include <IME/utility/Utils.h>
-#include <cassert>
+#ifndef CENTIPEDE_CHECK_H
+#define CENTIPEDE_CHECK_H
 
-namespace centpd {
-    ///////////////////////////////////////////////////////////////
-    void MushroomField::create(Grid& grid, unsigned int numMushrooms) {
-        // Prevent an infinite loop - A cell can only be occupied by one mushroom (And the player must not be blocked in its starting row (bottom row))
-        assert(numMushrooms <= grid.getRows() * grid.getCols() - grid.getCols() && "The number of mushrooms must be one row less than the number of cells");
+#include <iostream>
 
-        auto randomRowGenerator = ime::utility::createRandomNumGenerator(1, grid.getRows() - 2); // No mushrooms in first and last rows
-        auto randomColGenerator = ime::utility::createRandomNumGenerator(0, grid.getCols() - 1);
+/**
+ * @brief Check a condition of a test, a failed check is reported and the test carries on
+ * @param condition The condition that must hold
+ */
+#define CHECK(condition) centpd::test::check((condition), #condition, __FILE__, __LINE__)
 
-        while (numMushrooms > 0) {
-            auto index = ime::Index{randomRowGenerator(), randomColGenerator()};
-            if (grid.isCellOccupied(index))
-                continue;
+namespace centpd::test {
+    /**
+     * @brief Get the number of failed checks
+     * @return The number of checks that failed so far
+     */
+    inline int& getFailures() {
+        static int failures = 0;
+        return failures;
+    }
 
-            grid.addActor(Mushroom::create(grid.getScene()), index);
-            numMushrooms--;
+    ///////////////////////////////////////////////////////////////
+    inline void check(bool isPassed, const char* condition, const char* file, int line) {
+        if (!isPassed) {
+            std::cerr << file << ":" << line << ": check failed: " << condition << std::endl;
+            getFailures()++;
         }
     }
+
+    /**
+     * @brief Report the result of a test
+     * @return The exit code of the test, zero if every check passed
+     */
+    inline int report() {
+        if (getFailures() > 0)
+            std::cerr << getFailures() << " check(s) failed" << std::endl;
+
+        return getFailures() == 0 ? 0 : 1;
+    }
 }
+
+#endif //CENTIPEDE_CHECK_H
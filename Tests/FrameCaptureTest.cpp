@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Captures a fixed scene in both formats and a simulated game the way the
+// simulation only build does, and compares the frames with checked in
+// golden images. Set CENTIPEDE_UPDATE_GOLDEN to write the golden images
+// from the current output instead, after checking them by eye
+
+#include "Tests/Check.h"
+#include "Source/Graphics/FrameCapture.h"
+#include "Source/Graphics/Png.h"
+#include "Source/Graphics/SpriteAtlas.h"
+#include "Source/Graphics/WorldRenderer.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace centpd;
+
+namespace {
+    const unsigned int WIDTH = 160;
+    const unsigned int HEIGHT = 120;
+    const unsigned int TILE_SIZE = 16;
+
+    ///////////////////////////////////////////////////////////////
+    SpriteQuad makeQuad(float x, float y, float scale, unsigned int left, unsigned int top, unsigned int width, unsigned int height) {
+        SpriteQuad quad;
+        quad.x = x;
+        quad.y = y;
+        quad.scaleX = quad.scaleY = scale;
+        quad.originX = static_cast<float>(width) / 2.0f;
+        quad.originY = static_cast<float>(height) / 2.0f;
+        quad.left = left;
+        quad.top = top;
+        quad.width = width;
+        quad.height = height;
+        quad.visible = true;
+        return quad;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void captureScene(FrameCapture& capture, std::uint64_t tick) {
+        // Frames of the spritesheet, see SpriteAtlas
+        std::vector<SpriteQuad> mushrooms = {
+            makeQuad(24.0f, 24.0f, 2.0f, 65, 0, 8, 8),
+            makeQuad(56.0f, 24.0f, 2.0f, 73, 8, 8, 8),
+            makeQuad(88.0f, 24.0f, 2.0f, 89, 0, 8, 8)
+        };
+
+        SpriteQuad hidden = makeQuad(120.0f, 24.0f, 2.0f, 65, 0, 8, 8);
+        hidden.visible = false;
+        mushrooms.push_back(hidden);
+
+        // A negative scale flips the sprite, overlapping sprites are drawn in order
+        std::vector<SpriteQuad> actors = {
+            makeQuad(40.0f, 56.0f, 2.0f, 1, 55, 16, 8),
+            makeQuad(104.0f, 56.0f, -2.0f, 1, 55, 16, 8),
+            makeQuad(80.0f, 100.0f, 2.0f, 1, 80, 7, 8),
+            makeQuad(80.0f, 76.0f, 2.0f, 12, 80, 1, 6),
+            makeQuad(136.0f, 88.0f, 3.0f, 65, 32, 9, 8),
+            makeQuad(140.0f, 92.0f, 2.0f, 0, 0, 7, 8)
+        };
+
+        capture.beginFrame(0x102030FF);
+        capture.drawLayer(mushrooms);
+        capture.drawLayer(actors);
+        capture.drawGrid(HEIGHT / TILE_SIZE, WIDTH / TILE_SIZE, TILE_SIZE);
+        capture.endFrame(tick);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void captureWorld(FrameCapture& capture, WorldRenderer& renderer) {
+        WorldSettings settings;
+        settings.rows = 12;
+        settings.cols = 16;
+        settings.numMushrooms = 24;
+        settings.centipedeLength = 6;
+        settings.scorpionSpawnInterval = 0.5f;
+        settings.fleaSpawnInterval = 0.75f;
+
+        World world(settings, 3);
+        world.start();
+        for (std::uint64_t tick = 1; tick <= 60; tick++) {
+            world.tick(PlayerInput{tick < 30 ? Direction::Left : Direction::UpRight, true});
+            if (capture.isDue(tick)) {
+                capture.beginFrame();
+                renderer.draw(world, capture);
+                capture.endFrame(tick);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool checkGolden(const Image& image, const std::string& name) {
+        const std::filesystem::path golden = std::filesystem::path(CENTIPEDE_GOLDEN_DIR) / name;
+        if (std::getenv("CENTIPEDE_UPDATE_GOLDEN")) {
+            Png::save(image, golden.string());
+            std::cout << "Golden image written to " << golden.string() << std::endl;
+        }
+
+        const Image expected = Png::load(golden.string());
+        return image.getWidth() == expected.getWidth() && image.getHeight() == expected.getHeight()
+            && image.getPixels() == expected.getPixels();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Image loadPam(const std::filesystem::path& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        std::string line, header;
+        unsigned int width = 0, height = 0;
+        while (std::getline(file, line) && line != "ENDHDR") {
+            std::istringstream fields(line);
+            fields >> header;
+            if (header == "WIDTH")
+                fields >> width;
+            else if (header == "HEIGHT")
+                fields >> height;
+        }
+
+        Image image{width, height};
+        file.read(reinterpret_cast<char*>(image.getPixels().data()), static_cast<std::streamsize>(image.getPixels().size()));
+        CHECK(file.gcount() == static_cast<std::streamsize>(image.getPixels().size()));
+        return image;
+    }
+
+}
+
+///////////////////////////////////////////////////////////////
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "CentipedeFrameCaptureTest";
+    const std::filesystem::path worldDirectory = directory / "World";
+    const Image spritesheet = Png::load(CENTIPEDE_RES_DIR "/Textures/Spritesheet.png");
+    std::filesystem::remove_all(directory);
+
+    {
+        FrameCapture capture(spritesheet, WIDTH, HEIGHT, directory.string());
+        captureScene(capture, 7);
+        capture.setFormat(FrameCapture::Format::Raw);
+        captureScene(capture, 8);
+        capture.flush();
+    }
+
+    const Image png = Png::load((directory / "frame_00000007.png").string());
+    const Image raw = loadPam(directory / "frame_00000008.pam");
+    CHECK(png.getWidth() == WIDTH && png.getHeight() == HEIGHT);
+    CHECK(checkGolden(png, "FrameCapture.png"));
+    CHECK(checkGolden(raw, "FrameCapture.png"));
+
+    // Without game objects, as in the simulation only build
+    SpriteAtlas::build();
+    {
+        WorldRenderer renderer;
+        FrameCapture capture(spritesheet, 16 * TILE_SIZE, 12 * TILE_SIZE, worldDirectory.string());
+        capture.setInterval(30);
+        captureWorld(capture, renderer);
+        capture.flush();
+    }
+
+    CHECK(!std::filesystem::exists(worldDirectory / "frame_00000029.png"));
+    CHECK(checkGolden(Png::load((worldDirectory / "frame_00000030.png").string()), "WorldCapture30.png"));
+    CHECK(checkGolden(Png::load((worldDirectory / "frame_00000060.png").string()), "WorldCapture60.png"));
+
+    std::filesystem::remove_all(directory);
+    return test::report();
+}
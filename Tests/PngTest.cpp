@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Decodes PNG files that were damaged or use formats the decoder does not
+// support, every one of them must be refused with an exception rather than
+// read past the data or decoded into garbage
+
+#include "Tests/Check.h"
+#include "Source/Graphics/Png.h"
+#include <stdexcept>
+
+using namespace centpd;
+
+namespace {
+    const std::size_t IHDR_POS = 8;
+    const std::size_t IDAT_POS = IHDR_POS + 12 + 13;
+
+    ///////////////////////////////////////////////////////////////
+    std::uint32_t readU32(const std::vector<std::uint8_t>& data, std::size_t pos) {
+        return (std::uint32_t{data[pos]} << 24) | (std::uint32_t{data[pos + 1]} << 16) | (std::uint32_t{data[pos + 2]} << 8) | data[pos + 3];
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void writeU32(std::vector<std::uint8_t>& data, std::size_t pos, std::uint32_t value) {
+        for (std::size_t i = 0; i < 4; i++)
+            data[pos + i] = static_cast<std::uint8_t>(value >> (24 - 8 * i));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void updateCrc(std::vector<std::uint8_t>& data, std::size_t chunkPos) {
+        // Bitwise CRC-32, independent of the table in the decoder
+        const std::size_t length = readU32(data, chunkPos);
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = chunkPos + 4; i < chunkPos + 8 + length; i++) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+
+        writeU32(data, chunkPos + 8 + length, crc ^ 0xFFFFFFFFu);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void setHeader(std::vector<std::uint8_t>& data, std::uint8_t bitDepth, std::uint8_t colourType, std::uint8_t interlace = 0) {
+        data[IHDR_POS + 16] = bitDepth;
+        data[IHDR_POS + 17] = colourType;
+        data[IHDR_POS + 20] = interlace;
+        updateCrc(data, IHDR_POS);
+    }
+
+    ///////////////////////////////////////////////////////////////
+    bool isRefused(const std::vector<std::uint8_t>& data) {
+        try {
+            Png::decode(data);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+
+        return false;
+    }
+
+}
+
+///////////////////////////////////////////////////////////////
+int main() {
+    Image image{5, 3};
+    for (std::size_t i = 0; i < image.getPixels().size(); i++)
+        image.getPixels()[i] = static_cast<std::uint8_t>(i * 7);
+
+    const std::vector<std::uint8_t> valid = Png::encode(image);
+    const Image decoded = Png::decode(valid);
+    CHECK(decoded.getWidth() == 5 && decoded.getHeight() == 3);
+    CHECK(decoded.getPixels() == image.getPixels());
+
+    // Rewriting a chunk together with its CRC is not a change by itself
+    std::vector<std::uint8_t> png = valid;
+    updateCrc(png, IHDR_POS);
+    updateCrc(png, IDAT_POS);
+    CHECK(png == valid);
+    CHECK(!isRefused(png));
+
+    // A header shorter than 13 bytes, the fields after it are read from the next chunk
+    png = valid;
+    png.erase(png.begin() + IHDR_POS + 8 + 12);
+    writeU32(png, IHDR_POS, 12);
+    updateCrc(png, IHDR_POS);
+    CHECK(isRefused(png));
+
+    // Bit depths that do not exist for the colour type
+    const std::uint8_t invalidDepths[][2] = {{0, 6}, {3, 3}, {5, 0}, {7, 3}, {4, 2}, {16, 6}, {8, 1}, {8, 7}};
+    for (const auto& [bitDepth, colourType] : invalidDepths) {
+        png = valid;
+        setHeader(png, bitDepth, colourType);
+        CHECK(isRefused(png));
+    }
+
+    // Interlaced images and unknown interlace methods
+    png = valid;
+    setHeader(png, 8, 6, 1);
+    CHECK(isRefused(png));
+    setHeader(png, 8, 6, 2);
+    CHECK(isRefused(png));
+
+    // A damaged chunk whose CRC no longer matches
+    png = valid;
+    png[IDAT_POS + 8 + 4] ^= 0x01;
+    CHECK(isRefused(png));
+
+    // A damaged zlib header with a correct chunk CRC
+    png = valid;
+    png[IDAT_POS + 8] = 0x79;
+    updateCrc(png, IDAT_POS);
+    CHECK(isRefused(png));
+
+    // Damaged image data with a correct chunk CRC is caught by the Adler-32 checksum
+    png = valid;
+    const std::size_t idatLength = readU32(png, IDAT_POS);
+    png[IDAT_POS + 8 + idatLength - 5] ^= 0x01;
+    updateCrc(png, IDAT_POS);
+    CHECK(isRefused(png));
+
+    png = valid;
+    png[IDAT_POS + 8 + idatLength - 1] ^= 0x01;
+    updateCrc(png, IDAT_POS);
+    CHECK(isRefused(png));
+
+    // Files without the end chunk or cut anywhere
+    png = valid;
+    png.resize(png.size() - 12);
+    CHECK(isRefused(png));
+
+    for (std::size_t size = 0; size < valid.size(); size++)
+        CHECK(isRefused(std::vector<std::uint8_t>(valid.begin(), valid.begin() + static_cast<std::ptrdiff_t>(size))));
+
+    return test::report();
+}
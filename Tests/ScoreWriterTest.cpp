@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Durability of the high scores file: scores are on the disk when
+// waitUntilWritten returns, the file is replaced by renaming a temporary
+// file over it, failed writes are retried and the destructor writes the
+// scores that are still queued
+
+#include "Tests/Check.h"
+#include "Source/Scoreboard/ScoreWriter.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace centpd;
+
+namespace {
+    const auto TIMEOUT = std::chrono::seconds(5);
+
+    ///////////////////////////////////////////////////////////////
+    std::string readFile(const std::filesystem::path& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void writeFile(const std::filesystem::path& filename, const std::string& contents) {
+        std::ofstream file(filename, std::ios::binary);
+        file << contents;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    Score makeScore(const std::string& owner, int value, unsigned int level) {
+        Score score;
+        score.setOwner(owner);
+        score.setValue(value);
+        score.setLevel(level);
+        return score;
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testWaitUntilWritten(const std::filesystem::path& directory) {
+        const std::filesystem::path filename = directory / "Wait.txt";
+        ScoreWriter writer(filename.string(), {makeScore("AAA", 50, 1)});
+
+        CHECK(writer.push(makeScore("BBB", 100, 2)));
+        CHECK(writer.push(makeScore("CCC", 10, 1)));
+        CHECK(writer.waitUntilWritten(TIMEOUT));
+        CHECK(readFile(filename) == "BBB:100 2\nAAA:50 1\nCCC:10 1");
+
+        CHECK(writer.push(makeScore("DDD", 75, 3)));
+        CHECK(writer.waitUntilWritten(TIMEOUT));
+        CHECK(readFile(filename) == "BBB:100 2\nDDD:75 3\nAAA:50 1\nCCC:10 1");
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testRenamedOverOldFile(const std::filesystem::path& directory) {
+        const std::filesystem::path filename = directory / "Rename.txt";
+        const std::filesystem::path link = directory / "Rename.link";
+        writeFile(filename, "AAA:50 1");
+
+        // A file written in place would change the contents seen through the link, a renamed file does not
+        std::filesystem::create_hard_link(filename, link);
+
+        ScoreWriter writer(filename.string(), {makeScore("AAA", 50, 1)});
+        CHECK(writer.push(makeScore("BBB", 100, 2)));
+        CHECK(writer.waitUntilWritten(TIMEOUT));
+
+        CHECK(readFile(filename) == "BBB:100 2\nAAA:50 1");
+        CHECK(readFile(link) == "AAA:50 1");
+        CHECK(!std::filesystem::exists(filename.string() + ".tmp"));
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testFailedWriteRetried(const std::filesystem::path& directory) {
+        const std::filesystem::path filename = directory / "Retry.txt";
+        const std::filesystem::path tempFilename = filename.string() + ".tmp";
+
+        // The temporary file cannot be created while a directory has its name
+        std::filesystem::create_directory(tempFilename);
+
+        ScoreWriter writer(filename.string(), {});
+        CHECK(writer.push(makeScore("AAA", 50, 1)));
+        CHECK(!writer.waitUntilWritten(std::chrono::milliseconds(300)));
+        CHECK(writer.getWriteCount() == 0);
+        CHECK(!std::filesystem::exists(filename));
+
+        std::filesystem::remove(tempFilename);
+        CHECK(writer.waitUntilWritten(TIMEOUT));
+        CHECK(writer.getWriteCount() == 1);
+        CHECK(readFile(filename) == "AAA:50 1");
+    }
+
+    ///////////////////////////////////////////////////////////////
+    void testDestructorFlushes(const std::filesystem::path& directory) {
+        const std::filesystem::path filename = directory / "Flush.txt";
+        {
+            ScoreWriter writer(filename.string(), {});
+            for (int i = 1; i <= 5; i++)
+                CHECK(writer.push(makeScore("AAA", i * 10, 1)));
+        }
+
+        CHECK(readFile(filename) == "AAA:50 1\nAAA:40 1\nAAA:30 1\nAAA:20 1\nAAA:10 1");
+    }
+}
+
+///////////////////////////////////////////////////////////////
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "CentipedeScoreWriterTest";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    testWaitUntilWritten(directory);
+    testRenamedOverOldFile(directory);
+    testFailedWriteRetried(directory);
+    testDestructorFlushes(directory);
+
+    std::filesystem::remove_all(directory);
+    return test::report();
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////
+// Centipede clone
+//
+// Copyright (c) 2021 Kwena Mashamaite (kwena.mashamaite1@gmail.com)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////
+
+// Connects and disconnects callbacks while a signal is being emitted. A
+// callback connected during an emission must not be called before the
+// next emission, even when it is given the slot of a removed callback
+
+#include "Tests/Check.h"
+#include "Source/Common/Signal.h"
+
+using namespace centpd;
+
+namespace {
+    /**
+     * @brief The signal under test and what its callbacks observed
+     *
+     * Callbacks capture the whole state by reference, a lambda capturing
+     * each member would not fit into the inline storage of a slot
+     */
+    struct State {
+        Signal<int> signal;
+        SlotHandle removed;     //!< Disconnected during the first emission
+        SlotHandle late;        //!< Connected during the second emission
+        int firstCalls = 0;     //!< Calls of the callback that connects and disconnects
+        int lateCalls = 0;      //!< Calls of the callback connected during the second emission
+        int lateEmission = 0;   //!< The emission the late callback was last called in
+        int nestedCalls = 0;    //!< Calls of the callback connected during the fourth emission
+    };
+}
+
+///////////////////////////////////////////////////////////////
+int main() {
+    State state;
+    int emission = 0;
+
+    // The removed slot comes after the connecting callback, so the emission still has to visit it
+    state.signal.connect([&state](int number) {
+        state.firstCalls++;
+        if (number == 1)
+            state.signal.disconnect(state.removed);
+        else if (number == 2) {
+            state.late = state.signal.connect([&state](int lateNumber) {
+                state.lateCalls++;
+                state.lateEmission = lateNumber;
+            });
+        }
+    });
+    state.removed = state.signal.connect([](int) {});
+
+    // The slot freed by the first emission is free when the second one connects
+    state.signal.emit(++emission);
+    CHECK(state.signal.getSize() == 1);
+    state.signal.emit(++emission);
+    CHECK(state.late.isValid());
+    CHECK(state.lateCalls == 0);
+    CHECK(state.signal.getSize() == 2);
+
+    state.signal.emit(++emission);
+    CHECK(state.lateCalls == 1 && state.lateEmission == 3);
+    CHECK(state.firstCalls == 3);
+
+    // A slot freed outside of an emission is not reused during one either
+    CHECK(state.signal.disconnect(state.late));
+    CHECK(!state.signal.disconnect(state.late));
+    state.signal.connect([&state](int number) {
+        if (number == 4)
+            state.signal.connect([&state](int) { state.nestedCalls++; });
+    });
+    CHECK(state.signal.disconnect(state.signal.connect([](int) {})));
+
+    state.signal.emit(++emission);
+    CHECK(state.nestedCalls == 0);
+    state.signal.emit(++emission);
+    CHECK(state.nestedCalls == 1);
+    CHECK(state.lateCalls == 1);
+
+    // Disconnected slots are recycled once no emission is in progress
+    const std::size_t size = state.signal.getSize();
+    state.signal.disconnectAll();
+    CHECK(state.signal.getSize() == 0);
+    for (std::size_t i = 0; i < size; i++)
+        state.signal.connect([](int) {});
+    CHECK(state.signal.getSize() == size);
+
+    return test::report();
+}